@@ -29,7 +29,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/MemorySlots.h>
 #include <vsg/core/Object.h>
 #include <vsg/core/Objects.h>
+#include <vsg/core/RuntimeType.h>
 #include <vsg/core/ScratchMemory.h>
+#include <vsg/core/UserValues.h>
 #include <vsg/core/Value.h>
 #include <vsg/core/Version.h>
 #include <vsg/core/Visitor.h>
@@ -45,6 +47,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/maths/clamp.h>
 #include <vsg/maths/color.h>
 #include <vsg/maths/common.h>
+#include <vsg/maths/intersect.h>
 #include <vsg/maths/mat2.h>
 #include <vsg/maths/mat3.h>
 #include <vsg/maths/mat4.h>
@@ -60,6 +63,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 // Node header files
 #include <vsg/nodes/AbsoluteTransform.h>
+#include <vsg/nodes/BakedSubgraph.h>
 #include <vsg/nodes/Bin.h>
 #include <vsg/nodes/Compilable.h>
 #include <vsg/nodes/CoordinateFrame.h>
@@ -68,6 +72,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/DepthSorted.h>
 #include <vsg/nodes/Geometry.h>
 #include <vsg/nodes/Group.h>
+#include <vsg/nodes/InstanceCulling.h>
 #include <vsg/nodes/InstanceDraw.h>
 #include <vsg/nodes/InstanceDrawIndexed.h>
 #include <vsg/nodes/InstanceNode.h>
@@ -104,6 +109,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/lighting/DirectionalLight.h>
 #include <vsg/lighting/HardShadows.h>
 #include <vsg/lighting/Light.h>
+#include <vsg/lighting/LightClusters.h>
 #include <vsg/lighting/PercentageCloserSoftShadows.h>
 #include <vsg/lighting/PointLight.h>
 #include <vsg/lighting/ShadowSettings.h>
@@ -192,6 +198,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/threading/Latch.h>
 #include <vsg/threading/OperationQueue.h>
 #include <vsg/threading/OperationThreads.h>
+#include <vsg/threading/WorkStealingDeque.h>
 #include <vsg/threading/atomics.h>
 
 // User Interface abstraction header files
@@ -217,9 +224,12 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/CompileManager.h>
 #include <vsg/app/CompileTraversal.h>
 #include <vsg/app/EllipsoidModel.h>
+#include <vsg/app/MultiViewCullTraversal.h>
+#include <vsg/app/PrefetchTraversal.h>
 #include <vsg/app/Presentation.h>
 #include <vsg/app/ProjectionMatrix.h>
 #include <vsg/app/RecordAndSubmitTask.h>
+#include <vsg/app/RecordThreads.h>
 #include <vsg/app/RecordTraversal.h>
 #include <vsg/app/RenderGraph.h>
 #include <vsg/app/SecondaryCommandGraph.h>
@@ -238,6 +248,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/AllocationCallbacks.h>
 #include <vsg/vk/CommandBuffer.h>
 #include <vsg/vk/CommandPool.h>
+#include <vsg/vk/CommandStream.h>
 #include <vsg/vk/Context.h>
 #include <vsg/vk/DescriptorPool.h>
 #include <vsg/vk/DescriptorPools.h>
@@ -273,6 +284,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Input.h>
 #include <vsg/io/JSONParser.h>
 #include <vsg/io/Logger.h>
+#include <vsg/io/MemoryMappedFile.h>
 #include <vsg/io/ObjectFactory.h>
 #include <vsg/io/Options.h>
 #include <vsg/io/Output.h>
@@ -294,11 +306,15 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 // Utility header files
 #include <vsg/utils/Builder.h>
 #include <vsg/utils/CommandLine.h>
+#include <vsg/utils/BakeSubgraph.h>
 #include <vsg/utils/ComputeBounds.h>
+#include <vsg/utils/ComputeMemoryFootprint.h>
 #include <vsg/utils/CoordinateSpace.h>
 #include <vsg/utils/FindDynamicObjects.h>
+#include <vsg/utils/FormatConversion.h>
 #include <vsg/utils/GpuAnnotation.h>
 #include <vsg/utils/GraphicsPipelineConfigurator.h>
+#include <vsg/utils/ImageProcessing.h>
 #include <vsg/utils/Instrumentation.h>
 #include <vsg/utils/Intersector.h>
 #include <vsg/utils/LineSegmentIntersector.h>
@@ -310,6 +326,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/utils/ShaderCompiler.h>
 #include <vsg/utils/ShaderSet.h>
 #include <vsg/utils/SharedObjects.h>
+#include <vsg/utils/TriangleBVH.h>
+#include <vsg/utils/UpdateBounds.h>
 
 // Text header files
 #include <vsg/text/CpuLayoutTechnique.h>
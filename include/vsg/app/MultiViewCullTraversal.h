@@ -0,0 +1,121 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/ConstVisitor.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/core/Mask.h>
+#include <vsg/nodes/Bin.h>
+#include <vsg/vk/State.h>
+
+namespace vsg
+{
+
+    // forward declare
+    class DatabasePager;
+    class FrameStamp;
+
+    /// MultiViewCullTraversal culls a scene graph against the view frustums of several views in a single traversal,
+    /// tracking the views each subgraph is visible in with a bitmask and collecting the visible draw subgraphs of each view into its draw list Bin.
+    /// Recording a view's draw list Bin with the view's RecordTraversal then replaces the traversal of the scene graph for that view.
+    /// Used by ViewDependentState to cull all the shadow map views with one traversal, see ViewDependentState::singlePassShadowCulling.
+    /// LOD selection is shared by all the views and uses the viewpoint assigned by setLODViewpoint(..), matching views set up with INHERIT_VIEWPOINT.
+    class VSG_DECLSPEC MultiViewCullTraversal : public Inherit<ConstVisitor, MultiViewCullTraversal>
+    {
+    public:
+        explicit MultiViewCullTraversal(const Slots& maxSlots = {});
+
+        static constexpr uint32_t maxNumViews = 32;
+
+        Mask traversalMask = MASK_ALL;
+        Mask overrideMask = MASK_OFF;
+
+        ref_ptr<FrameStamp> frameStamp;
+        ref_ptr<DatabasePager> databasePager;
+
+        /// clear the views and reset the traversal ready for a new frame.
+        void reset(const Slots& maxSlots);
+
+        /// set the projection and view matrices used to compute the LOD distances.
+        void setLODViewpoint(const dmat4& projectionMatrix, const dmat4& viewMatrix);
+
+        /// add a view to cull against, the visible subgraphs are added to the bin which is cleared. Return false if maxNumViews has been reached.
+        bool addView(const dmat4& projectionMatrix, const dmat4& viewMatrix, ref_ptr<Bin> bin);
+
+        size_t numViews() const { return _views.size(); }
+
+        void apply(const Node& node) override;
+        void apply(const Group& group) override;
+        void apply(const QuadGroup& quadGroup) override;
+        void apply(const LOD& lod) override;
+        void apply(const PagedLOD& plod) override;
+        void apply(const CullGroup& cullGroup) override;
+        void apply(const CullNode& cullNode) override;
+        void apply(const DepthSorted& depthSorted) override;
+        void apply(const Layer& layer) override;
+        void apply(const Switch& sw) override;
+        void apply(const RegionOfInterest& roi) override;
+        void apply(const Light& light) override;
+        void apply(const Joint& joint) override;
+        void apply(const Transform& transform) override;
+        void apply(const StateGroup& stateGroup) override;
+
+    protected:
+        virtual ~MultiViewCullTraversal();
+
+        struct ViewFrustum
+        {
+            dmat4 viewMatrix;
+            Frustum projected;
+            ref_ptr<Bin> bin;
+        };
+
+        std::vector<ViewFrustum> _views;
+
+        dmat4 _lodProjectionMatrix;
+        dmat4 _lodViewMatrix;
+
+        // state stacks of the StateGroups traversed, used to fill in the Bin entries
+        ref_ptr<State> _state;
+
+        std::vector<dmat4> _modelMatrixStack;
+
+        // the local frustum of each view for each level of the frustum stack, and the LOD scale of each level
+        std::vector<Frustum> _frustumStack;
+        std::vector<Frustum::Vector> _lodScaleStack;
+
+        // views that the current subgraph is potentially visible in
+        uint32_t _viewMask = 0;
+
+        // modelview matrices of each view for the current model matrix, computed on demand
+        std::vector<dmat4> _modelviewMatrices;
+        bool _modelviewMatricesDirty = true;
+
+        void _pushFrustum();
+        void _popFrustum();
+
+        /// return the bitmask of the views in _viewMask that the sphere intersects
+        uint32_t _intersect(const dsphere& sphere) const;
+
+        /// return the LOD distance of a sphere, see State::lodDistanceInFrustum(..)
+        double _lodDistance(const dsphere& sphere) const;
+
+        /// traverse node with _viewMask set to the specified view mask
+        void _traverse(const Node& node, uint32_t viewMask);
+
+        /// add node to the draw lists of the views in viewMask
+        void _addToDrawLists(const Node& node, uint32_t viewMask);
+    };
+    VSG_type_name(vsg::MultiViewCullTraversal);
+
+} // namespace vsg
@@ -0,0 +1,100 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/ConstVisitor.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/core/Mask.h>
+#include <vsg/maths/quat.h>
+#include <vsg/ui/UIEvent.h>
+#include <vsg/vk/State.h>
+
+#include <deque>
+
+namespace vsg
+{
+
+    // forward declare
+    class DatabasePager;
+    class FrameStamp;
+    class View;
+
+    /// PrefetchTraversal extrapolates the camera motion of a View from the view matrices of its recent frames and runs a cull only traversal
+    /// at the predicted viewpoint, requesting the PagedLOD high res subgraphs that will be required there so they are loaded before the camera arrives.
+    /// Predicted requests are given a lower priority than requests for visible PagedLOD, and are cancelled by the DatabasePager once they are no longer predicted.
+    /// Enabled by assigning a PrefetchTraversal to View::prefetchTraversal, the RecordTraversal then calls prefetch(view) after recording the View.
+    class VSG_DECLSPEC PrefetchTraversal : public Inherit<ConstVisitor, PrefetchTraversal>
+    {
+    public:
+        PrefetchTraversal();
+
+        Mask traversalMask = MASK_ALL;
+        Mask overrideMask = MASK_OFF;
+
+        ref_ptr<FrameStamp> frameStamp;
+        ref_ptr<DatabasePager> databasePager;
+
+        /// time in seconds ahead of the current frame to extrapolate the camera motion.
+        double predictionTime = 0.5;
+
+        /// number of frames of view matrix history used to estimate the camera velocity, more frames smooths out jitter at the expense of responsiveness.
+        uint32_t historySize = 4;
+
+        /// clear the view matrix history, call when the camera jumps to a new position.
+        void clear();
+
+        /// add the view matrix of the current frame to the history and compute the view matrix extrapolated predictionTime ahead, return false if the camera isn't moving.
+        bool predict(const dmat4& viewMatrix, dmat4& predictedViewMatrix);
+
+        /// predict the viewpoint of the View's camera and traverse the View's subgraph from it, requesting the PagedLOD required at the predicted viewpoint.
+        void prefetch(const View& view);
+
+        void apply(const Node& node) override;
+        void apply(const LOD& lod) override;
+        void apply(const PagedLOD& plod) override;
+        void apply(const CullGroup& cullGroup) override;
+        void apply(const CullNode& cullNode) override;
+        void apply(const DepthSorted& depthSorted) override;
+        void apply(const Switch& sw) override;
+        void apply(const Transform& transform) override;
+        void apply(const Command& command) override;
+
+    protected:
+        virtual ~PrefetchTraversal();
+
+        struct Sample
+        {
+            time_point time;
+            dvec3 position;
+            dquat rotation;
+            dvec3 scale;
+        };
+
+        std::deque<Sample> _history;
+
+        dmat4 _projectionMatrix;
+        dmat4 _viewMatrix;
+        Frustum _projected;
+
+        std::vector<dmat4> _modelMatrixStack;
+        std::vector<Frustum> _frustumStack;
+
+        void _pushFrustum();
+        void _popFrustum() { _frustumStack.pop_back(); }
+
+        /// return the LOD distance of a sphere, see State::lodDistanceInFrustum(..)
+        double _lodDistance(const dsphere& sphere) const;
+    };
+    VSG_type_name(vsg::PrefetchTraversal);
+
+} // namespace vsg
@@ -0,0 +1,88 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/nodes/Bin.h>
+#include <vsg/threading/OperationThreads.h>
+#include <vsg/vk/CommandBuffer.h>
+
+namespace vsg
+{
+
+    // forward declare
+    class View;
+    class RecordTraversal;
+    class ViewDependentState;
+    class CulledPagedLODs;
+
+    /// RecordThreads provides opt in support for culling and recording a View's subgraph across multiple threads.
+    /// Assign to View::recordThreads to enable. The top level children of the View, expanding plain vsg::Group nodes,
+    /// are split into work items that are culled and recorded by worker threads into their own secondary CommandBuffer,
+    /// each with a State cloned from the RecordTraversal's State. The Bins, lights and PagedLOD lists collected by each
+    /// worker are merged in work item order before the Bins are sorted and recorded, then all the secondary CommandBuffer
+    /// are executed in order. Requires the View to be recorded within a RenderGraph/subpass that uses VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS,
+    /// otherwise the View is recorded serially.
+    class VSG_DECLSPEC RecordThreads : public Inherit<Object, RecordThreads>
+    {
+    public:
+        /// create numThreads worker threads, the thread running the RecordTraversal also records its share of work items.
+        explicit RecordThreads(uint32_t numThreads);
+
+        /// use existing OperationThreads, distributing the work items between numWorkers secondary CommandBuffer.
+        RecordThreads(ref_ptr<OperationThreads> in_operationThreads, uint32_t in_numWorkers);
+
+        RecordThreads(const RecordThreads&) = delete;
+        RecordThreads& operator=(const RecordThreads& rhs) = delete;
+
+        /// threads used to run the record operations, if null all work items are recorded by the calling thread.
+        ref_ptr<OperationThreads> operationThreads;
+
+        /// number of secondary CommandBuffer the work items are distributed between.
+        uint32_t numWorkers = 1;
+
+        /// top level Group nodes are expanded into their children till there are at least numWorkers * workItemsPerWorker work items.
+        uint32_t workItemsPerWorker = 4;
+
+        /// cull and record the View's subgraph in parallel, called by RecordTraversal::apply(const View&) after the View's matrices and Bins have been set up.
+        /// return false if parallel recording isn't possible for the current subpass in which case the View should be recorded serially.
+        virtual bool record(RecordTraversal& rt, const View& view);
+
+        /// record the View's Bins, merged from all the workers, into a secondary CommandBuffer, called by RecordTraversal::apply(const View&) when record() has returned true.
+        virtual void recordBins(RecordTraversal& rt, const View& view);
+
+    protected:
+        virtual ~RecordThreads();
+
+        struct Worker
+        {
+            ref_ptr<RecordTraversal> recordTraversal;
+            ref_ptr<ViewDependentState> viewDependentState;
+            ref_ptr<CulledPagedLODs> culledPagedLODs;
+            CommandBuffers commandBuffers;
+            ref_ptr<CommandBuffer> commandBuffer;
+            size_t begin = 0;
+            size_t end = 0;
+        };
+
+        void _collectWorkItems(const View& view);
+        void _setUpWorker(Worker& worker, RecordTraversal& rt, const View& view);
+        void _recordWorker(Worker& worker);
+        void _mergeWorker(Worker& worker, RecordTraversal& rt);
+
+        std::vector<const Node*> _workItems;
+        std::vector<Worker> _workers;
+        CommandBuffers _binCommandBuffers;
+    };
+    VSG_type_name(vsg::RecordThreads);
+
+} // namespace vsg
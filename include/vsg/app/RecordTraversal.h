@@ -40,6 +40,7 @@ namespace vsg
     class CoordinateFrame;
     class Joint;
     class TileDatabase;
+    class BakedSubgraph;
     class VertexDraw;
     class VertexIndexDraw;
     class Geometry;
@@ -66,6 +67,7 @@ namespace vsg
     class InstanceNode;
     class InstanceDraw;
     class InstanceDrawIndexed;
+    class RecordThreads;
 
     VSG_type_name(vsg::RecordTraversal);
 
@@ -92,6 +94,10 @@ namespace vsg
 
         ref_ptr<Instrumentation> instrumentation;
 
+        /// when enabled, Group and QuadGroup batch the view frustum tests of their CullGroup, CullNode, LOD, PagedLOD and DepthSorted children,
+        /// skipping the traversal of children that are wholly outside the view frustum.
+        bool batchCulling = true;
+
         /// Container for CommandBuffers that have been recorded in current frame
         ref_ptr<RecordedCommandBuffers> recordedCommandBuffers;
 
@@ -124,6 +130,7 @@ namespace vsg
         void apply(const Layer& layer);
         void apply(const Switch& sw);
         void apply(const RegionOfInterest& roi);
+        void apply(const BakedSubgraph& bakedSubgraph);
 
         // leaf node
         void apply(const VertexDraw& vid);
@@ -173,6 +180,8 @@ namespace vsg
     protected:
         virtual ~RecordTraversal();
 
+        friend RecordThreads;
+
         ref_ptr<FrameStamp> _frameStamp;
         ref_ptr<State> _state;
 
@@ -183,6 +192,22 @@ namespace vsg
         int32_t _minimumBinNumber = 0;
         std::vector<ref_ptr<Bin>> _bins;
         ref_ptr<ViewDependentState> _viewDependentState;
+
+        // batched view frustum culling of Group/QuadGroup children
+        void _traverseBatchCulled(const ref_ptr<Node>* children, size_t numChildren);
+
+        // node whose bounding sphere has already passed the batched view frustum test
+        const Node* _batchVisibleNode = nullptr;
+
+        // results of the view frustum tests of the bounds of the BakedSubgraph being recorded, nested BakedSubgraph append theirs
+        std::vector<uint8_t> _bakedVisible;
+
+        inline bool _passedBatchCulling(const Node* node)
+        {
+            if (_batchVisibleNode != node) return false;
+            _batchVisibleNode = nullptr;
+            return true;
+        }
     };
 
 } // namespace vsg
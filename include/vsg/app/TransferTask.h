@@ -60,6 +60,10 @@ namespace vsg
         /// minimum size to use when allocating staging buffers.
         VkDeviceSize minimumStagingBufferSize = 16 * 1024 * 1024;
 
+        /// when Data has been modified via Data::dirty(offset, size) only the modified ranges are copied,
+        /// unless the modified ranges cover more than this ratio of the data in which case the whole data is copied.
+        double partialTransferThreshold = 0.5;
+
         /// hook for assigning Instrumentation to enable profiling of record traversal.
         ref_ptr<Instrumentation> instrumentation;
 
@@ -115,6 +119,13 @@ namespace vsg
 
         void _transferImageInfos(DataToCopy& dataToCopy, VkCommandBuffer vk_commandBuffer, TransferBlock& frame, VkDeviceSize& offset);
         void _transferImageInfo(VkCommandBuffer vk_commandBuffer, TransferBlock& frame, VkDeviceSize& offset, ImageInfo& imageInfo);
+        bool _transferImageInfoRows(VkCommandBuffer vk_commandBuffer, TransferBlock& frame, VkDeviceSize& offset, ImageInfo& imageInfo, const ModifiedCount& previousModifiedCount);
+
+        /// compute the ranges of data to copy, return false if the whole data should be copied.
+        bool _computeModifiedRanges(const Data& data, const ModifiedCount& previousModifiedCount, VkDeviceSize range, VkDeviceSize alignment);
+
+        ModifiedRanges _modifiedRanges;
+        std::vector<VkBufferImageCopy> _imageCopyRegions;
     };
     VSG_type_name(vsg::TransferTask);
 
@@ -21,6 +21,8 @@ namespace vsg
 
     // forward declare
     class ViewDependentState;
+    class RecordThreads;
+    class PrefetchTraversal;
 
     /// ViewFeatures mask provide a means for controlling what features should be implemented by the View's ViewDependentState.
     enum ViewFeatures
@@ -86,6 +88,12 @@ namespace vsg
         /// override states for customization of graphics pipelines for this view
         GraphicsPipelineStates overridePipelineStates;
 
+        /// optional threads used to cull and record the View's subgraph in parallel, requires the View's subpass to use VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS.
+        ref_ptr<RecordThreads> recordThreads;
+
+        /// optional predictive prefetching of PagedLOD subgraphs based on the camera motion, run by the RecordTraversal after the View is recorded.
+        ref_ptr<PrefetchTraversal> prefetchTraversal;
+
     protected:
         virtual ~View();
     };
@@ -25,7 +25,8 @@ namespace vsg
         ALLOCATOR_TYPE_NO_DELETE = 0,
         ALLOCATOR_TYPE_NEW_DELETE,
         ALLOCATOR_TYPE_MALLOC_FREE,
-        ALLOCATOR_TYPE_VSG_ALLOCATOR
+        ALLOCATOR_TYPE_VSG_ALLOCATOR,
+        ALLOCATOR_TYPE_MEMORY_MAPPED /// data is not owned, it references a memory mapped file that is kept alive by the array's storage, any reallocation uses the vsg::Allocator
     };
 
     enum AllocatorAffinity : uint32_t
@@ -22,6 +22,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Input.h>
 #include <vsg/io/Output.h>
 
+#include <type_traits>
+
 #define VSG_array(N, T)                                                  \
     using N = Array<T>;                                                  \
     template<>                                                           \
@@ -144,6 +146,14 @@ namespace vsg
         const std::type_info& type_info() const noexcept override { return typeid(*this); }
         bool is_compatible(const std::type_info& type) const noexcept override { return typeid(Array) == type || Data::is_compatible(type); }
 
+        using runtime_type_class = Array;
+        static const RuntimeType& static_runtime_type() noexcept
+        {
+            static const RuntimeType s_runtimeType(typeid(Array), Data::static_runtime_type());
+            return s_runtimeType;
+        }
+        const RuntimeType& runtime_type() const noexcept override { return static_runtime_type(); }
+
         // implementation provided by Visitor.h
         void accept(Visitor& visitor) override;
         void accept(ConstVisitor& visitor) const override;
@@ -167,6 +177,23 @@ namespace vsg
             {
                 size_t new_total_size = computeValueCountIncludingMipmaps(width_size, 1, 1, properties.maxNumMipmaps);
 
+                if constexpr (std::is_trivially_destructible_v<value_type>)
+                {
+                    input.readAlignmentPadding(alignof(value_type));
+
+                    // when reading from a memory mapped file reference the data directly rather than copying it
+                    ref_ptr<Data> mapped_storage;
+                    size_t mapped_offset = 0;
+                    if (input.readMapped(new_total_size * sizeof(value_type), alignof(value_type), mapped_storage, mapped_offset))
+                    {
+                        auto mapped_properties = properties;
+                        mapped_properties.allocatorType = ALLOCATOR_TYPE_MEMORY_MAPPED;
+                        // assign(..) marks the array as dirty, matching the copying path below
+                        assign(mapped_storage, mapped_offset, sizeof(value_type), width_size, mapped_properties);
+                        return;
+                    }
+                }
+
                 if (_data) // if data exists already may be able to reuse it
                 {
                     if (original_total_size != new_total_size) // if existing data is a different size delete old, and create new
@@ -196,8 +223,10 @@ namespace vsg
             Data::write(output);
 
             output.writeValue<uint32_t>("size", _size);
-            output.writeObject("storage", _storage);
-            if (_storage)
+            // data referenced from a memory mapped file is written out inline
+            bool mapped = properties.allocatorType == ALLOCATOR_TYPE_MEMORY_MAPPED;
+            output.writeObject("storage", mapped ? ref_ptr<Data>() : _storage);
+            if (_storage && !mapped)
             {
                 auto offset = (reinterpret_cast<uintptr_t>(_data) - reinterpret_cast<uintptr_t>(_storage->dataPointer()));
                 output.writeValue<uint32_t>("offset", offset);
@@ -205,6 +234,7 @@ namespace vsg
             }
 
             output.writePropertyName("data");
+            if constexpr (std::is_trivially_destructible_v<value_type>) output.writeAlignmentPadding(alignof(value_type));
             output.write(size(), _data);
             output.writeEndOfLine();
         }
@@ -257,7 +287,7 @@ namespace vsg
             dirty();
         }
 
-        void assign(ref_ptr<Data> storage, uint32_t offset, uint32_t stride, uint32_t numElements, Properties in_properties = {})
+        void assign(ref_ptr<Data> storage, size_t offset, uint32_t stride, uint32_t numElements, Properties in_properties = {})
         {
             _delete();
 
@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/core/Object.h>
+#include <vsg/core/UserValues.h>
 #include <vsg/core/ref_ptr.h>
 
 #include <map>
@@ -39,47 +40,61 @@ namespace vsg
 
         virtual int compare(const Auxiliary& rhs) const;
 
-        void setObject(const std::string& key, ref_ptr<Object> object)
+        void setObject(std::string_view key, ref_ptr<Object> object)
         {
-            userObjects[key] = object;
+            userValues.setObject(key, object);
         }
 
-        Object* getObject(const std::string& key)
+        Object* getObject(std::string_view key)
         {
-            if (auto itr = userObjects.find(key); itr != userObjects.end())
-                return itr->second.get();
+            if (auto entry = userValues.find(key))
+                return entry->object();
             else
                 return nullptr;
         }
 
-        const Object* getObject(const std::string& key) const
+        const Object* getObject(std::string_view key) const
         {
-            if (auto itr = userObjects.find(key); itr != userObjects.end())
-                return itr->second.get();
+            if (auto entry = userValues.find(key))
+                return entry->object();
             else
                 return nullptr;
         }
 
-        ref_ptr<Object> getRefObject(const std::string& key)
+        ref_ptr<Object> getRefObject(std::string_view key)
         {
-            if (auto itr = userObjects.find(key); itr != userObjects.end())
-                return itr->second;
-            else
-                return {};
+            return ref_ptr<Object>(getObject(key));
         }
 
-        ref_ptr<const Object> getRefObject(const std::string& key) const
+        ref_ptr<const Object> getRefObject(std::string_view key) const
         {
-            if (auto itr = userObjects.find(key); itr != userObjects.end())
-                return itr->second;
-            else
-                return {};
+            return ref_ptr<const Object>(getObject(key));
+        }
+
+        void removeObject(std::string_view key)
+        {
+            userValues.remove(key);
         }
 
+        /// container for all user objects and values
+        UserValues userValues;
+
         using ObjectMap = std::map<std::string, vsg::ref_ptr<Object>>;
 
-        /// container for all user objects
-        ObjectMap userObjects;
+        /// deprecated: provided for backwards compatibility, returns a copy of the user objects, creating the Value<T> objects for values stored inline. Use userValues instead.
+        [[deprecated("use userValues")]] ObjectMap userObjects() const
+        {
+            ObjectMap objects;
+            for (auto& entry : userValues) objects[entry.key()] = ref_ptr<Object>(entry.object());
+            return objects;
+        }
+
+        /// deprecated: provided for backwards compatibility, replaces all the user objects with those in objects. Use userValues instead.
+        [[deprecated("use userValues")]] void setUserObjects(const ObjectMap& objects)
+        {
+            userValues.clear();
+            for (auto& [key, object] : objects) userValues.setObject(key, object);
+        }
 
     protected:
         explicit Auxiliary(Object* object);
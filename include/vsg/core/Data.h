@@ -35,6 +35,14 @@ namespace vsg
         void operator++() { ++count; }
     };
 
+    /// ModifiedRange specifies a byte range of a Data's storage that has been modified, used to limit GPU transfers to just the modified parts of the data.
+    struct ModifiedRange
+    {
+        size_t offset = 0;
+        size_t size = 0;
+    };
+    using ModifiedRanges = std::vector<ModifiedRange>;
+
     /** 64 bit block of compressed texel data.*/
     struct block64
     {
@@ -155,6 +163,10 @@ namespace vsg
         size_t sizeofObject() const noexcept override { return sizeof(Data); }
         bool is_compatible(const std::type_info& type) const noexcept override { return typeid(Data) == type || Object::is_compatible(type); }
 
+        using runtime_type_class = Data;
+        static const RuntimeType& static_runtime_type() noexcept;
+        const RuntimeType& runtime_type() const noexcept override { return static_runtime_type(); }
+
         int compare(const Object& rhs_object) const override;
 
         void read(Input& input) override;
@@ -194,7 +206,23 @@ namespace vsg
         static size_t computeValueCountIncludingMipmaps(size_t w, size_t h, size_t d, uint32_t maxNumMipmaps);
 
         /// increment the ModifiedCount to signify the data has been modified
-        void dirty() { ++_modifiedCount; }
+        void dirty()
+        {
+            ++_modifiedCount;
+            _fullyModifiedCount = _modifiedCount;
+            _modifiedRanges.clear();
+        }
+
+        /// increment the ModifiedCount to signify that only the size bytes starting at offset have been modified,
+        /// enabling TransferTask to copy just the modified ranges to the GPU rather than the whole data.
+        void dirty(size_t offset, size_t size);
+
+        /// get the sorted, non overlapping byte ranges modified since the specified ModifiedCount.
+        /// return false if the ranges are not known and all the data should be treated as modified.
+        bool getModifiedRanges(const ModifiedCount& mc, ModifiedRanges& ranges) const;
+
+        /// maximum number of modified ranges retained, when exceeded the oldest range is discarded and earlier ModifiedCounts treated as fully modified.
+        static constexpr size_t maxNumModifiedRanges = 64;
 
         /// get the Data's ModifiedCount and return true if this changes the specified ModifiedCount
         bool getModifiedCount(ModifiedCount& mc) const
@@ -216,6 +244,16 @@ namespace vsg
 
         ModifiedCount _modifiedCount;
 
+        struct ModifiedRangeEntry
+        {
+            ModifiedCount count;
+            size_t begin = 0;
+            size_t end = 0;
+        };
+
+        ModifiedCount _fullyModifiedCount;
+        std::vector<ModifiedRangeEntry> _modifiedRanges;
+
 #if 1
     public:
         /// deprecated: provided for backwards compatibility, use Properties instead.
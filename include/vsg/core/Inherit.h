@@ -49,6 +49,14 @@ namespace vsg
         const std::type_info& type_info() const noexcept override { return typeid(Subclass); }
         bool is_compatible(const std::type_info& type) const noexcept override { return typeid(Subclass) == type || ParentClass::is_compatible(type); }
 
+        using runtime_type_class = Subclass;
+        static const RuntimeType& static_runtime_type() noexcept
+        {
+            static const RuntimeType s_runtimeType(typeid(Subclass), ParentClass::static_runtime_type());
+            return s_runtimeType;
+        }
+        const RuntimeType& runtime_type() const noexcept override { return static_runtime_type(); }
+
         int compare(const Object& rhs) const override
         {
             int result = ParentClass::compare(rhs);
@@ -42,6 +42,11 @@ namespace vsg
     // The maximum size of allocations within the block allocation is (2^15-2) * 4, allocations larger than this
     // are allocated using aligned versions of std::new and std::delete.
     //
+    // To avoid threads contending on the Allocator::mutex each thread has a cache of small allocations, binned by
+    // affinity and size, that is refilled from the MemoryBlocks in batches.  Deallocated slots are added back to the
+    // deallocating thread's cache for reuse, with any that don't fit in the cache returned to the MemoryBlocks in
+    // batches, so memory allocated in one thread can be safely deallocated in another.
+    //
     class VSG_DECLSPEC IntrusiveAllocator : public Allocator
     {
     public:
@@ -56,6 +61,12 @@ namespace vsg
 
         bool deallocate(void* ptr, std::size_t size) override;
 
+        /// return the calling thread's cached allocations and pending deallocations to the MemoryBlocks
+        void flushThreadCache();
+
+        /// enable use of per thread caches for allocate() and deallocate(), when disabled all calls lock the Allocator::mutex
+        bool threadCaching = true;
+
         bool validate() const;
 
         size_t deleteEmptyMemoryBlocks() override;
@@ -195,6 +206,20 @@ namespace vsg
         std::vector<std::unique_ptr<MemoryBlocks>> allocatorMemoryBlocks;
         std::map<void*, std::shared_ptr<MemoryBlock>> memoryBlocks;
         std::map<void*, std::pair<size_t, size_t>> largeAllocations;
+
+        struct ThreadCache;
+        struct ThreadCacheRegistry;
+        std::shared_ptr<ThreadCacheRegistry> threadCacheRegistry;
+
+        ThreadCache* getThreadCache();
+
+        // implementations of allocate()/deallocate() that require the Allocator::mutex to be locked by the caller
+        void* allocateLocked(std::size_t size, AllocatorAffinity allocatorAffinity);
+        bool deallocateLocked(void* ptr, std::size_t size);
+
+        void updateBlockRanges(ThreadCache& threadCache);
+        void* refillThreadCache(ThreadCache& threadCache, std::size_t size, AllocatorAffinity allocatorAffinity);
+        void flushThreadCacheLocked(ThreadCache& threadCache);
     };
 
 } // namespace vsg
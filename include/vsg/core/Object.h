@@ -15,10 +15,12 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <atomic>
 #include <map>
 #include <string>
+#include <string_view>
 #include <typeindex>
 #include <vector>
 
 #include <vsg/core/Export.h>
+#include <vsg/core/RuntimeType.h>
 #include <vsg/core/ref_ptr.h>
 #include <vsg/core/type_name.h>
 
@@ -85,11 +87,16 @@ namespace vsg
         virtual const std::type_info& type_info() const noexcept { return typeid(Object); }
         virtual bool is_compatible(const std::type_info& type) const noexcept { return typeid(Object) == type; }
 
+        /// RuntimeType used for constant time type checks by cast<T>(), subclasses register their own RuntimeType via Inherit<>.
+        using runtime_type_class = Object;
+        static const RuntimeType& static_runtime_type() noexcept;
+        virtual const RuntimeType& runtime_type() const noexcept { return static_runtime_type(); }
+
         template<class T>
-        T* cast() { return is_compatible(typeid(T)) ? static_cast<T*>(this) : nullptr; }
+        T* cast() { return _is_compatible<T>() ? static_cast<T*>(this) : nullptr; }
 
         template<class T>
-        const T* cast() const { return is_compatible(typeid(T)) ? static_cast<const T*>(this) : nullptr; }
+        const T* cast() const { return _is_compatible<T>() ? static_cast<const T*>(this) : nullptr; }
 
         /// clone this object using CopyOp's duplicates map to decide whether to clone or to return the original object.
         /// The default clone(CopyOp&) implementation simply returns ref_ptr<> to this object rather attempt to clone.
@@ -120,50 +127,50 @@ namespace vsg
         inline unsigned int referenceCount() const noexcept { return _referenceCount.load(); }
 
         /// meta data access methods
-        /// wraps the value with a vsg::Value<T> object and then assigns via setObject(key, vsg::Value<T>)
+        /// small plain data values such as scalars and vectors are stored inline in the Auxiliary's UserValues, other values are wrapped with a vsg::Value<T> object and then assigned via setObject(key, vsg::Value<T>)
         template<typename T>
-        void setValue(const std::string& key, const T& value);
+        void setValue(std::string_view key, const T& value);
 
         /// specialization of setValue to handle passing C strings
-        void setValue(const std::string& key, const char* value) { setValue(key, value ? std::string(value) : std::string()); }
+        void setValue(std::string_view key, const char* value) { setValue(key, value ? std::string(value) : std::string()); }
 
         /// get specified value type, return false if value associated with key is not assigned or is not the correct type
         template<typename T>
-        bool getValue(const std::string& key, T& value) const;
+        bool getValue(std::string_view key, T& value) const;
 
         /// assign an Object associated with key
-        void setObject(const std::string& key, ref_ptr<Object> object);
+        void setObject(std::string_view key, ref_ptr<Object> object);
 
         /// get Object pointer associated with key, return nullptr if no object associated with key has been assigned
-        Object* getObject(const std::string& key);
+        Object* getObject(std::string_view key);
 
         /// get const Object pointer associated with key, return nullptr if no object associated with key has been assigned
-        const Object* getObject(const std::string& key) const;
+        const Object* getObject(std::string_view key) const;
 
         /// get object pointer of specified type associated with key, return nullptr if no object associated with key has been assigned
         template<class T>
-        T* getObject(const std::string& key) { return dynamic_cast<T*>(getObject(key)); }
+        T* getObject(std::string_view key) { return dynamic_cast<T*>(getObject(key)); }
 
         /// get const object pointer of specified type associated with key, return nullptr if no object associated with key has been assigned
         template<class T>
-        const T* getObject(const std::string& key) const { return dynamic_cast<const T*>(getObject(key)); }
+        const T* getObject(std::string_view key) const { return dynamic_cast<const T*>(getObject(key)); }
 
         /// get ref_ptr<Object> associated with key, return nullptr if no object associated with key has been assigned
-        ref_ptr<Object> getRefObject(const std::string& key);
+        ref_ptr<Object> getRefObject(std::string_view key);
 
         /// get ref_ptr<const Object> pointer associated with key, return nullptr if no object associated with key has been assigned
-        ref_ptr<const Object> getRefObject(const std::string& key) const;
+        ref_ptr<const Object> getRefObject(std::string_view key) const;
 
         /// get ref_ptr<T> of specified type associated with key, return nullptr if no object associated with key has been assigned
         template<class T>
-        ref_ptr<T> getRefObject(const std::string& key) { return getRefObject(key).cast<T>(); }
+        ref_ptr<T> getRefObject(std::string_view key) { return getRefObject(key).cast<T>(); }
 
         /// get ref_ptr<const T> of specified type associated with key, return nullptr if no object associated with key has been assigned
         template<class T>
-        const ref_ptr<const T> getRefObject(const std::string& key) const { return getRefObject(key).cast<const T>(); }
+        const ref_ptr<const T> getRefObject(std::string_view key) const { return getRefObject(key).cast<const T>(); }
 
         /// remove meta object or value associated with key
-        void removeObject(const std::string& key);
+        void removeObject(std::string_view key);
 
         // Auxiliary object access methods, the optional Auxiliary is used to store meta data
         Auxiliary* getOrCreateAuxiliary();
@@ -176,6 +183,16 @@ namespace vsg
         virtual void _attemptDelete() const;
         void setAuxiliary(Auxiliary* auxiliary);
 
+        /// use the constant time RuntimeType check when T has its own RuntimeType, otherwise fallback to comparing std::type_info up the class hierarchy.
+        template<class T>
+        bool _is_compatible() const noexcept
+        {
+            if constexpr (has_runtime_type<T>())
+                return runtime_type().is_compatible(T::static_runtime_type());
+            else
+                return is_compatible(typeid(T));
+        }
+
     private:
         friend class Auxiliary;
 
@@ -0,0 +1,60 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Export.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace vsg
+{
+
+    /// RuntimeType provides constant time type compatibility checks, used by Object::cast<T>() for Object, Data, Visitor, ConstVisitor,
+    /// Value<>, Array<>, Array2D<>, Array3D<> and all the classes, including user classes, that use Inherit<>.
+    /// Each registered class is assigned a unique id and records the ids of itself and its ancestors indexed by their depth in the class hierarchy,
+    /// so testing whether a class is, or derives from, another is a depth comparison and an array lookup rather than a walk up the class hierarchy.
+    /// Ids are assigned by a central registry keyed on std::type_info so they are consistent across shared library boundaries.
+    class VSG_DECLSPEC RuntimeType
+    {
+    public:
+        /// root of a class hierarchy
+        explicit RuntimeType(const std::type_info& in_type);
+
+        /// class derived from parent
+        RuntimeType(const std::type_info& in_type, const RuntimeType& parent);
+
+        RuntimeType(const RuntimeType&) = delete;
+        RuntimeType& operator=(const RuntimeType&) = delete;
+
+        const std::type_info& type;
+        const uint32_t id;
+        const uint32_t depth;
+
+        /// return true if this type is the same as, or derived from, rhs.
+        bool is_compatible(const RuntimeType& rhs) const noexcept { return rhs.depth <= depth && _ancestors[rhs.depth] == rhs.id; }
+
+        /// ids of the ancestors, indexed by depth, with the last entry being this type's id.
+        const std::vector<uint32_t>& ancestors() const noexcept { return _ancestors; }
+
+    protected:
+        std::vector<uint32_t> _ancestors;
+    };
+
+    /// return true if T has its own RuntimeType, classes that derive from a registered class without using Inherit<> inherit their parent's runtime_type_class.
+    template<class T>
+    constexpr bool has_runtime_type() { return std::is_same_v<typename T::runtime_type_class, std::remove_cv_t<T>>; }
+
+} // namespace vsg
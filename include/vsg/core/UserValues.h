@@ -0,0 +1,146 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2018 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Object.h>
+
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+
+namespace vsg
+{
+
+    /// UserValues is the flat container of the key/value pairs held by Auxiliary and accessed via Object::setValue/getValue/setObject/getObject.
+    /// Entries are kept in a vector sorted by key, with the first numLocalEntries stored within the UserValues itself so that the common case of
+    /// one or two values per object requires no extra allocations. Keys are interned so that objects tagged with the same key share a single std::string.
+    /// Small plain data values, such as ids, flags and vec3, assigned with Object::setValue(..) are stored inline in the entry rather than as a separately allocated vsg::Value<T>,
+    /// with the equivalent vsg::Value<T> only created if the entry is accessed as an Object via getObject(..), serialization writes a temporary Value<T> and reading stores it inline again.
+    class VSG_DECLSPEC UserValues
+    {
+    public:
+        UserValues() = default;
+        UserValues(const UserValues& rhs);
+        UserValues& operator=(const UserValues& rhs);
+        ~UserValues();
+
+        static constexpr size_t maxInlineSize = 16;
+        static constexpr size_t numLocalEntries = 2;
+
+        /// values of type T are stored inline when they are plain data, i.e. trivially destructible and trivially copy assignable like the vsg::maths types, and fit within maxInlineSize bytes
+        template<typename T>
+        static constexpr bool inline_storage_v = std::is_trivially_destructible_v<T> && std::is_trivially_copy_assignable_v<T> && sizeof(T) <= maxInlineSize && alignof(T) <= alignof(uint64_t);
+
+        /// type of a value stored inline, the type of the equivalent Value<T> object and the function used to create it.
+        struct InlineType
+        {
+            const std::type_info& type;
+            const std::type_info& objectType;
+            ref_ptr<Object> (*createObject)(const void* value);
+        };
+
+        /// register an InlineType so that Value<T> objects of its objectType, such as those read from files, are stored inline.
+        /// Returns the InlineType registered for the objectType, so all modules share the same InlineType for each type.
+        static const InlineType* registerInlineType(const InlineType& inlineType);
+
+        /// return the InlineType registered for Value<T> objects of the specified type, nullptr if none is registered.
+        /// The Value<T> types declared in vsg/core/Value.h are registered on first use, other types are registered by Object::setValue<T>(..).
+        static const InlineType* findInlineType(const std::type_info& objectType);
+
+        class VSG_DECLSPEC Entry
+        {
+        public:
+            Entry() = default;
+            Entry(const Entry&) = delete;
+            Entry& operator=(const Entry&) = delete;
+
+            const std::string& key() const { return *_key; }
+
+            /// return the Object associated with the key, values stored inline have their Value<T> created on first access, which is then used in place of the inline value.
+            Object* object() const;
+
+            /// return the Object associated with the key without creating one for values stored inline.
+            Object* storedObject() const { return _object.load(std::memory_order_acquire); }
+
+            /// return the InlineType of a value stored inline, nullptr if the entry holds an Object.
+            const InlineType* inlineType() const { return _inlineType; }
+            const void* inlineValue() const { return _value; }
+
+            /// copy the inline value if it is of type T and hasn't been superseded by an Object, return true on success.
+            template<typename T>
+            bool getInlineValue(T& value) const
+            {
+                if (!_inlineType || storedObject() || _inlineType->type != typeid(T)) return false;
+                std::memcpy(&value, _value, sizeof(T));
+                return true;
+            }
+
+        protected:
+            friend class UserValues;
+
+            const std::string* _key = nullptr;
+            const InlineType* _inlineType = nullptr;
+            mutable std::atomic<Object*> _object{nullptr};
+            alignas(uint64_t) unsigned char _value[maxInlineSize];
+        };
+
+        /// return the interned copy of key, all keys with the same string share the same std::string.
+        /// Interned keys are never freed, so keys should come from a bounded set of names, per object data such as ids belongs in the value rather than the key.
+        static const std::string* intern(std::string_view key);
+
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+
+        Entry* begin() { return _entries; }
+        Entry* end() { return _entries + _size; }
+        const Entry* begin() const { return _entries; }
+        const Entry* end() const { return _entries + _size; }
+
+        /// return the entry associated with key, nullptr if none has been assigned
+        Entry* find(std::string_view key);
+        const Entry* find(std::string_view key) const;
+
+        /// assign an Object to key, replacing any previous object or value
+        void setObject(std::string_view key, ref_ptr<Object> object);
+
+        /// assign an inline value of inlineType to key, replacing any previous object or value
+        void setInlineValue(std::string_view key, const void* value, size_t size, const InlineType* inlineType);
+
+        /// assign an Object to key, storing its value inline when it's a Value<T> of a registered InlineType without user values or non default properties of its own.
+        /// Used when reading so that values loaded from files get the same inline storage as values assigned with Object::setValue(..).
+        void setObjectOrInlineValue(std::string_view key, ref_ptr<Object> object);
+
+        /// remove the entry associated with key, return true if an entry was removed
+        bool remove(std::string_view key);
+
+        void clear();
+
+    protected:
+        Entry* _entries = _localEntries;
+        uint32_t _size = 0;
+        uint32_t _capacity = numLocalEntries;
+        Entry _localEntries[numLocalEntries];
+
+        /// return the entry associated with key, inserting an empty entry in key order if none exists
+        Entry& _findOrInsert(std::string_view key);
+
+        /// release the object or inline value held by entry
+        static void _reset(Entry& entry);
+
+        /// move the contents of source to the empty entry dest, leaving source empty
+        static void _move(Entry& dest, Entry& source);
+    };
+
+} // namespace vsg
@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/core/Auxiliary.h>
 #include <vsg/core/Data.h>
 #include <vsg/core/type_name.h>
 
@@ -77,6 +78,14 @@ namespace vsg
         const std::type_info& type_info() const noexcept override { return typeid(*this); }
         bool is_compatible(const std::type_info& type) const noexcept override { return typeid(Value) == type || Data::is_compatible(type); }
 
+        using runtime_type_class = Value;
+        static const RuntimeType& static_runtime_type() noexcept
+        {
+            static const RuntimeType s_runtimeType(typeid(Value), Data::static_runtime_type());
+            return s_runtimeType;
+        }
+        const RuntimeType& runtime_type() const noexcept override { return static_runtime_type(); }
+
         // implementation provided by Visitor.h
         void accept(Visitor& visitor) override;
         void accept(ConstVisitor& visitor) const override;
@@ -165,21 +174,45 @@ namespace vsg
         value_type _value;
     };
 
+    /// return the InlineType used to store values of type T inline in UserValues, registering it on first use.
     template<typename T>
-    void Object::setValue(const std::string& key, const T& value)
+    const UserValues::InlineType* userValueInlineType()
     {
         using ValueT = Value<T>;
-        setObject(key, ValueT::create(value));
+        static const UserValues::InlineType* s_inlineType = UserValues::registerInlineType({typeid(T), typeid(ValueT), [](const void* ptr) -> ref_ptr<Object> { return ValueT::create(*static_cast<const T*>(ptr)); }});
+        return s_inlineType;
     }
 
     template<typename T>
-    bool Object::getValue(const std::string& key, T& value) const
+    void Object::setValue(std::string_view key, const T& value)
     {
         using ValueT = Value<T>;
-        const Object* object = getObject(key);
+        if constexpr (UserValues::inline_storage_v<T>)
+        {
+            getOrCreateAuxiliary()->userValues.setInlineValue(key, &value, sizeof(T), userValueInlineType<T>());
+        }
+        else
+        {
+            setObject(key, ValueT::create(value));
+        }
+    }
+
+    template<typename T>
+    bool Object::getValue(std::string_view key, T& value) const
+    {
+        using ValueT = Value<T>;
+        auto entry = _auxiliary ? _auxiliary->userValues.find(key) : nullptr;
+        if (!entry) return false;
+
+        if constexpr (UserValues::inline_storage_v<T>)
+        {
+            if (entry->getInlineValue(value)) return true;
+        }
+
+        const Object* object = entry->storedObject();
         if (object && (typeid(*object) == typeid(ValueT)))
         {
-            const ValueT* vo = static_cast<const ValueT*>(getObject(key));
+            const ValueT* vo = static_cast<const ValueT*>(object);
             value = *vo;
             return true;
         }
@@ -193,7 +226,7 @@ namespace vsg
     /// usage:   auto flag = vsg::value<bool>(false, "flag", object1);
     /// usage:   auto angle = vsg::value<float>(0.0f, "angle", object1, object2);
     template<typename T, typename... Args>
-    T value(T defaultValue, const std::string& match, Args&&... args)
+    T value(T defaultValue, std::string_view match, Args&&... args)
     {
         T v{defaultValue};
         ((args && args->getValue(match, v)) || ...);
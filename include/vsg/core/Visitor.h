@@ -479,6 +479,10 @@ namespace vsg
         virtual void apply(FrameStamp&);
 
         bool is_compatible(const std::type_info& type) const noexcept override { return typeid(Visitor) == type || Object::is_compatible(type); }
+
+        using runtime_type_class = Visitor;
+        static const RuntimeType& static_runtime_type() noexcept;
+        const RuntimeType& runtime_type() const noexcept override { return static_runtime_type(); }
     };
 
     // provide Value<>::accept() implementation
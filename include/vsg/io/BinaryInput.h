@@ -15,6 +15,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Object.h>
 
 #include <vsg/io/Input.h>
+#include <vsg/io/MemoryMappedFile.h>
 #include <vsg/io/Options.h>
 
 #include <fstream>
@@ -75,8 +76,25 @@ namespace vsg
         /// read object
         vsg::ref_ptr<vsg::Object> read() override;
 
+        /// reference the data directly from the mappedFile when it is suitably aligned
+        bool readMapped(size_t size, size_t alignment, ref_ptr<Data>& storage, size_t& offset) override;
+
+        /// skip the padding written by BinaryOutput::writeAlignmentPadding()
+        void readAlignmentPadding(size_t alignment) override;
+
+        /// memory mapped file that the input stream is reading from, when set arrays can reference their data directly from the mapped file
+        ref_ptr<MemoryMappedFile> mappedFile;
+
     protected:
         std::istream& _input;
+
+        /// class name table built up as new class names are encountered in files written from VSG 1.1.12 onwards
+        struct ClassEntry
+        {
+            std::string className;
+            ObjectFactory::CreateFunction createFunction;
+        };
+        std::vector<ClassEntry> _classes;
     };
 
 } // namespace vsg
@@ -16,6 +16,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Output.h>
 
 #include <fstream>
+#include <unordered_map>
 
 namespace vsg
 {
@@ -62,8 +63,14 @@ namespace vsg
         /// write object
         void write(const vsg::Object* object) override;
 
+        /// for alignments greater than 1 write a uint8_t padding count followed by the padding required to align the next value relative to the start of the stream
+        void writeAlignmentPadding(size_t alignment) override;
+
     protected:
         std::ostream& _output;
+
+        /// index of each class name written so far, used from VSG 1.1.12 onwards so that each class name is written just once
+        std::unordered_map<std::string, uint32_t> _classIndices;
     };
 
 } // namespace vsg
@@ -20,10 +20,12 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/PagedLOD.h>
 #include <vsg/threading/DeleteQueue.h>
 #include <vsg/utils/Instrumentation.h>
+#include <vsg/vk/MemoryBufferPools.h>
 
 #include <condition_variable>
 #include <list>
 #include <thread>
+#include <unordered_map>
 
 namespace vsg
 {
@@ -63,16 +65,44 @@ namespace vsg
 
         void add(ref_ptr<PagedLOD> plod, const CompileResult& cr);
 
+        /// reposition a queued PagedLOD after its priority has been raised, no-op if the PagedLOD isn't in the queue.
+        void update(const PagedLOD* plod);
+
+        /// remove a queued PagedLOD, return true if the PagedLOD was in the queue.
+        bool remove(const PagedLOD* plod);
+
+        /// take the highest priority PagedLOD, waiting until one is available or the ActivityStatus is no longer active.
         ref_ptr<PagedLOD> take_when_available();
 
         Nodes take_all(CompileResult& result);
 
+        size_t size() const;
+
     protected:
         virtual ~DatabaseQueue();
 
-        std::mutex _mutex;
+        struct Entry
+        {
+            double priority;
+            ref_ptr<PagedLOD> plod;
+        };
+
+        bool _wait(std::unique_lock<std::mutex>& lock);
+        void _push(ref_ptr<PagedLOD> plod);
+        ref_ptr<PagedLOD> _pop();
+        void _erase(size_t index);
+        void _siftUp(size_t index);
+        void _siftDown(size_t index);
+        void _swap(size_t lhs, size_t rhs);
+
+        mutable std::mutex _mutex;
         std::condition_variable _cv;
-        Nodes _queue;
+
+        // binary max heap ordered on the PagedLOD::priority at the time the entry was added or last updated,
+        // with the position of each PagedLOD in the heap tracked so priorities can be updated in O(log n).
+        std::vector<Entry> _heap;
+        std::unordered_map<const PagedLOD*, size_t> _heapIndices;
+
         CompileResult _compileResult;
         ref_ptr<ActivityStatus> _status;
     };
@@ -92,6 +122,17 @@ namespace vsg
 
         virtual void request(ref_ptr<PagedLOD> plod);
 
+        /// request a PagedLOD that is predicted to be required, called by PrefetchTraversal. Predicted requests are cancelled once they are no longer predicted or visible.
+        virtual void requestPredicted(ref_ptr<PagedLOD> plod);
+
+        /// notify the pager that the priority of an already requested PagedLOD has been raised so it can be repositioned in the request queue.
+        virtual void updatePriority(const PagedLOD* plod);
+
+        /// request the high res subgraph of a PagedLOD found to be required by a traversal, raising its priority to at least the specified value.
+        /// The first call since the PagedLOD was last merged or discarded passes it to request(..), or requestPredicted(..) when predicted is true,
+        /// subsequent calls reposition it in the request queue when its priority has been raised.
+        void requestHighRes(const PagedLOD& plod, double priority, bool predicted = false);
+
         virtual void updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResult& cr);
 
         ref_ptr<CompileManager> compileManager;
@@ -104,6 +145,37 @@ namespace vsg
         /// for systems with smaller GPU memory limits you may need to reduce the targetMaxNumPagedLODWithHighResSubgraphs to keep memory usage within available limits.
         uint32_t targetMaxNumPagedLODWithHighResSubgraphs = 1500;
 
+        /// budgets for the estimated CPU and GPU memory used by the loaded high res subgraphs, 0 disables the budget.
+        /// When the memory used exceeds a budget the least recently used inactive high res subgraphs are expired until it's back within budget.
+        uint64_t targetMaxCpuMemory = 0;
+        uint64_t targetMaxGpuMemory = 0;
+
+        /// ratio of the memory budgets at which requests are throttled, once exceeded new requests are only accepted while fewer than throttledMaxNumActiveRequests are active.
+        double throttleRatio = 0.9;
+        uint32_t throttledMaxNumActiveRequests = 2;
+
+        /// optional MemoryBufferPools, typically device->deviceMemoryBufferPools, used to report the device memory reserved in statistics.
+        observer_ptr<MemoryBufferPools> deviceMemoryBufferPools;
+
+        /// live statistics, safe to read from other threads for monitoring.
+        struct Statistics
+        {
+            std::atomic_uint64_t cpuMemory{0}; // estimated CPU memory of the merged high res subgraphs
+            std::atomic_uint64_t gpuMemory{0}; // estimated GPU memory of the merged high res subgraphs
+            std::atomic_uint64_t deviceMemoryReserved{0}; // device memory reserved from deviceMemoryBufferPools
+            std::atomic_uint32_t numHighResSubgraphs{0}; // number of merged high res subgraphs
+            std::atomic_uint64_t numMerged{0}; // total number of high res subgraphs merged
+            std::atomic_uint64_t numExpired{0}; // total number of high res subgraphs expired
+            std::atomic_uint64_t numThrottled{0}; // total number of requests rejected while throttled
+            std::atomic_uint64_t numPredicted{0}; // total number of predicted requests
+            std::atomic_uint64_t numPredictedCancelled{0}; // total number of predicted requests cancelled before being read
+        };
+
+        Statistics statistics;
+
+        /// return true if the memory used is above throttleRatio of either budget.
+        bool throttled() const;
+
         std::mutex pendingPagedLODMutex;
 
         ref_ptr<PagedLODContainer> pagedLODContainer;
@@ -122,6 +194,15 @@ namespace vsg
 
         void requestDiscarded(PagedLOD* plod);
 
+        /// return true if the memory used, including the pending memory, exceeds either budget.
+        bool _exceedsMemoryBudget(uint64_t pendingCpuMemory, uint64_t pendingGpuMemory) const;
+
+        /// remove the predicted requests from the request queue that are no longer predicted or visible.
+        void _cancelStalePredictedRequests();
+
+        std::mutex _predictedRequestsMutex;
+        std::vector<ref_ptr<PagedLOD>> _predictedRequests;
+
         ref_ptr<ActivityStatus> _status;
 
         ref_ptr<DatabaseQueue> _requestQueue;
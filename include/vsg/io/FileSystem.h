@@ -57,6 +57,13 @@ namespace vsg
     /// make a directory, return true if path already exists or full path has been created successfully, return false on failure.
     extern VSG_DECLSPEC bool makeDirectory(const Path& path);
 
+    /// rename a file, replacing any existing file at the destination, return true on success.
+    /// The replacement is atomic when the source and destination are on the same file system, so concurrent readers see either the old or new file, never a partially written one.
+    extern VSG_DECLSPEC bool renameFile(const Path& from, const Path& to);
+
+    /// remove a file, return true on success.
+    extern VSG_DECLSPEC bool removeFile(const Path& path);
+
     /// get the contents of a directory, return {} if directory name is not a directory
     extern VSG_DECLSPEC Paths getDirectoryContents(const Path& directoryName);
 
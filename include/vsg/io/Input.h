@@ -29,8 +29,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/FileSystem.h>
 #include <vsg/io/ObjectFactory.h>
 
+#include <algorithm>
+#include <map>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 namespace vsg
 {
@@ -70,6 +73,14 @@ namespace vsg
         // read object
         virtual ref_ptr<Object> read() = 0;
 
+        /// if the input is reading from a memory mapped file, set storage and offset to reference the next size bytes and advance past them so arrays can use the data directly rather than copying it.
+        /// The offset is 64 bit so data beyond the first 4GB of the file can be referenced.
+        /// Returns false when memory mapping isn't supported or the data isn't suitably aligned, in which case the data should be read with the read(num, value) methods.
+        virtual bool readMapped(size_t /*size*/, size_t /*alignment*/, ref_ptr<Data>& /*storage*/, size_t& /*offset*/) { return false; }
+
+        /// skip the padding written by Output::writeAlignmentPadding(alignment)
+        virtual void readAlignmentPadding(size_t /*alignment*/) {}
+
         // map char to int8_t
         void read(size_t num, char* value) { read(num, reinterpret_cast<int8_t*>(value)); }
         void read(size_t num, bool* value) { read(num, reinterpret_cast<int8_t*>(value)); }
@@ -241,7 +252,46 @@ namespace vsg
         }
 
         using ObjectID = uint32_t;
-        using ObjectIDMap = std::map<ObjectID, ref_ptr<Object>>;
+
+        /// Mapping from ObjectID to the objects read so far. vsg::Output assigns ObjectIDs sequentially, so lookups index straight into a vector.
+        /// The ObjectIDs are read from the file so the vector is only grown to ids within twice the number of entries already held, or minimumDenseSize,
+        /// ids beyond that are held in a sparse map so that malformed or malicious files can't force huge allocations.
+        struct ObjectIDMap
+        {
+            static constexpr size_t minimumDenseSize = 4096;
+
+            std::vector<ref_ptr<Object>> objects;
+            std::vector<bool> assigned;
+            std::map<ObjectID, ref_ptr<Object>> sparseObjects;
+
+            /// return a pointer to the object assigned to id, or nullptr if no object has yet been assigned to it
+            const ref_ptr<Object>* find(ObjectID id) const
+            {
+                if (id < assigned.size() && assigned[id]) return &objects[id];
+                if (auto itr = sparseObjects.find(id); itr != sparseObjects.end()) return &(itr->second);
+                return nullptr;
+            }
+
+            /// return the entry for id so that it can be assigned
+            ref_ptr<Object>& operator[](ObjectID id)
+            {
+                // ids assigned before the vector grew past them remain in the sparse map
+                if (!sparseObjects.empty())
+                {
+                    if (auto itr = sparseObjects.find(id); itr != sparseObjects.end()) return itr->second;
+                }
+
+                if (id >= objects.size())
+                {
+                    if (static_cast<size_t>(id) >= std::max(minimumDenseSize, objects.size() * 2)) return sparseObjects[id];
+
+                    objects.resize(static_cast<size_t>(id) + 1);
+                    assigned.resize(static_cast<size_t>(id) + 1, false);
+                }
+                assigned[id] = true;
+                return objects[id];
+            }
+        };
 
         ObjectIDMap objectIDMap;
         ref_ptr<ObjectFactory> objectFactory;
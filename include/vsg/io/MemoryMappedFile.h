@@ -0,0 +1,73 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Data.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/io/Path.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace vsg
+{
+
+    /// MemoryMappedFile maps a file into memory with copy-on-write access, providing a vsg::Data that can be used as
+    /// the storage of arrays so that they can reference the file contents directly rather than copying them.
+    /// Modifications of the mapped data are private to the process and never written back to the file.
+    class VSG_DECLSPEC MemoryMappedFile : public Inherit<Data, MemoryMappedFile>
+    {
+    public:
+        explicit MemoryMappedFile(const Path& filename);
+
+        /// return true if the file was successfully mapped
+        bool valid() const { return _data != nullptr; }
+
+        uint8_t* data() { return _data; }
+        const uint8_t* data() const { return _data; }
+        size_t size() const { return _size; }
+
+        size_t valueSize() const override { return 1; }
+        size_t valueCount() const override { return _size; }
+
+        bool dataAvailable() const override { return _data != nullptr; }
+        size_t dataSize() const override { return _size; }
+
+        void* dataPointer() override { return _data; }
+        const void* dataPointer() const override { return _data; }
+
+        void* dataPointer(size_t index) override { return _data + index; }
+        const void* dataPointer(size_t index) const override { return _data + index; }
+
+        void* dataRelease() override { return nullptr; }
+
+        uint32_t dimensions() const override { return 1; }
+
+        uint32_t width() const override { return static_cast<uint32_t>(std::min(_size, size_t(std::numeric_limits<uint32_t>::max()))); }
+        uint32_t height() const override { return 1; }
+        uint32_t depth() const override { return 1; }
+
+    protected:
+        virtual ~MemoryMappedFile();
+
+        uint8_t* _data = nullptr;
+        size_t _size = 0;
+
+#if defined(WIN32) && !defined(__CYGWIN__)
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#endif
+    };
+    VSG_type_name(vsg::MemoryMappedFile);
+
+} // namespace vsg
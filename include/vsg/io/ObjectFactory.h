@@ -36,6 +36,10 @@ namespace vsg
         CreateMap& getCreateMap() { return _createMap; }
         const CreateMap& getCreateMap() const { return _createMap; }
 
+        /// return the CreateFunction for the specified className, or an empty function if none is registered.
+        /// Used by BinaryInput to look up each class once and then create subsequent instances without repeating the lookup.
+        virtual CreateFunction getCreateFunction(const std::string& className) const;
+
         template<class T>
         void add()
         {
@@ -71,6 +71,9 @@ namespace vsg
         /// write object
         virtual void write(const Object* object) = 0;
 
+        /// pad the output so that the next value written is aligned to the specified alignment, used to allow array data to be read in bulk or memory mapped
+        virtual void writeAlignmentPadding(size_t /*alignment*/) {}
+
         /// map char to int8_t
         void write(size_t num, const char* value) { write(num, reinterpret_cast<const int8_t*>(value)); }
         void write(size_t num, const bool* value) { write(num, reinterpret_cast<const int8_t*>(value)); }
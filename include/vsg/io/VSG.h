@@ -19,12 +19,23 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 namespace vsg
 {
 
+    // forward declare
+    class MemoryMappedFile;
+
     /// ReaderWriter for reading and writing native VSG ascii and binary files.
     class VSG_DECLSPEC VSG : public Inherit<ReaderWriter, VSG>
     {
     public:
         VSG();
 
+        /// bool option, when true .vsgb files are memory mapped and suitably aligned array data is referenced directly from the mapped file rather than copied, default is false.
+        /// Mapped pages are copy-on-write so modifying the arrays doesn't affect the file, but the file must not be truncated or replaced while the loaded data is in use.
+        static constexpr const char* memory_map = "memory_map";
+
+        /// bool option, when true binary files with a vsg::Group root are written as independently decodable chunks, one per child, with an offset index,
+        /// so that they can be decoded in parallel when read with Options::operationThreads assigned, default is false.
+        static constexpr const char* chunked = "chunked";
+
         vsg::ref_ptr<vsg::Object> read(const vsg::Path& filename, vsg::ref_ptr<const vsg::Options> options = {}) const override;
         vsg::ref_ptr<vsg::Object> read(std::istream& fin, vsg::ref_ptr<const vsg::Options> options = {}) const override;
         vsg::ref_ptr<vsg::Object> read(const uint8_t* ptr, size_t size, vsg::ref_ptr<const vsg::Options> = {}) const override;
@@ -41,6 +52,7 @@ namespace vsg
         {
             BINARY,
             ASCII,
+            BINARY_CHUNKED,
             NOT_RECOGNIZED
         };
 
@@ -50,6 +62,13 @@ namespace vsg
         void writeHeader(std::ostream& fout, const FormatInfo& formatInfo) const;
 
     protected:
+        /// write object as a BINARY_CHUNKED file, returns false if object isn't suitable for chunking or fout doesn't support tellp()/seekp()
+        bool writeChunks(const vsg::Object* object, std::ostream& fout, const VsgVersion& version, vsg::ref_ptr<const vsg::Options> options) const;
+
+        /// read the chunk index and chunks of a BINARY_CHUNKED file, decoding the chunks in parallel when options->operationThreads is assigned.
+        /// If mappedFile is assigned chunks are decoded directly from it, otherwise if filename is set chunks are read from the file, else the rest of fin is read into memory.
+        vsg::ref_ptr<vsg::Object> readChunks(std::istream& fin, const VsgVersion& version, ref_ptr<MemoryMappedFile> mappedFile, const vsg::Path& filename, vsg::ref_ptr<const vsg::Options> options) const;
+
         ref_ptr<ObjectFactory> _objectFactory;
     };
     VSG_type_name(vsg::VSG);
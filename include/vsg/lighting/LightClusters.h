@@ -0,0 +1,110 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/maths/box.h>
+#include <vsg/maths/mat4.h>
+#include <vsg/maths/sphere.h>
+#include <vsg/threading/OperationThreads.h>
+
+namespace vsg
+{
+
+    /// LightClusters assigns the point and spot lights of a view to a grid of clusters that subdivide the view frustum,
+    /// tiled in x and y across the viewport and exponentially sliced in depth between nearDistance and farDistance.
+    /// The assignment is packed into the clusterData array that ViewDependentState binds to the "lightClusters" descriptor
+    /// of ShaderSets that have clustered lighting enabled, allowing the fragment shader to only iterate over the lights that affect its cluster.
+    ///
+    /// clusterData layout, all values are uint, float values are stored as their bit patterns (read with uintBitsToFloat) :
+    ///   [0..3] dimensions.x, dimensions.y, dimensions.z, number of light indices
+    ///   [4..7] nearDistance, farDistance, sliceScale, sliceBias : slice = clamp(int(log(-eye.z) * sliceScale + sliceBias), 0, dimensions.z - 1)
+    ///   [8 .. 8 + 2 * numClusters) offset and count of each cluster's light indices, cluster = (slice * dimensions.y + tile.y) * dimensions.x + tile.x
+    ///   [8 + 2 * numClusters ..) light indices, the vec4 offset of the light's entry in ViewDependentState::lightData, with bit 31 set for spot lights.
+    /// The tile is computed from the fragment's position in the viewport, tile = uvec2((gl_FragCoord.xy - viewport.xy) / viewport.zw * dimensions.xy).
+    /// The phong ShaderSet declares the "lightClusters" binding, vsg::enableLightClusters(..) adds the VSG_LIGHT_CLUSTERS define that enables its clustered lighting path.
+    /// Spot light shadow settings hold the index of the light's first shadow map in their alpha component, so shaders can locate the shadow maps without stepping through all the lights.
+    class VSG_DECLSPEC LightClusters : public Inherit<Object, LightClusters>
+    {
+    public:
+        explicit LightClusters(const uivec3& in_dimensions = {16, 9, 24}, uint32_t in_maxLightIndices = 32768);
+
+        static constexpr uint32_t headerSize = 8;
+        static constexpr uint32_t spotLightBit = 0x80000000;
+
+        const uivec3 dimensions;
+        const uint32_t maxLightIndices;
+
+        /// lights with an intensity, scaled by their brightest color component, below this value are treated as not contributing, used to compute the range of point and spot lights.
+        double intensityCutoff = 0.01;
+
+        /// maximum ratio of farDistance to nearDistance, used to clamp the depth range of projections with an infinite far plane.
+        double maxFarNearRatio = 1e4;
+
+        /// optional threads to spread the assignment of lights to the clusters across, each depth slice is assigned as a separate task.
+        ref_ptr<OperationThreads> operationThreads;
+
+        /// packed cluster assignment to upload to the GPU.
+        ref_ptr<uintArray> clusterData;
+
+        /// compute the range beyond which a light of the specified color and intensity is treated as not contributing.
+        double lightRange(const vec3& color, float intensity) const;
+
+        /// clear the lights, call prior to adding the lights for a new frame.
+        void clear();
+
+        /// add light, with eye coordinate bounding sphere, the index is the value written into the light indices.
+        void add(const dsphere& bound, uint32_t index) { _lights.push_back(Light{bound, index}); }
+
+        /// set up the cluster bounds for the specified projection matrix and depth range, only recomputed when the settings change.
+        void setProjection(const dmat4& projectionMatrix, double nearDistance, double farDistance);
+
+        /// assign the lights added since clear() to the clusters they intersect and pack the result into clusterData, return true if clusterData changed.
+        bool assign();
+
+        uint32_t numClusters() const { return dimensions.x * dimensions.y * dimensions.z; }
+
+        /// eye coordinate bounds of a cluster, the last depth slice extends to infinity so lights beyond farDistance are still assigned.
+        const dbox& clusterBound(uint32_t cluster) const { return _clusterBounds[cluster]; }
+
+        /// return true if the eye coordinate bounding sphere intersects the cluster bounds, used by assign() to test candidate clusters.
+        bool intersects(const dsphere& bound, uint32_t cluster) const;
+
+    protected:
+        virtual ~LightClusters();
+
+        struct Light
+        {
+            dsphere bound;
+            uint32_t index;
+        };
+
+        std::vector<Light> _lights;
+
+        dmat4 _projectionMatrix;
+        double _nearDistance = 0.0;
+        double _farDistance = 0.0;
+
+        // depth of each slice boundary, the eye coordinate bounds of each cluster, and the union of the bounds of each column and row of each slice
+        std::vector<double> _sliceDepths;
+        std::vector<dbox> _clusterBounds;
+        std::vector<dvec2> _columnRanges;
+        std::vector<dvec2> _rowRanges;
+
+        std::vector<std::vector<uint32_t>> _clusterLights;
+
+        void _assignSlice(uint32_t slice);
+    };
+    VSG_type_name(vsg::LightClusters);
+
+} // namespace vsg
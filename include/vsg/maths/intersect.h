@@ -0,0 +1,26 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Export.h>
+#include <vsg/maths/plane.h>
+
+namespace vsg
+{
+
+    /** batched sphere/polytope intersection test, tests numSpheres bounding spheres against the convex polytope defined by numPlanes planes with normals pointing inwards.
+      * results[i] is set to 1 if spheres[i] wholly or partially intersects with the polytope and 0 if it lies wholly outside, matching intersect(first, last, sphere).
+      * Spheres are processed in blocks using SSE2/AVX/NEON when the target supports them, with the remainder tested with the scalar implementation. */
+    extern VSG_DECLSPEC void intersect(const dplane* planes, size_t numPlanes, const dsphere* spheres, size_t numSpheres, uint8_t* results);
+
+} // namespace vsg
@@ -0,0 +1,101 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2018 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/Command.h>
+#include <vsg/maths/mat4.h>
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/Node.h>
+#include <vsg/state/StateCommand.h>
+
+namespace vsg
+{
+
+    /// BakedSubgraph is a flattened representation of a static subgraph of Group, QuadGroup, CullGroup, CullNode, MatrixTransform, StateGroup and Command nodes,
+    /// with the hierarchy encoded as a pre-order list of instructions that index into contiguous arrays of bounds, matrices, state commands, commands and nodes.
+    /// The RecordTraversal culls all the bounds in a single batch and then records the instructions in a single loop, avoiding the per node dispatch and pointer chasing
+    /// of traversing the original subgraph. Nodes that can't be flattened, such as LOD, PagedLOD, Switch, Light and DepthSorted, are kept in the nodes array and traversed as normal.
+    /// Use BakeSubgraph to create a BakedSubgraph from a subgraph.
+    class VSG_DECLSPEC BakedSubgraph : public Inherit<Node, BakedSubgraph>
+    {
+    public:
+        BakedSubgraph();
+        BakedSubgraph(const BakedSubgraph& rhs, const CopyOp& copyop = {});
+
+        enum Opcode : uint32_t
+        {
+            CULL,                    // skip the following count instructions if bounds[first] is outside the view frustum
+            PUSH_MATRIX,             // push the modelview matrix of matrices[first], relative to the BakedSubgraph's modelview matrix
+            PUSH_MATRIX_AND_FRUSTUM, // push the modelview matrix of matrices[first] and the local view frustum required by the nodes of the subgraph
+            POP_MATRIX,              // pop the modelview matrix
+            POP_MATRIX_AND_FRUSTUM,  // pop the modelview matrix and the local view frustum
+            PUSH_STATE,              // push stateCommands[first, first + count)
+            POP_STATE,               // pop stateCommands[first, first + count)
+            DRAW,                    // record commands[first, first + count)
+            NODE                     // traverse nodes[first]
+        };
+
+        struct Instruction
+        {
+            Opcode opcode = DRAW;
+            uint32_t first = 0;
+            uint32_t count = 0;
+        };
+
+        std::vector<Instruction> instructions;
+
+        /// bounds of the culled subgraphs, in the coordinate frame of the BakedSubgraph
+        std::vector<dsphere> bounds;
+
+        /// accumulated matrices of the transforms, relative to the coordinate frame of the BakedSubgraph
+        std::vector<dmat4> matrices;
+
+        std::vector<ref_ptr<StateCommand>> stateCommands;
+        std::vector<ref_ptr<Command>> commands;
+        std::vector<ref_ptr<Node>> nodes;
+
+        /// original subgraph, used by traversals other than the RecordTraversal, such as compilation, intersection and computing bounds,
+        /// as the commands and nodes can only be placed correctly by applying the matrices of the instructions.
+        ref_ptr<Node> subgraph;
+
+        /// return true if the instructions index within the arrays and their matrix, state and cull ranges are correctly nested.
+        bool validate() const;
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return BakedSubgraph::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        template<class N, class V>
+        static void t_traverse(N& node, V& visitor)
+        {
+            if (node.subgraph) node.subgraph->accept(visitor);
+        }
+
+        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
+        void traverse(RecordTraversal& visitor) const override
+        {
+            // RecordTraversal::apply(const BakedSubgraph&) records the instructions, traverse(..) records the original subgraph
+            if (subgraph) subgraph->accept(visitor);
+        }
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~BakedSubgraph();
+    };
+    VSG_type_name(vsg::BakedSubgraph);
+
+} // namespace vsg
@@ -41,6 +41,12 @@ namespace vsg
 
         void add(State* state, double value, const Node* node);
 
+        /// add node with the specified modelview matrix in place of the State's current modelview matrix, used when collecting draw lists for a View other than the one being traversed.
+        void add(State* state, const dmat4& modelview, double value, const Node* node);
+
+        /// append the contents of another Bin, used to merge Bins filled by separate threads prior to the Bin being sorted and recorded.
+        void add(const Bin& bin);
+
     public:
         ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return Bin::create(*this, copyop); }
         int compare(const Object& rhs) const override;
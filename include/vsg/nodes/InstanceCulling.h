@@ -0,0 +1,108 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/Node.h>
+#include <vsg/threading/OperationThreads.h>
+
+#include <atomic>
+#include <limits>
+
+namespace vsg
+{
+
+    // forward declare
+    class InstanceNode;
+    class ResourceRequirements;
+    class State;
+
+    /// InstanceCulling provides optional per instance view frustum culling and distance based LOD selection for an InstanceNode.
+    /// During the RecordTraversal the bounding sphere of each instance is tested against the view frustum, and the colors, translations,
+    /// rotations and scales of the visible instances are compacted into per LOD level arrays. These arrays are transferred to the GPU
+    /// after the record traversal and are bound in place of the InstanceNode's arrays, with the draws issued with the reduced instance count.
+    ///
+    /// InstanceCulling must be assigned to the InstanceNode before it's compiled. As the compacted arrays can only hold the visible instances of
+    /// one view per frame, culling is done for a single View, the one assigned to viewID. Other views, such as the shadow map views, draw all the instances.
+    class VSG_DECLSPEC InstanceCulling : public Inherit<Object, InstanceCulling>
+    {
+    public:
+        InstanceCulling();
+        InstanceCulling(const InstanceCulling& rhs, const CopyOp& copyop = {});
+
+        /// bounding sphere of the InstanceNode's child subgraphs, in the coordinate frame of an instance prior to its scale, rotation and translation.
+        /// If not set, init(..) computes it from the InstanceNode::child and lodChildren, while it's invalid no culling is done.
+        dsphere bound;
+
+        static constexpr uint32_t unassignedViewID = std::numeric_limits<uint32_t>::max();
+
+        /// viewID of the View that the instances are culled for. When unassigned, the first View without the INHERIT_VIEWPOINT feature to record the InstanceNode is assigned.
+        std::atomic<uint32_t> viewID{unassignedViewID};
+
+        struct LODChild
+        {
+            double minimumScreenHeightRatio = 0.0; // 0.0 is always visible
+            ref_ptr<Node> node;
+        };
+
+        using LODChildren = std::vector<LODChild>;
+
+        /// optional per instance LOD children, ordered from the highest to lowest resolution child like LOD::children.
+        /// Each visible instance is drawn by the first LODChild whose minimumScreenHeightRatio its bounding sphere passes.
+        /// When empty all visible instances are drawn by the InstanceNode::child.
+        LODChildren lodChildren;
+
+        void addLODChild(const LODChild& lodChild) { lodChildren.push_back(lodChild); }
+
+        /// optional threads to spread the culling of large numbers of instances across, in blocks of grainSize instances.
+        ref_ptr<OperationThreads> operationThreads;
+        uint32_t grainSize = 16384;
+
+        /// per LOD level InstanceNodes that hold the compacted arrays of the visible instances, set up by init(..) and updated by cull(..)
+        std::vector<ref_ptr<InstanceNode>> culledInstanceNodes;
+
+        /// set up the culledInstanceNodes for the specified InstanceNode and add their arrays to the dynamic data of the ResourceRequirements.
+        virtual void init(const InstanceNode& instanceNode, ResourceRequirements& requirements);
+
+        /// return true if the instances should be culled for the specified view, assigning viewID if it's still unassigned.
+        virtual bool cullView(uint32_t in_viewID, bool inheritViewpoint);
+
+        /// cull the instances of the InstanceNode against the current view frustum, updating the culledInstanceNodes' arrays and instanceCount.
+        virtual void cull(const InstanceNode& instanceNode, const State& state);
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return InstanceCulling::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        template<class N, class V>
+        static void t_traverse(N& node, V& visitor)
+        {
+            for (auto& child : node.lodChildren) child.node->accept(visitor);
+        }
+
+        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~InstanceCulling();
+
+        uint32_t _capacity = 0;
+        std::vector<dsphere> _spheres;
+        std::vector<uint8_t> _levels;
+    };
+    VSG_type_name(vsg::InstanceCulling);
+
+} // namespace vsg
@@ -15,6 +15,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Array.h>
 #include <vsg/maths/sphere.h>
 #include <vsg/nodes/Compilable.h>
+#include <vsg/nodes/InstanceCulling.h>
 #include <vsg/state/BufferInfo.h>
 
 namespace vsg
@@ -62,12 +63,22 @@ namespace vsg
 
         ref_ptr<vsg::Node> child;
 
+        /// optional per instance view frustum culling and LOD selection, see vsg::InstanceCulling
+        ref_ptr<InstanceCulling> culling;
+
     public:
         ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return InstanceNode::create(*this, copyop); }
         int compare(const Object& rhs) const override;
 
-        void traverse(Visitor& visitor) override { child->accept(visitor); }
-        void traverse(ConstVisitor& visitor) const override { child->accept(visitor); }
+        template<class N, class V>
+        static void t_traverse(N& node, V& visitor)
+        {
+            if (node.child) node.child->accept(visitor);
+            if (node.culling) node.culling->traverse(visitor);
+        }
+
+        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
         void traverse(RecordTraversal& visitor) const override { child->accept(visitor); }
 
         void read(Input& input) override;
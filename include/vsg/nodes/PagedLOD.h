@@ -87,6 +87,10 @@ namespace vsg
         mutable std::atomic<double> priority{0.0};
 
         mutable std::atomic_uint64_t frameHighResLastUsed{0};
+
+        /// frame that the high res child was last found to be required at a predicted viewpoint, see PrefetchTraversal.
+        mutable std::atomic_uint64_t frameHighResPredicted{0};
+
         mutable std::atomic_uint requestCount{0};
 
         enum RequestStatus : unsigned int
@@ -105,6 +109,10 @@ namespace vsg
         mutable uint32_t index = 0;
 
         ref_ptr<Node> pending;
+
+        /// estimated CPU and GPU memory used by the pending/high res subgraph, computed by the DatabasePager when it loads the subgraph.
+        uint64_t cpuMemory = 0;
+        uint64_t gpuMemory = 0;
     };
     VSG_type_name(vsg::PagedLOD);
 
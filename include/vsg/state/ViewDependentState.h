@@ -16,6 +16,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/RenderGraph.h>
 #include <vsg/io/Logger.h>
 #include <vsg/lighting/Light.h>
+#include <vsg/lighting/LightClusters.h>
+#include <vsg/nodes/Bin.h>
 #include <vsg/nodes/Switch.h>
 #include <vsg/state/BindDescriptorSet.h>
 #include <vsg/state/DescriptorBuffer.h>
@@ -94,6 +96,7 @@ namespace vsg
 
     // forward declare
     class ResourceRequirements;
+    class MultiViewCullTraversal;
 
     /// ViewDependentState to manage lighting, clip planes and texture projection
     /// By default assigned to the vsg::View, for standard usage you don't need to create or modify the ViewDependentState
@@ -143,6 +146,11 @@ namespace vsg
         ref_ptr<vec4Array> viewportData;
         ref_ptr<BufferInfo> viewportDataBufferInfo;
 
+        // assignment of point and spot lights to view frustum clusters, set up by init() when clustered lighting has been enabled on the ShaderSet with vsg::enableLightClusters(..).
+        // Assign a LightClusters before init() to customize the cluster dimensions or to bin the lights using OperationThreads.
+        ref_ptr<LightClusters> lightClusters;
+        ref_ptr<BufferInfo> lightClustersBufferInfo;
+
         ref_ptr<Image> shadowDepthImage;
 
         ref_ptr<DescriptorSetLayout> descriptorSetLayout;
@@ -164,13 +172,20 @@ namespace vsg
         ref_ptr<CommandGraph> preRenderCommandGraph;
         ref_ptr<Switch> preRenderSwitch;
 
+        /// cull the scene graph for all the active shadow maps in a single traversal, recording the resulting per shadow map draw lists
+        /// rather than traversing the scene graph separately for each shadow map.
+        bool singlePassShadowCulling = false;
+
         struct ShadowMap
         {
             ref_ptr<RenderGraph> renderGraph;
             ref_ptr<View> view;
+            ref_ptr<Switch> sceneSwitch; // selects between traversing the scene graph and recording the drawList
+            ref_ptr<Bin> drawList;
         };
 
         mutable std::vector<ShadowMap> shadowMaps;
+        mutable ref_ptr<MultiViewCullTraversal> multiViewCullTraversal;
 
     protected:
         ~ViewDependentState();
@@ -13,8 +13,12 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/threading/OperationQueue.h>
+#include <vsg/threading/WorkStealingDeque.h>
 
+#include <functional>
+#include <memory>
 #include <thread>
+#include <vector>
 
 namespace vsg
 {
@@ -22,28 +26,56 @@ namespace vsg
     /// OperationThreads provides a collection of std::threads that share a single OperationQueue.
     /// Each thread polls the queue for vsg::Operation to process, when one is available it's removed
     /// from the queue and its Operation::run() method is called.
+    ///
+    /// With the WORK_STEALING scheduling mode each thread also has its own lock-free deque. Operations added from
+    /// one of the OperationThreads' threads are pushed onto its deque and run by it in last in, first out order,
+    /// threads that run out of work take from the shared queue and then steal from the other threads' deques.
+    /// This avoids contention on the shared queue's mutex when operations are fine-grained or spawn further operations.
     class VSG_DECLSPEC OperationThreads : public Inherit<Object, OperationThreads>
     {
     public:
-        explicit OperationThreads(uint32_t numThreads, ref_ptr<ActivityStatus> in_status = {});
+        enum SchedulingMode
+        {
+            SHARED_QUEUE,
+            WORK_STEALING
+        };
+
+        explicit OperationThreads(uint32_t numThreads, ref_ptr<ActivityStatus> in_status = {}, SchedulingMode in_schedulingMode = SHARED_QUEUE);
         OperationThreads(const OperationThreads&) = delete;
         OperationThreads& operator=(const OperationThreads& rhs) = delete;
 
+        /// add operation to be run. INSERT_FRONT operations are always placed at the front of the shared queue so that
+        /// they are taken before other queued operations, in WORK_STEALING mode a thread completes its own deque first.
         void add(ref_ptr<Operation> operation, InsertionPosition insertionPosition = INSERT_BACK)
         {
-            queue->add(operation, insertionPosition);
+            if (schedulingMode == WORK_STEALING)
+                _add(operation, insertionPosition);
+            else
+                queue->add(operation, insertionPosition);
         }
 
         template<typename Iterator>
         void add(Iterator begin, Iterator end, InsertionPosition insertionPosition = INSERT_BACK)
         {
-            queue->add(begin, end, insertionPosition);
+            if (schedulingMode == WORK_STEALING)
+            {
+                for (auto itr = begin; itr != end; ++itr) _add(*itr, insertionPosition);
+            }
+            else
+            {
+                queue->add(begin, end, insertionPosition);
+            }
         }
 
         /// use this thread to run operations till the queue is empty as well
         /// this thread will consume and run operations in parallel with any threads associated with this OperationThreads.
         void run();
 
+        /// call function(begin, end) for sub ranges of [first, last) of at most grainSize elements, in parallel across the threads and this thread,
+        /// returning once all the sub ranges have been processed. If grainSize is 0 the range is split evenly across the threads.
+        /// May be called from within an operation running on one of this OperationThreads' threads.
+        void parallel_for(size_t first, size_t last, const std::function<void(size_t begin, size_t end)>& function, size_t grainSize = 0);
+
         /// stop threads
         void stop();
 
@@ -51,9 +83,21 @@ namespace vsg
         Threads threads;
         ref_ptr<OperationQueue> queue;
         ref_ptr<ActivityStatus> status;
+        const SchedulingMode schedulingMode;
 
     protected:
         virtual ~OperationThreads();
+
+        using Deque = WorkStealingDeque<Operation>;
+
+        void _add(ref_ptr<Operation> operation, InsertionPosition insertionPosition);
+        ref_ptr<Operation> _take(Deque* deque, size_t index);
+        void _notify();
+
+        std::vector<std::unique_ptr<Deque>> _deques;
+        std::mutex _idleMutex;
+        std::condition_variable _idleCV;
+        std::atomic_uint32_t _numIdle{0};
     };
     VSG_type_name(vsg::OperationThreads)
 
@@ -0,0 +1,124 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/ref_ptr.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace vsg
+{
+
+    /// Fixed capacity, lock-free work stealing deque based on the Chase-Lev algorithm.
+    /// The owning thread pushes and pops at the bottom of the deque, while other threads steal from the top.
+    /// Objects are held by raw pointer with a reference taken on push() and passed back to the caller on pop()/steal().
+    template<class T, int64_t Capacity = 1024>
+    class WorkStealingDeque
+    {
+    public:
+        static_assert((Capacity & (Capacity - 1)) == 0, "WorkStealingDeque Capacity must be a power of two.");
+
+        WorkStealingDeque() = default;
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        ~WorkStealingDeque()
+        {
+            while (pop()) {}
+        }
+
+        /// push object onto the bottom of the deque, only to be called by the owning thread. Returns false if the deque is full.
+        bool push(ref_ptr<T> object)
+        {
+            if (!object) return true;
+
+            int64_t b = _bottom.load(std::memory_order_relaxed);
+            int64_t t = _top.load(std::memory_order_acquire);
+            if ((b - t) >= Capacity) return false;
+
+            // take a reference that is passed on by pop()/steal()
+            object->ref();
+            _buffer[b & mask].store(object.get(), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /// pop the most recently pushed object from the bottom of the deque, only to be called by the owning thread.
+        ref_ptr<T> pop()
+        {
+            int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+            _bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = _top.load(std::memory_order_relaxed);
+
+            if (t > b)
+            {
+                // deque was empty
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return {};
+            }
+
+            T* object = _buffer[b & mask].load(std::memory_order_relaxed);
+            if (t == b)
+            {
+                // last entry, so race against any stealing threads for it
+                if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) object = nullptr;
+                _bottom.store(b + 1, std::memory_order_relaxed);
+            }
+
+            return adopt(object);
+        }
+
+        /// steal the least recently pushed object from the top of the deque, may be called from any thread.
+        /// Returns null if the deque is empty or another thread won the race for the entry.
+        ref_ptr<T> steal()
+        {
+            int64_t t = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = _bottom.load(std::memory_order_acquire);
+
+            if (t >= b) return {};
+
+            T* object = _buffer[t & mask].load(std::memory_order_relaxed);
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return {};
+
+            return adopt(object);
+        }
+
+        /// return true if the deque appears empty, result may be stale by the time it's used.
+        bool empty() const
+        {
+            return _bottom.load(std::memory_order_acquire) <= _top.load(std::memory_order_acquire);
+        }
+
+    protected:
+        static constexpr int64_t mask = Capacity - 1;
+
+        /// take ownership of the reference taken in push()
+        static ref_ptr<T> adopt(T* object)
+        {
+            ref_ptr<T> result(object);
+            if (object) object->unref_nodelete();
+            return result;
+        }
+
+        // keep the ends of the deque on separate cache lines as top is written by stealing threads and bottom by the owner
+        alignas(64) std::atomic<int64_t> _top{0};
+        alignas(64) std::atomic<int64_t> _bottom{0};
+        alignas(64) std::atomic<T*> _buffer[Capacity];
+    };
+
+} // namespace vsg
@@ -25,12 +25,16 @@ namespace vsg
         while (t < original_value && !reference.compare_exchange_weak(original_value, t)) {}
     };
 
-    /// Convenience template function that sets the value of an atomic if the passed in value is greater than the value of the atomic.
+    /// Convenience template function that sets the value of an atomic if the passed in value is greater than the value of the atomic, returns true if the value was changed.
     template<typename T>
-    void exchange_if_greater(std::atomic<T>& reference, T t)
+    bool exchange_if_greater(std::atomic<T>& reference, T t)
     {
         T original_value = reference.load();
-        while (t > original_value && !reference.compare_exchange_weak(original_value, t)) {}
+        while (t > original_value)
+        {
+            if (reference.compare_exchange_weak(original_value, t)) return true;
+        }
+        return false;
     };
 
     /// Convenience template function that multiplies the value of an atomic by specified value
@@ -0,0 +1,75 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2018 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Visitor.h>
+#include <vsg/nodes/BakedSubgraph.h>
+
+#include <set>
+
+namespace vsg
+{
+
+    /// BakeSubgraph flattens a static subgraph into a BakedSubgraph.
+    /// Group, QuadGroup, CullGroup, CullNode, MatrixTransform, StateGroup, Commands and Command nodes are baked into the instructions and arrays of the BakedSubgraph,
+    /// all other nodes, including subclasses of the baked node types, are kept as nodes that the RecordTraversal traverses as normal.
+    /// The matrices of MatrixTransform are copied, so changes made to the original MatrixTransform after baking are not reflected in the BakedSubgraph,
+    /// nodes that are to remain dynamic should be added to dynamicObjects, for instance with the results of FindDynamicObjects, so they are kept as nodes.
+    class VSG_DECLSPEC BakeSubgraph : public Inherit<Visitor, BakeSubgraph>
+    {
+    public:
+        BakeSubgraph();
+
+        /// nodes that are not to be baked
+        std::set<const Object*> dynamicObjects;
+
+        /// bake subgraph
+        ref_ptr<BakedSubgraph> bake(ref_ptr<Node> subgraph);
+
+        void apply(Node& node) override;
+        void apply(Group& group) override;
+        void apply(QuadGroup& quadGroup) override;
+        void apply(CullGroup& cullGroup) override;
+        void apply(CullNode& cullNode) override;
+        void apply(Transform& transform) override;
+        void apply(MatrixTransform& transform) override;
+        void apply(StateGroup& stateGroup) override;
+        void apply(Commands& commands) override;
+        void apply(Command& command) override;
+
+    protected:
+        ref_ptr<BakedSubgraph> _baked;
+
+        std::vector<dmat4> _matrixStack;
+
+        // instructions before this index are within the range of a CULL, so a following DRAW mustn't be merged with them
+        size_t _drawMergeBarrier = 0;
+
+        // set when a node is added that requires the local view frustum of the transform above it
+        bool _nodeAdded = false;
+
+        template<class T>
+        bool _bakeable(const T& node) const
+        {
+            return typeid(node) == typeid(T) && dynamicObjects.count(&node) == 0;
+        }
+
+        void _addNode(Node& node);
+        void _addCommand(Command& command);
+        size_t _pushCull(const dsphere& bound);
+        void _popCull(size_t position);
+    };
+    VSG_type_name(vsg::BakeSubgraph);
+
+} // namespace vsg
@@ -0,0 +1,63 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/ConstVisitor.h>
+#include <vsg/core/Inherit.h>
+
+#include <set>
+
+namespace vsg
+{
+
+    /// Estimate the CPU and GPU memory used by a subgraph.
+    /// CPU memory is the sizeofObject() of each object plus the Data::dataSize() of each Data, GPU memory is the Data::dataSize() of the Data
+    /// referenced by BufferInfo and Image, which is what gets transferred to the GPU. Objects are only counted once per traversal,
+    /// objects shared with other subgraphs are counted by each subgraph so the totals are an upper bound.
+    /// Used by the DatabasePager to track the memory footprint of loaded PagedLOD subgraphs.
+    class VSG_DECLSPEC ComputeMemoryFootprint : public Inherit<ConstVisitor, ComputeMemoryFootprint>
+    {
+    public:
+        uint64_t cpuMemory = 0;
+        uint64_t gpuMemory = 0;
+
+        /// reset the totals and visited objects ready for a new traversal
+        void reset();
+
+        void apply(const Object& object) override;
+        void apply(const Data& data) override;
+        void apply(const BufferInfo& info) override;
+        void apply(const Image& image) override;
+        void apply(const ImageView& imageView) override;
+        void apply(const ImageInfo& info) override;
+        void apply(const DescriptorBuffer& db) override;
+        void apply(const DescriptorImage& di) override;
+        void apply(const BindIndexBuffer& bib) override;
+        void apply(const BindVertexBuffers& bvb) override;
+        void apply(const VertexDraw& vd) override;
+        void apply(const VertexIndexDraw& vid) override;
+        void apply(const Geometry& geom) override;
+
+    protected:
+        std::set<const Object*> _visited;
+        std::set<const Data*> _gpuData;
+
+        /// return true if object hasn't been visited before, adding its sizeofObject() to the cpuMemory
+        bool _visit(const Object& object);
+
+        /// add Data that will be transferred to the GPU
+        void _addGpuData(const Data* data);
+    };
+    VSG_type_name(vsg::ComputeMemoryFootprint);
+
+} // namespace vsg
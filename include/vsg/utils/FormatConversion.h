@@ -0,0 +1,57 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Export.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vsg
+{
+
+    /// copy count pixels of sourceSize bytes to pixels of targetSize bytes, filling any bytes beyond sourceSize from defaultValue, or dropping the trailing bytes when targetSize is smaller.
+    /// Used by TransferTask and CopyAndReleaseImage to convert image data directly into mapped staging memory, common cases like RGB8 to RGBA8 use vectorized code paths.
+    extern VSG_DECLSPEC void convertPixels(const void* source, uint32_t sourceSize, void* dest, uint32_t targetSize, const uint8_t* defaultValue, size_t count);
+
+    /// convert count RGB8 pixels to RGBA8 pixels with the specified alpha.
+    extern VSG_DECLSPEC void convertRGB8ToRGBA8(const uint8_t* source, uint8_t* dest, size_t count, uint8_t alpha = 255);
+
+    /// convert count RGBA8 pixels to RGB8 pixels, discarding the alpha.
+    extern VSG_DECLSPEC void convertRGBA8ToRGB8(const uint8_t* source, uint8_t* dest, size_t count);
+
+    /// convert count 8 bit normalized components to 16 bit normalized components.
+    extern VSG_DECLSPEC void convertUNorm8ToUNorm16(const uint8_t* source, uint16_t* dest, size_t count);
+
+    /// convert count 16 bit normalized components to 8 bit normalized components, rounding to nearest.
+    extern VSG_DECLSPEC void convertUNorm16ToUNorm8(const uint16_t* source, uint8_t* dest, size_t count);
+
+    /// convert a float to the bit pattern of a half float, rounding to nearest even.
+    extern VSG_DECLSPEC uint16_t floatToHalf(float value);
+
+    /// convert the bit pattern of a half float to a float.
+    extern VSG_DECLSPEC float halfToFloat(uint16_t value);
+
+    /// convert count floats to half floats, rounding to nearest even.
+    extern VSG_DECLSPEC void convertFloatToHalf(const float* source, uint16_t* dest, size_t count);
+
+    /// convert count half floats to floats.
+    extern VSG_DECLSPEC void convertHalfToFloat(const uint16_t* source, float* dest, size_t count);
+
+    /// convert count pixels of numComponents sRGB encoded 8 bit components to linear floats, the 4th component is treated as linear alpha.
+    extern VSG_DECLSPEC void convertSRGB8ToLinearFloat(const uint8_t* source, float* dest, size_t count, uint32_t numComponents);
+
+    /// convert count pixels of numComponents linear floats to sRGB encoded 8 bit components, the 4th component is treated as linear alpha.
+    extern VSG_DECLSPEC void convertLinearFloatToSRGB8(const float* source, uint8_t* dest, size_t count, uint32_t numComponents);
+
+} // namespace vsg
@@ -0,0 +1,51 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Data.h>
+#include <vsg/threading/OperationThreads.h>
+
+namespace vsg
+{
+
+    /// filter used to downsample each mipmap level from the level above it.
+    enum MipmapFilter : uint8_t
+    {
+        MIPMAP_FILTER_BOX,   /// average of the texels covered by each destination texel, fast and free of ringing.
+        MIPMAP_FILTER_KAISER /// Kaiser windowed sinc, sharper than the box filter at the cost of a wider footprint and slight ringing.
+    };
+
+    /// block compression formats supported by compressImage(..).
+    enum BlockCompression : uint8_t
+    {
+        BLOCK_COMPRESSION_BC1, /// RGB, 4 bits per texel, alpha is discarded.
+        BLOCK_COMPRESSION_BC3, /// RGBA, 8 bits per texel, interpolated alpha.
+        BLOCK_COMPRESSION_BC4, /// R, 4 bits per texel, suited to single channel masks and height maps.
+        BLOCK_COMPRESSION_BC5, /// RG, 8 bits per texel, suited to tangent space normal maps.
+        BLOCK_COMPRESSION_BC7  /// RGBA, 8 bits per texel, higher quality than BC1/BC3.
+    };
+
+    /// create a copy of a 2D image with the mipmap chain computed on the CPU, stored in the layout described by Data::computeMipmapOffsets().
+    /// maxNumMipmaps of 0 creates the full mipmap chain down to 1x1. Filtering is done on linear values, so sRGB formats are decoded before and encoded after filtering.
+    /// Supports 8 bit UNORM/SRGB formats with 1 to 4 components, including B8G8R8A8, and 32 bit SFLOAT formats with 1 to 4 components.
+    /// Rows are filtered in parallel when operationThreads is assigned. Returns a null ref_ptr<> if the image is not supported.
+    extern VSG_DECLSPEC ref_ptr<Data> createMipmaps(const Data* data, uint32_t maxNumMipmaps = 0, MipmapFilter filter = MIPMAP_FILTER_BOX, OperationThreads* operationThreads = nullptr);
+
+    /// compress a 2D image, and any mipmaps it has, to a block64Array2D (BC1, BC4) or block128Array2D (BC3, BC5, BC7) with the corresponding VK_FORMAT_BC*_BLOCK format.
+    /// SRGB source formats map to the SRGB block formats where available. As block compressed images can't have their mipmaps generated with GPU blits, call createMipmaps(..) first when mipmapping is required.
+    /// Mipmap levels are compressed down to a single block, and only while the level's dimensions in blocks match those of the Data::computeMipmapOffsets() layout, which holds for power of two images.
+    /// Blocks are compressed in parallel when operationThreads is assigned. Returns a null ref_ptr<> if the image is not supported.
+    extern VSG_DECLSPEC ref_ptr<Data> compressImage(const Data* data, BlockCompression compression, OperationThreads* operationThreads = nullptr);
+
+} // namespace vsg
@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/nodes/Node.h>
 #include <vsg/state/ArrayState.h>
+#include <vsg/utils/TriangleBVH.h>
 
 namespace vsg
 {
@@ -74,6 +75,18 @@ namespace vsg
         /// intersect with a vkCmdDrawIndexed primitive
         virtual bool intersectDrawIndexed(uint32_t firstIndex, uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount) = 0;
 
+        /// when a triangleBVHCache is assigned, use a TriangleBVH to accelerate intersections with triangle list draws that have at least minimumTriangleBVHSize triangles.
+        /// The TriangleBVH is built on first use, cached in the triangleBVHCache and rebuilt when the vertex or index arrays are modified.
+        bool useTriangleBVH = true;
+        uint32_t minimumTriangleBVHSize = 256;
+
+        /// optional cache of the TriangleBVH built for each draw, by default null so intersections test all triangles.
+        /// Assign a long lived TriangleBVHCache, shared between the Intersectors created for each pick, so the TriangleBVH are reused.
+        ref_ptr<TriangleBVHCache> triangleBVHCache;
+
+        /// get the TriangleBVH for the current draw node, building and caching it when required, return null if a TriangleBVH shouldn't be used.
+        ref_ptr<const TriangleBVH> getTriangleBVH(ref_ptr<const vec3Array> vertices, ref_ptr<const Data> indices, uint32_t first, uint32_t count);
+
         /// get the current local to world matrix stack
         std::vector<dmat4>& localToWorldStack() { return arrayStateStack.back()->localToWorldStack; }
 
@@ -88,6 +101,9 @@ namespace vsg
         ref_ptr<const uintArray> uint_indices;
 
         NodePath _nodePath;
+
+        /// indices into TriangleBVH::triangles of the triangles to test, reused between draws to avoid reallocation
+        std::vector<uint32_t> _triangleCandidates;
     };
     VSG_type_name(vsg::Intersector);
 
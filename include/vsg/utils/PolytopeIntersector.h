@@ -66,6 +66,9 @@ namespace vsg
         bool intersectDrawIndexed(uint32_t firstIndex, uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount) override;
 
     protected:
+        /// intersect the triangles of a triangle list draw using a TriangleBVH, return false if a TriangleBVH isn't applicable
+        bool intersectTriangleBVH(ArrayState& arrayState, ref_ptr<const Data> indices, uint32_t first, uint32_t count, uint32_t firstInstance, uint32_t instanceCount);
+
         std::vector<Polytope> _polytopeStack;
     };
     VSG_type_name(vsg::PolytopeIntersector);
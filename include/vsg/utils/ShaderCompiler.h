@@ -5,13 +5,20 @@
 #include <vsg/io/Options.h>
 #include <vsg/state/ShaderStage.h>
 
+#include <set>
+
 namespace vsg
 {
 
+    // forward declare
+    class ShaderSet;
+
     /// ShaderCompiler integrates with GLSLang to provide shader compilation from GLSL shaders to SPIRV shaders usable by Vulkan.
     /// To be able to compile GLSL the VulkanSceneGraph has to be compiled against GLSLang, you can check whether shader compilation
     /// is supported via the VSG_SUPPORTS_ShaderCompiler #define provided in include/core/Version.h, if the value is 1 then shader compilation
     /// is supported. You can also check the ShaderCompiler::supported() method.
+    /// Compiled SPIRV can be cached on disk so that subsequent runs of an application, or other applications, can reuse it rather than recompiling the GLSL,
+    /// see ShaderCompiler::cacheDirectory.
     class VSG_DECLSPEC ShaderCompiler : public Inherit<Visitor, ShaderCompiler>
     {
     public:
@@ -25,11 +32,38 @@ namespace vsg
         // default ShaderCompileSettings
         ref_ptr<ShaderCompileSettings> defaults;
 
+        /// directory used to cache compiled SPIRV, if empty the options->fileCache/shaders directory is used when the Options passed to compile(..) have a fileCache.
+        /// Cache files are named after a hash of the final shader sources, defines, ShaderCompileSettings and compiler versions, and are replaced atomically so can be shared between concurrent processes.
+        Path cacheDirectory;
+
         bool compile(ShaderStages& shaders, const std::vector<std::string>& defines = {}, ref_ptr<const Options> options = {});
         bool compile(ref_ptr<ShaderStage> shaderStage, const std::vector<std::string>& defines = {}, ref_ptr<const Options> options = {});
 
+        /// compile the ShaderStages variants of a ShaderSet for each of the specified sets of defines, filling in ShaderSet::variants and, when enabled, the disk cache.
+        /// If no defineSets are specified, the variants for the ShaderSet's default defines and the defines of each of its definesArrayStates, along with any existing variants, are compiled.
+        /// Return true if all the variants compiled successfully.
+        bool compile(ShaderSet& shaderSet, const std::vector<std::set<std::string>>& defineSets = {}, ref_ptr<const Options> options = {});
+
+        /// compile the ShaderSet variants for the specified ShaderCompileSettings, spreading the work across options->operationThreads when assigned.
+        /// New variants are registered in ShaderSet::pendingVariants while they are compiled so that getShaderStages(..) calls on other threads wait for them rather than creating duplicates.
+        /// Return true if all the variants compiled successfully.
+        bool compileVariants(ShaderSet& shaderSet, const std::vector<ref_ptr<ShaderCompileSettings>>& variantSettings, ref_ptr<const Options> options = {});
+
+        /// compile each entry of a list of ShaderStages, spreading the work across options->operationThreads when assigned, each thread using its own ShaderCompiler.
+        /// Timings are reported through options->instrumentation. Return true if all entries compiled successfully.
+        bool compile(std::vector<ShaderStages>& shaderStagesList, ref_ptr<const Options> options);
+
+        /// collect the ShaderStages of the graphics, compute and ray tracing pipelines in a scene graph that require compiling, for passing to compile(shaderStagesList, options).
+        static std::vector<ShaderStages> collectShaderStages(Object& object);
+
         std::string combineSourceAndDefines(const std::string& source, const std::vector<std::string>& defines);
 
+        /// return the source of a shader stage after the includes are inserted and the defines applied, as passed to glslang by compile(..).
+        std::string finalShaderSource(const ShaderStage& shaderStage, const std::vector<std::string>& defines = {}, ref_ptr<const Options> options = {});
+
+        /// return the directory to use for the disk cache, cacheDirectory if set, otherwise options->fileCache/shaders, or empty if caching is disabled.
+        Path getCacheDirectory(const Options* options) const;
+
         void apply(Node& node) override;
         void apply(BindGraphicsPipeline& bgp) override;
         void apply(BindComputePipeline& bgp) override;
@@ -37,6 +71,10 @@ namespace vsg
 
     protected:
         bool _initialized = false;
+
+        std::string _cacheKey(const ShaderStages& shaders, const std::vector<std::string>& finalSources) const;
+        bool _readFromCache(const Path& directory, const std::string& key, ShaderStages& shaders) const;
+        bool _writeToCache(const Path& directory, const std::string& key, const ShaderStages& shaders) const;
     };
     VSG_type_name(vsg::ShaderCompiler);
 
@@ -19,6 +19,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/ShaderStage.h>
 #include <vsg/utils/CoordinateSpace.h>
 
+#include <future>
+
 namespace vsg
 {
 
@@ -132,7 +134,10 @@ namespace vsg
         /// variants of the rootShaderModule compiled for different combinations of ShaderCompileSettings
         std::map<ref_ptr<ShaderCompileSettings>, ShaderStages, DereferenceLess> variants;
 
-        /// mutex used by getShaderStages(..) to ensure the variants map can be used from multiple threads.
+        /// variants currently being compiled by ShaderCompiler::compileVariants(..), getShaderStages(..) waits on these rather than creating duplicate variants. If the compile throws the entry is removed and the exception is passed on to the waiting getShaderStages(..) calls.
+        std::map<ref_ptr<ShaderCompileSettings>, std::shared_future<ShaderStages>, DereferenceLess> pendingVariants;
+
+        /// mutex used by getShaderStages(..) to ensure the variants and pendingVariants maps can be used from multiple threads.
         std::mutex mutex;
 
         /// add an attribute binding, Not thread safe, should only be called when initially setting up the ShaderSet
@@ -165,9 +170,13 @@ namespace vsg
         /// get the first ArrayState that has matches with defines in the specified list of defines.
         ref_ptr<ArrayState> getSuitableArrayState(const std::set<std::string>& defines) const;
 
-        /// get the ShaderStages variant that uses specified ShaderCompileSettings.
+        /// get the ShaderStages variant that uses specified ShaderCompileSettings, if the variant is being compiled by another thread wait for it to complete.
         ShaderStages getShaderStages(ref_ptr<ShaderCompileSettings> scs = {});
 
+        /// create a new ShaderStages variant that uses specified ShaderCompileSettings, the base stages are reused where their hints match.
+        /// Does not add the variant to the variants map or lock the mutex, the caller is responsible for this.
+        ShaderStages createShaderStages(ref_ptr<ShaderCompileSettings> scs) const;
+
         /// return the <minimum_set, maximum_set+1> range of set numbers encompassing DescriptorBindings
         std::pair<uint32_t, uint32_t> descriptorSetRange() const;
 
@@ -212,4 +221,12 @@ namespace vsg
     /// create a ShaderSet for Physics Based Rendering
     extern VSG_DECLSPEC ref_ptr<ShaderSet> createPhysicsBasedRenderingShaderSet(ref_ptr<const Options> options = {});
 
+    /// enable clustered lighting for a ShaderSet that declares the "lightClusters" descriptor, such as the one returned by createPhongShaderSet().
+    /// Adds VSG_LIGHT_CLUSTERS to the ShaderSet's defaultShaderHints so pipelines created from it afterwards use the clustered lighting path,
+    /// and ViewDependentState set up with the ShaderSet bins the point and spot lights into LightClusters. Returns false if the ShaderSet doesn't support it.
+    extern VSG_DECLSPEC bool enableLightClusters(ShaderSet& shaderSet);
+
+    /// return true if enableLightClusters(..) has been called on the ShaderSet.
+    extern VSG_DECLSPEC bool lightClustersEnabled(const ShaderSet& shaderSet);
+
 } // namespace vsg
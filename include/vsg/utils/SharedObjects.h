@@ -16,10 +16,12 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/compare.h>
 #include <vsg/io/stream.h>
 
+#include <array>
 #include <map>
 #include <mutex>
 #include <ostream>
 #include <set>
+#include <unordered_map>
 
 namespace vsg
 {
@@ -28,6 +30,8 @@ namespace vsg
     class SuitableForSharing;
 
     /// class for facilitating the sharing of instances of objects that have the same properties.
+    /// Objects are indexed by a structural hash of their contents, so lookups only need to compare objects when their hashes match,
+    /// and the index is split into shards with their own mutex so that share(..) can be called concurrently from multiple threads.
     class VSG_DECLSPEC SharedObjects : public Inherit<Object, SharedObjects>
     {
     public:
@@ -72,12 +76,53 @@ namespace vsg
         /// write out stats of objects held, types of objects and their reference counts
         void report(vsg::LogOutput& output);
 
+        /// return the structural hash of an object, computed from the values it writes when serialized. Objects that compare as equal have the same hash.
+        /// The hashes of the objects held are cached so that objects referencing shared objects don't need to rehash them.
+        uint64_t hash(const Object* object) const;
+
+        static constexpr size_t numShards = 64;
+
     protected:
         virtual ~SharedObjects();
 
+        struct SharedObject
+        {
+            std::type_index type;
+            ref_ptr<Object> object;
+        };
+
+        /// shared objects keyed by the combined hash of the type they are shared as and their contents, objects are assigned to the Shard selected by this key
+        struct Shard
+        {
+            std::mutex mutex;
+            std::unordered_multimap<uint64_t, SharedObject> objects;
+        };
+
+        /// cached hashes of the shared objects, objects are assigned to the HashShard selected by their address
+        struct HashShard
+        {
+            std::mutex mutex;
+            std::unordered_map<const Object*, uint64_t> hashes;
+        };
+
+        /// mutex used for the defaults, loaded objects and pruning
         mutable std::recursive_mutex _mutex;
         std::map<std::type_index, ref_ptr<Object>> _defaults;
-        std::map<std::type_index, std::set<ref_ptr<Object>, DereferenceLess>> _sharedObjects;
+        std::set<ref_ptr<Object>, DereferenceLess> _loadedObjects;
+
+        std::array<Shard, numShards> _shards;
+        mutable std::array<HashShard, numShards> _hashShards;
+
+        /// mutex used to serialize access to a custom suitableForSharing visitor
+        std::mutex _suitableForSharingMutex;
+
+        bool _suitable(const Object* object);
+
+        /// return the shared object that matches object when shared as type, if no match is found and insert is true object is added and returned, otherwise null is returned.
+        ref_ptr<Object> _share(const std::type_index& type, ref_ptr<Object> object, bool insert);
+
+        uint64_t _hash(const Object* object, std::set<const Object*>& active) const;
+        void _pruneHash(const Object* object);
     };
     VSG_type_name(vsg::SharedObjects);
 
@@ -134,17 +179,7 @@ namespace vsg
         auto def_T = def.cast<T>(); // should be able to do a static cast
         if (!def_T)
         {
-            def_T = T::create();
-            auto& shared_objects = _sharedObjects[id];
-            if (auto itr = shared_objects.find(def_T); itr != shared_objects.end())
-            {
-                def_T = (static_cast<T*>(itr->get()));
-            }
-            else
-            {
-                shared_objects.insert(def_T);
-            }
-
+            def_T = static_cast<T*>(_share(id, T::create(), true).get());
             def = def_T;
         }
 
@@ -155,47 +190,31 @@ namespace vsg
     template<class T>
     void SharedObjects::share(ref_ptr<T>& object)
     {
-        std::scoped_lock<std::recursive_mutex> lock(_mutex);
-
-        if (suitableForSharing && !suitableForSharing->suitable(object.get())) return;
-
-        auto id = std::type_index(typeid(T));
-        auto& shared_objects = _sharedObjects[id];
-        if (auto itr = shared_objects.find(object); itr != shared_objects.end())
-        {
-            object = ref_ptr<T>(static_cast<T*>(itr->get()));
-            return;
-        }
+        if (!object || !_suitable(object.get())) return;
 
-        shared_objects.insert(object);
+        object = static_cast<T*>(_share(std::type_index(typeid(T)), object, true).get());
     }
 
     // implementation of template method
     template<class T, typename Func>
     void SharedObjects::share(ref_ptr<T>& object, Func init)
     {
+        auto id = std::type_index(typeid(T));
+        if (object)
         {
-            std::scoped_lock<std::recursive_mutex> lock(_mutex);
-
-            auto id = std::type_index(typeid(T));
-            auto& shared_objects = _sharedObjects[id];
-            if (auto itr = shared_objects.find(object); itr != shared_objects.end())
+            if (auto existing = _share(id, object, false))
             {
-                object = ref_ptr<T>(static_cast<T*>(itr->get()));
+                object = static_cast<T*>(existing.get());
                 return;
             }
         }
 
         init(object);
 
+        if (object && _suitable(object.get()))
         {
-            std::scoped_lock<std::recursive_mutex> lock(_mutex);
-            auto id = std::type_index(typeid(T));
-            auto& shared_objects = _sharedObjects[id];
-            if (suitableForSharing && suitableForSharing->suitable(object.get()))
-            {
-                shared_objects.insert(object);
-            }
+            // another thread may have shared a matching object while init(..) was running, so use the matching object if there is one
+            object = static_cast<T*>(_share(id, object, true).get());
         }
     }
 
@@ -0,0 +1,120 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/maths/plane.h>
+#include <vsg/maths/vec3.h>
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace vsg
+{
+
+    /// TriangleBVH is a bounding volume hierarchy over the triangles of a VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST draw,
+    /// used by LineSegmentIntersector and PolytopeIntersector to avoid testing every triangle of large meshes.
+    /// Each Node holds the bounds of up to 4 children in SoA form so they can be tested together using SIMD.
+    /// TriangleBVH is built on demand by the Intersector and cached in its assigned TriangleBVHCache, see Intersector::getTriangleBVH(..).
+    class VSG_DECLSPEC TriangleBVH : public Inherit<Object, TriangleBVH>
+    {
+    public:
+        TriangleBVH();
+
+        static constexpr uint32_t maxLeafSize = 4;
+
+        struct Node
+        {
+            float minX[4];
+            float minY[4];
+            float minZ[4];
+            float maxX[4];
+            float maxY[4];
+            float maxZ[4];
+
+            /// index of the child Node when count is 0, otherwise the index of the first triangle of the leaf. A child and count of 0 marks an empty slot.
+            uint32_t child[4];
+
+            /// number of triangles in the leaf, 0 for child Nodes
+            uint32_t count[4];
+        };
+
+        std::vector<Node> nodes;
+
+        /// vertex indices of each triangle, reordered so that the triangles of each leaf are contiguous
+        std::vector<uivec3> triangles;
+
+        /// build the hierarchy for the triangles in the range [first, first+count) of the vertex or index array.
+        /// indices may be a ushortArray or uintArray, or null for non indexed draws.
+        void build(ref_ptr<const vec3Array> in_vertices, ref_ptr<const Data> in_indices, uint32_t first, uint32_t count);
+
+        /// return true if the hierarchy was built from the specified arrays and range, and the arrays haven't been modified since.
+        bool valid(const vec3Array* in_vertices, const Data* in_indices, uint32_t first, uint32_t count) const;
+
+        /// vertex array the hierarchy was built from
+        const vec3Array* vertices() const { return _vertices.get(); }
+
+        /// append the index, into the triangles list, of each triangle in leaves whose bounds intersect the line segment.
+        void intersect(const dvec3& start, const dvec3& end, std::vector<uint32_t>& candidates) const;
+
+        /// append the index, into the triangles list, of each triangle in leaves whose bounds are inside or intersect the polytope.
+        void intersect(const std::vector<dplane>& polytope, std::vector<uint32_t>& candidates) const;
+
+    protected:
+        ref_ptr<const vec3Array> _vertices;
+        ref_ptr<const Data> _indices;
+        ModifiedCount _verticesModifiedCount;
+        ModifiedCount _indicesModifiedCount;
+        uint32_t _first = 0;
+        uint32_t _count = 0;
+    };
+    VSG_type_name(vsg::TriangleBVH);
+
+    /// TriangleBVHCache holds the TriangleBVH built for each draw, keyed by the draw node and the range of the vertex or index array it draws.
+    /// Cached TriangleBVH are rebuilt when the arrays are modified. Assign the same TriangleBVHCache to multiple Intersectors, including ones
+    /// running in different threads, to reuse the TriangleBVH between them.
+    class VSG_DECLSPEC TriangleBVHCache : public Inherit<Object, TriangleBVHCache>
+    {
+    public:
+        TriangleBVHCache();
+
+        /// when the number of entries reaches this size, entries whose vertex array is only referenced by the cache are removed.
+        size_t minimumPruneSize = 64;
+
+        /// get the TriangleBVH for the draw, building it when no valid TriangleBVH is cached.
+        ref_ptr<const TriangleBVH> getOrCreate(const Object* draw, ref_ptr<const vec3Array> vertices, ref_ptr<const Data> indices, uint32_t first, uint32_t count);
+
+        /// remove the entries whose vertex array is only referenced by the cache, as the draw it was built for has been deleted. Return the number of entries removed.
+        size_t prune();
+
+        void clear();
+
+        size_t size() const;
+
+    protected:
+        virtual ~TriangleBVHCache();
+
+        size_t _prune();
+
+        using Key = std::tuple<const Object*, uint32_t, uint32_t>;
+
+        mutable std::mutex _mutex;
+        std::map<Key, ref_ptr<TriangleBVH>> _triangleBVHs;
+        size_t _pruneSize = 0;
+    };
+    VSG_type_name(vsg::TriangleBVHCache);
+
+} // namespace vsg
@@ -0,0 +1,123 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Visitor.h>
+#include <vsg/utils/ComputeBounds.h>
+
+#include <set>
+#include <unordered_map>
+
+namespace vsg
+{
+
+    /// UpdateBounds maintains the bounds of each node in a scene graph so that, after the first traversal, subsequent traversals
+    /// only recompute the branches that have changed rather than the whole scene graph.
+    /// A node and the path above it are recomputed when vertex or index Data it uses has been dirty(), when a Transform's matrix has changed,
+    /// or when it's been marked with dirty(node), which should be called after adding/removing children or other changes to a node.
+    /// Reuse the same UpdateBounds instance for each traversal of the scene graph, i.e.
+    ///     auto updateBounds = vsg::UpdateBounds::create();
+    ///     scene->accept(*updateBounds); // initial traversal computes the bounds of every node
+    ///     vertices->dirty(); transform->matrix = newMatrix; group->addChild(node); updateBounds->dirty(group);
+    ///     scene->accept(*updateBounds); // only recomputes the modified branches
+    class VSG_DECLSPEC UpdateBounds : public Inherit<Visitor, UpdateBounds>
+    {
+    public:
+        explicit UpdateBounds(ref_ptr<ArrayState> intialArrayState = {});
+
+        /// Result of the last traversal, the bounds of the root node in its parent's coordinate frame
+        dbox bounds;
+
+        /// Update the bound of CullGroup, CullNode and LOD nodes to enclose their subgraphs when they are recomputed.
+        bool updateNodeBounds = true;
+
+        /// mark node, and the path above it, to be recomputed on the next traversal. If subgraph is true all nodes below it are recomputed as well,
+        /// which is required when the node's state affects its subgraph, such as changes to a StateGroup's vertex arrays.
+        void dirty(const Node* node, bool subgraph = false);
+
+        /// return true if node has cached bounds that are up to date, set bound to the node's bounds in its parent's coordinate frame.
+        bool getBounds(const Node* node, dbox& bound) const;
+
+        /// clear all cached bounds so that the next traversal recomputes everything
+        void clear();
+
+        void apply(Node& node) override;
+        void apply(Compilable& compilable) override;
+        void apply(Commands& commands) override;
+        void apply(StateGroup& stateGroup) override;
+        void apply(Transform& transform) override;
+        void apply(CullGroup& cullGroup) override;
+        void apply(CullNode& cullNode) override;
+        void apply(LOD& lod) override;
+        void apply(PagedLOD& plod) override;
+        void apply(InstanceNode& instanceNode) override;
+        void apply(Text& text) override;
+        void apply(TextGroup& textGroup) override;
+
+    protected:
+        /// arrays bound by a leaf node that are inherited by the leaf nodes that follow it under the same parent,
+        /// such as from sibling BindVertexBuffers and BindIndexBuffer commands.
+        struct ArrayBindings
+        {
+            ref_ptr<ArrayState> arrayState;
+            ref_ptr<const ushortArray> ushort_indices;
+            ref_ptr<const uintArray> uint_indices;
+        };
+
+        struct Entry
+        {
+            ref_ptr<const Node> node;
+            dbox bounds;
+            bool dirty = true;
+            dmat4 matrix;
+            std::vector<const Node*> parents;
+            std::vector<const Node*> children;
+            std::vector<const Data*> data;
+            ArrayBindings inputBindings;
+            ArrayBindings outputBindings;
+        };
+
+        struct DataEntry
+        {
+            ref_ptr<const Data> data;
+            ModifiedCount modifiedCount;
+            std::vector<const Node*> nodes;
+        };
+
+        template<class N, typename F>
+        void _apply(N& node, F compute, bool leaf = false);
+
+        dbox _traverse(Node& node, Entry& entry);
+        void _computeLeafBounds(const Node& node, Entry& entry);
+        void _updateBound(dsphere& bound, const dbox& bb) const;
+        bool _sameBindings(const ArrayBindings& lhs, const ArrayBindings& rhs) const;
+
+        void _checkForModifications();
+        void _markDirty(const Node* node);
+        void _markSubgraphDirty(const Node* node);
+        void _releaseData(Entry& entry);
+        void _releaseChild(const Node* child, const Node* parent);
+
+        ref_ptr<ComputeBounds> _computeBounds;
+        std::unordered_map<const Node*, Entry> _entries;
+        std::unordered_map<const Data*, DataEntry> _dataEntries;
+        std::set<const Transform*> _transforms;
+        std::vector<Entry*> _parentStack;
+        std::vector<dbox> _boundsStack;
+        std::vector<ArrayBindings> _bindingsStack;
+        const InstanceNode* _instanceNode = nullptr;
+    };
+    VSG_type_name(vsg::UpdateBounds);
+
+} // namespace vsg
@@ -15,6 +15,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/ScratchMemory.h>
 #include <vsg/state/PipelineLayout.h>
 #include <vsg/vk/CommandPool.h>
+#include <vsg/vk/CommandStream.h>
 
 namespace vsg
 {
@@ -29,6 +30,9 @@ namespace vsg
     class VSG_DECLSPEC CommandBuffer : public Inherit<Object, CommandBuffer>
     {
     public:
+        /// create a CommandBuffer without a Vulkan device that records to the specified CommandStream, used for recording scene graphs headless.
+        explicit CommandBuffer(ref_ptr<CommandStream> in_commandStream, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
         const VkCommandBuffer* data() const { return &_commandBuffer; }
         operator VkCommandBuffer() const { return _commandBuffer; }
         VkCommandBuffer vk() const { return _commandBuffer; }
@@ -44,6 +48,9 @@ namespace vsg
         const InstanceNode* instanceNode = nullptr;
         ref_ptr<GPUStatsCollection> gpuStats;
 
+        /// when assigned the RecordTraversal and State append commands to the CommandStream rather than recording them to the VkCommandBuffer.
+        ref_ptr<CommandStream> commandStream;
+
         VkCommandBufferLevel level() const { return _level; }
 
         /// reset the CommandBuffer for the new frame.
@@ -0,0 +1,124 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Inherit.h>
+#include <vsg/maths/mat4.h>
+
+#include <vector>
+
+namespace vsg
+{
+
+    // forward declare
+    class Command;
+    class CommandBuffer;
+    class InstanceNode;
+    class PipelineLayout;
+    class StateCommand;
+    class ViewDependentState;
+
+    /// CommandStream is a compact CPU side record of the commands recorded by the RecordTraversal, used as an alternative backend to a VkCommandBuffer.
+    /// Assign a CommandStream to CommandBuffer::commandStream, or create a device-less CommandBuffer with CommandBuffer::create(commandStream), and the
+    /// RecordTraversal and its State append the Command, StateCommand and matrix push constants to the stream rather than calling vkCmd*,
+    /// so that the cull and record of a scene graph can be run and profiled without a Vulkan device.
+    /// The stream can be replayed into a VkCommandBuffer later, and can be inspected standalone via computeStatistics().
+    /// The commands are referenced by pointer so the scene graph must be kept alive until the stream is replayed or cleared.
+    /// Render pass begin/end and the parallel recording of View via RecordThreads are not captured, replay the stream within the appropriate render pass.
+    class VSG_DECLSPEC CommandStream : public Inherit<Object, CommandStream>
+    {
+    public:
+        CommandStream();
+
+        enum Type : uint32_t
+        {
+            COMMAND,
+            STATE_COMMAND,
+            PUSH_MATRIX,
+            SET_CONTEXT
+        };
+
+        /// entry in the stream, index refers to the matrix of PUSH_MATRIX entries and the context of SET_CONTEXT entries.
+        struct Entry
+        {
+            Type type;
+            uint32_t index;
+            const Command* command;
+        };
+
+        /// matrix pushed as a push constant by the State's projection and modelview MatrixStack.
+        struct PushMatrix
+        {
+            uint32_t offset;
+            mat4 matrix;
+        };
+
+        /// CommandBuffer settings read by commands when they are recorded, restored on replay when they change.
+        struct Context
+        {
+            uint32_t viewID = 0;
+            ViewDependentState* viewDependentState = nullptr;
+            const InstanceNode* instanceNode = nullptr;
+        };
+
+        struct Statistics
+        {
+            uint32_t numCommands = 0;
+            uint32_t numStateCommands = 0;
+            uint32_t numDraws = 0;
+            uint32_t numPipelineBinds = 0;
+            uint32_t numDescriptorSetBinds = 0;
+            uint32_t numVertexBufferBinds = 0;
+            uint32_t numIndexBufferBinds = 0;
+            uint32_t numPushConstants = 0;
+        };
+
+        /// clear the stream ready for recording a new frame.
+        void clear();
+
+        /// append a command recorded by the RecordTraversal.
+        void add(CommandBuffer& commandBuffer, const Command& command);
+
+        /// append a state command recorded by the State, tracking pipeline layout changes in the same way as CommandBuffer::setCurrentPipelineLayout(..).
+        void add(CommandBuffer& commandBuffer, const StateCommand& stateCommand);
+
+        /// append a matrix push constant, return false if no pipeline layout with push constants is current, matching the behavior of MatrixStack::record(..) when recording to a VkCommandBuffer.
+        bool pushMatrix(CommandBuffer& commandBuffer, uint32_t offset, const mat4& matrix);
+
+        /// replay the stream into a CommandBuffer, which must be in the recording state and connected to a State.
+        void replay(CommandBuffer& commandBuffer) const;
+
+        /// count the draws, binds and push constants in the stream.
+        Statistics computeStatistics() const;
+
+        const std::vector<Entry>& entries() const { return _entries; }
+        const std::vector<PushMatrix>& matrices() const { return _matrices; }
+        const std::vector<Context>& contexts() const { return _contexts; }
+
+        size_t size() const { return _entries.size(); }
+        bool empty() const { return _entries.empty(); }
+
+    protected:
+        virtual ~CommandStream();
+
+        void _updateContext(const CommandBuffer& commandBuffer);
+
+        std::vector<Entry> _entries;
+        std::vector<PushMatrix> _matrices;
+        std::vector<Context> _contexts;
+
+        const PipelineLayout* _currentPipelineLayout = nullptr;
+    };
+    VSG_type_name(vsg::CommandStream);
+
+} // namespace vsg
@@ -139,6 +139,7 @@ namespace vsg
         void apply(const Geometry& geometry) override;
         void apply(const VertexDraw& vid) override;
         void apply(const VertexIndexDraw& vid) override;
+        void apply(const InstanceNode& instanceNode) override;
         void apply(const BindVertexBuffers& bvb) override;
         void apply(const BindIndexBuffer& bib) override;
 
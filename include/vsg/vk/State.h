@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/maths/intersect.h>
 #include <vsg/maths/plane.h>
 #include <vsg/maths/transform.h>
 #include <vsg/nodes/MatrixTransform.h>
@@ -69,7 +70,10 @@ namespace vsg
             const T* current = stack[pos];
             if (current != stack[0])
             {
-                current->record(commandBuffer);
+                if (commandBuffer.commandStream)
+                    commandBuffer.commandStream->add(commandBuffer, *current);
+                else
+                    current->record(commandBuffer);
                 stack[0] = current;
             }
         }
@@ -141,6 +145,12 @@ namespace vsg
         {
             if (dirty)
             {
+                if (commandBuffer.commandStream)
+                {
+                    if (commandBuffer.commandStream->pushMatrix(commandBuffer, offset, mat4(matrixStack.top()))) dirty = false;
+                    return;
+                }
+
                 auto pipeline = commandBuffer.getCurrentPipelineLayout();
                 auto stageFlags = commandBuffer.getCurrentPushConstantStageFlags();
 
@@ -225,6 +235,12 @@ namespace vsg
                 if (distance(face[5], s.center) < negative_radius) return false;
             return true;
         }
+
+        /// batched version of intersect(sphere), results[i] is set to 1 if spheres[i] wholly or partially intersects the frustum and 0 if it's wholly outside
+        void intersect(const t_sphere<value_type>* spheres, size_t numSpheres, uint8_t* results) const
+        {
+            vsg::intersect(face, POLYTOPE_SIZE, spheres, numSpheres, results);
+        }
     };
 
     /// vsg::State is used by vsg::RecordTraversal to manage state stacks, projection and modelview matrices and frustum stacks.
@@ -258,6 +274,13 @@ namespace vsg
 
         uint32_t viewportStateHint = 0;
 
+        /// render pass settings of the current vkCmdBeginRenderPass/vkCmdNextSubpass, set by RenderGraph and NextSubPass,
+        /// used to set up the VkCommandBufferInheritanceInfo of secondary command buffers recorded on behalf of this State.
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        VkFramebuffer framebuffer = VK_NULL_HANDLE;
+        uint32_t subpass = 0;
+        VkSubpassContents subpassContents = VK_SUBPASS_CONTENTS_INLINE;
+
         MatrixStack projectionMatrixStack{0};
         MatrixStack modelviewMatrixStack{64};
 
@@ -267,6 +290,10 @@ namespace vsg
 
         void reset();
 
+        /// copy the state stacks, matrix stacks, frustum stack and render pass settings from another State,
+        /// used to set up a State to record a subgraph on a separate thread to the one traversing rhs.
+        void inherit(const State& rhs);
+
         inline void dirtyStateStacks()
         {
             for (auto& stateStack : stateStacks)
@@ -398,6 +425,12 @@ namespace vsg
             return _frustumStack.top().intersect(s);
         }
 
+        /// batched view frustum test of numSpheres bounding spheres against the current frustum, see Frustum::intersect(spheres, numSpheres, results)
+        void intersect(const t_sphere<Frustum::value_type>* spheres, size_t numSpheres, uint8_t* results) const
+        {
+            _frustumStack.top().intersect(spheres, numSpheres, results);
+        }
+
         template<typename T>
         T lodDistance(const t_sphere<T>& s) const
         {
@@ -407,6 +440,14 @@ namespace vsg
             const auto& lodScale = frustum.lodScale;
             return std::abs(lodScale[0] * s.x + lodScale[1] * s.y + lodScale[2] * s.z + lodScale[3]);
         }
+
+        /// compute the LOD distance of a bounding sphere that is already known to intersect the view frustum
+        template<typename T>
+        T lodDistanceInFrustum(const t_sphere<T>& s) const
+        {
+            const auto& lodScale = _frustumStack.top().lodScale;
+            return std::abs(lodScale[0] * s.x + lodScale[1] * s.y + lodScale[2] * s.z + lodScale[3]);
+        }
     };
 
 } // namespace vsg
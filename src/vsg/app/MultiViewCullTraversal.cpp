@@ -0,0 +1,364 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/animation/Joint.h>
+#include <vsg/app/MultiViewCullTraversal.h>
+#include <vsg/app/RecordTraversal.h>
+#include <vsg/io/DatabasePager.h>
+#include <vsg/lighting/Light.h>
+#include <vsg/nodes/CullGroup.h>
+#include <vsg/nodes/CullNode.h>
+#include <vsg/nodes/DepthSorted.h>
+#include <vsg/nodes/LOD.h>
+#include <vsg/nodes/Layer.h>
+#include <vsg/nodes/PagedLOD.h>
+#include <vsg/nodes/QuadGroup.h>
+#include <vsg/nodes/RegionOfInterest.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/Switch.h>
+#include <vsg/nodes/Transform.h>
+#include <vsg/ui/FrameStamp.h>
+
+using namespace vsg;
+
+MultiViewCullTraversal::MultiViewCullTraversal(const Slots& maxSlots) :
+    _state(State::create(maxSlots))
+{
+    reset(maxSlots);
+}
+
+MultiViewCullTraversal::~MultiViewCullTraversal()
+{
+}
+
+void MultiViewCullTraversal::reset(const Slots& maxSlots)
+{
+    _state->reserve(maxSlots);
+    _state->reset();
+
+    _views.clear();
+    _frustumStack.clear();
+    _modelMatrixStack.assign(1, dmat4());
+    _modelviewMatrices.clear();
+    _modelviewMatricesDirty = true;
+    _viewMask = 0;
+
+    setLODViewpoint(dmat4(), dmat4());
+}
+
+void MultiViewCullTraversal::setLODViewpoint(const dmat4& projectionMatrix, const dmat4& viewMatrix)
+{
+    _lodProjectionMatrix = projectionMatrix;
+    _lodViewMatrix = viewMatrix;
+
+    Frustum frustum;
+    frustum.computeLodScale(_lodProjectionMatrix, _lodViewMatrix * _modelMatrixStack.back());
+
+    _lodScaleStack.assign(1, frustum.lodScale);
+}
+
+bool MultiViewCullTraversal::addView(const dmat4& projectionMatrix, const dmat4& viewMatrix, ref_ptr<Bin> bin)
+{
+    // views can only be added before the traversal starts, when the frustum stack just holds the world coordinate frustum of each view
+    if (_views.size() >= maxNumViews || _frustumStack.size() != _views.size()) return false;
+
+    bin->clear();
+
+    Frustum projected(Frustum(), projectionMatrix);
+    _frustumStack.emplace_back(projected, viewMatrix * _modelMatrixStack.back());
+
+    _views.push_back(ViewFrustum{viewMatrix, projected, bin});
+    _viewMask |= (1u << (_views.size() - 1));
+    _modelviewMatricesDirty = true;
+
+    return true;
+}
+
+void MultiViewCullTraversal::_pushFrustum()
+{
+    const auto& model = _modelMatrixStack.back();
+    for (auto& view : _views)
+    {
+        _frustumStack.emplace_back(view.projected, view.viewMatrix * model);
+    }
+
+    Frustum frustum;
+    frustum.computeLodScale(_lodProjectionMatrix, _lodViewMatrix * model);
+    _lodScaleStack.push_back(frustum.lodScale);
+}
+
+void MultiViewCullTraversal::_popFrustum()
+{
+    _frustumStack.resize(_frustumStack.size() - _views.size());
+    _lodScaleStack.pop_back();
+}
+
+uint32_t MultiViewCullTraversal::_intersect(const dsphere& sphere) const
+{
+    uint32_t visibleMask = 0;
+    const Frustum* frustums = _frustumStack.data() + (_frustumStack.size() - _views.size());
+    for (uint32_t i = 0; i < _views.size(); ++i)
+    {
+        uint32_t bit = 1u << i;
+        if ((_viewMask & bit) != 0 && frustums[i].intersect(sphere)) visibleMask |= bit;
+    }
+    return visibleMask;
+}
+
+double MultiViewCullTraversal::_lodDistance(const dsphere& s) const
+{
+    const auto& lodScale = _lodScaleStack.back();
+    return std::abs(lodScale[0] * s.x + lodScale[1] * s.y + lodScale[2] * s.z + lodScale[3]);
+}
+
+void MultiViewCullTraversal::_traverse(const Node& node, uint32_t viewMask)
+{
+    auto cached_viewMask = _viewMask;
+    _viewMask = viewMask;
+
+    node.accept(*this);
+
+    _viewMask = cached_viewMask;
+}
+
+void MultiViewCullTraversal::_addToDrawLists(const Node& node, uint32_t viewMask)
+{
+    if (_modelviewMatricesDirty)
+    {
+        const auto& model = _modelMatrixStack.back();
+        _modelviewMatrices.resize(_views.size());
+        for (size_t i = 0; i < _views.size(); ++i)
+        {
+            _modelviewMatrices[i] = _views[i].viewMatrix * model;
+        }
+        _modelviewMatricesDirty = false;
+    }
+
+    for (uint32_t i = 0; i < _views.size(); ++i)
+    {
+        if ((viewMask & (1u << i)) != 0)
+        {
+            _views[i].bin->add(_state, _modelviewMatrices[i], 0.0, &node);
+        }
+    }
+}
+
+void MultiViewCullTraversal::apply(const Node& node)
+{
+    // nodes not handled explicitly are leaves of the cull traversal, when the draw lists are recorded the RecordTraversal visits them as it would when traversing the scene graph
+    _addToDrawLists(node, _viewMask);
+}
+
+void MultiViewCullTraversal::apply(const Group& group)
+{
+    for (const auto& child : group.children)
+    {
+        child->accept(*this);
+    }
+}
+
+void MultiViewCullTraversal::apply(const QuadGroup& quadGroup)
+{
+    for (const auto& child : quadGroup.children)
+    {
+        child->accept(*this);
+    }
+}
+
+void MultiViewCullTraversal::apply(const LOD& lod)
+{
+    const auto& sphere = lod.bound;
+
+    auto visibleMask = _intersect(sphere);
+    if (visibleMask == 0) return;
+
+    auto lodDistance = _lodDistance(sphere);
+    for (auto& child : lod.children)
+    {
+        auto cutoff = lodDistance * child.minimumScreenHeightRatio;
+        bool child_visible = sphere.r > cutoff;
+        if (child_visible)
+        {
+            _traverse(*child.node, visibleMask);
+            return;
+        }
+    }
+}
+
+void MultiViewCullTraversal::apply(const PagedLOD& plod)
+{
+    const auto& sphere = plod.bound;
+    auto frameCount = frameStamp ? frameStamp->frameCount : 0;
+    auto culledPagedLODs = databasePager ? databasePager->culledPagedLODs.get() : nullptr;
+
+    auto visibleMask = _intersect(sphere);
+    if (visibleMask == 0)
+    {
+        if ((frameCount - plod.frameHighResLastUsed) > 1 && culledPagedLODs)
+        {
+            culledPagedLODs->highresCulled.emplace_back(&plod);
+        }
+
+        return;
+    }
+
+    auto lodDistance = _lodDistance(sphere);
+
+    // check the high res child to see if it's visible
+    {
+        const auto& child = plod.children[0];
+
+        auto cutoff = lodDistance * child.minimumScreenHeightRatio;
+        bool child_visible = sphere.r > cutoff;
+        if (child_visible)
+        {
+            auto previousHighResUsed = plod.frameHighResLastUsed.exchange(frameCount);
+            if (culledPagedLODs && ((frameCount - previousHighResUsed) > 1))
+            {
+                culledPagedLODs->newHighresRequired.emplace_back(&plod);
+            }
+
+            if (child.node)
+            {
+                // high res visible and available so traverse it
+                _traverse(*child.node, visibleMask);
+                return;
+            }
+            else if (databasePager)
+            {
+                databasePager->requestHighRes(plod, sphere.r / cutoff);
+            }
+        }
+        else
+        {
+            if (culledPagedLODs && ((frameCount - plod.frameHighResLastUsed) <= 1))
+            {
+                culledPagedLODs->highresCulled.emplace_back(&plod);
+            }
+        }
+    }
+
+    // check the low res child to see if it's visible
+    {
+        const auto& child = plod.children[1];
+        auto cutoff = lodDistance * child.minimumScreenHeightRatio;
+        bool child_visible = sphere.r > cutoff;
+        if (child_visible && child.node)
+        {
+            _traverse(*child.node, visibleMask);
+        }
+    }
+}
+
+void MultiViewCullTraversal::apply(const CullGroup& cullGroup)
+{
+    auto visibleMask = _intersect(cullGroup.bound);
+    if (visibleMask == 0) return;
+
+    auto cached_viewMask = _viewMask;
+    _viewMask = visibleMask;
+
+    for (const auto& child : cullGroup.children)
+    {
+        child->accept(*this);
+    }
+
+    _viewMask = cached_viewMask;
+}
+
+void MultiViewCullTraversal::apply(const CullNode& cullNode)
+{
+    auto visibleMask = _intersect(cullNode.bound);
+    if (visibleMask != 0 && cullNode.child)
+    {
+        _traverse(*cullNode.child, visibleMask);
+    }
+}
+
+void MultiViewCullTraversal::apply(const DepthSorted& depthSorted)
+{
+    auto visibleMask = _intersect(depthSorted.bound);
+    if (visibleMask != 0 && depthSorted.child)
+    {
+        _addToDrawLists(*depthSorted.child, visibleMask);
+    }
+}
+
+void MultiViewCullTraversal::apply(const Layer& layer)
+{
+    if ((traversalMask & (overrideMask | layer.mask)) != MASK_OFF && layer.child)
+    {
+        _addToDrawLists(*layer.child, _viewMask);
+    }
+}
+
+void MultiViewCullTraversal::apply(const Switch& sw)
+{
+    for (auto& child : sw.children)
+    {
+        if ((traversalMask & (overrideMask | child.mask)) != MASK_OFF)
+        {
+            child.node->accept(*this);
+        }
+    }
+}
+
+void MultiViewCullTraversal::apply(const RegionOfInterest&)
+{
+    // RegionOfInterest are collected by the main view's RecordTraversal
+}
+
+void MultiViewCullTraversal::apply(const Light&)
+{
+    // lights are collected by the main view's RecordTraversal
+}
+
+void MultiViewCullTraversal::apply(const Joint&)
+{
+    // non op for RiggedJoint as it's designed not to have any renderable children
+}
+
+void MultiViewCullTraversal::apply(const Transform& transform)
+{
+    _modelMatrixStack.push_back(transform.transform(_modelMatrixStack.back()));
+    _modelviewMatricesDirty = true;
+
+    if (transform.subgraphRequiresLocalFrustum)
+    {
+        _pushFrustum();
+        transform.traverse(*this);
+        _popFrustum();
+    }
+    else
+    {
+        transform.traverse(*this);
+    }
+
+    _modelMatrixStack.pop_back();
+    _modelviewMatricesDirty = true;
+}
+
+void MultiViewCullTraversal::apply(const StateGroup& stateGroup)
+{
+    auto begin = stateGroup.stateCommands.begin();
+    auto end = stateGroup.stateCommands.end();
+
+    _state->push(begin, end);
+
+    // just traverse the children, StateGroup::traverse(..) would also visit the stateCommands
+    for (const auto& child : stateGroup.children)
+    {
+        child->accept(*this);
+    }
+
+    _state->pop(begin, end);
+}
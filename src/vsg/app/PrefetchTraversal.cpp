@@ -0,0 +1,249 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/PrefetchTraversal.h>
+#include <vsg/app/View.h>
+#include <vsg/io/DatabasePager.h>
+#include <vsg/maths/transform.h>
+#include <vsg/nodes/CullGroup.h>
+#include <vsg/nodes/CullNode.h>
+#include <vsg/nodes/DepthSorted.h>
+#include <vsg/nodes/LOD.h>
+#include <vsg/nodes/PagedLOD.h>
+#include <vsg/nodes/Switch.h>
+#include <vsg/nodes/Transform.h>
+#include <vsg/ui/FrameStamp.h>
+
+using namespace vsg;
+
+PrefetchTraversal::PrefetchTraversal()
+{
+}
+
+PrefetchTraversal::~PrefetchTraversal()
+{
+}
+
+void PrefetchTraversal::clear()
+{
+    _history.clear();
+}
+
+bool PrefetchTraversal::predict(const dmat4& viewMatrix, dmat4& predictedViewMatrix)
+{
+    Sample sample;
+    sample.time = frameStamp ? frameStamp->time : clock::now();
+    if (!decompose(inverse(viewMatrix), sample.position, sample.rotation, sample.scale))
+    {
+        clear();
+        return false;
+    }
+
+    // replace rather than add samples from the same frame, such as when the View is recorded more than once per frame
+    if (!_history.empty() && _history.back().time == sample.time)
+        _history.back() = sample;
+    else
+        _history.push_back(sample);
+
+    while (_history.size() > std::max(historySize, 2u)) _history.pop_front();
+
+    if (_history.size() < 2) return false;
+
+    const auto& first = _history.front();
+    const auto& last = _history.back();
+
+    double duration = std::chrono::duration<double, std::chrono::seconds::period>(last.time - first.time).count();
+    if (duration <= 0.0) return false;
+
+    double ratio = predictionTime / duration;
+
+    // linearly extrapolate the eye point
+    dvec3 translation = (last.position - first.position) * ratio;
+
+    // extrapolate the rotation from the first to the last sample, taking the shortest path
+    dquat rotation = last.rotation * inverse(first.rotation);
+    if (rotation.w < 0.0) rotation = -rotation;
+
+    double sinHalfAngle = std::sqrt(square(rotation.x) + square(rotation.y) + square(rotation.z));
+    if (length2(translation) == 0.0 && sinHalfAngle == 0.0) return false;
+
+    dquat predictedRotation = last.rotation;
+    if (sinHalfAngle > 0.0)
+    {
+        double angle = std::min(2.0 * std::atan2(sinHalfAngle, rotation.w) * ratio, PI);
+        dvec3 axis(rotation.x / sinHalfAngle, rotation.y / sinHalfAngle, rotation.z / sinHalfAngle);
+        predictedRotation = dquat(angle, axis) * last.rotation;
+    }
+
+    predictedViewMatrix = inverse(translate(last.position + translation) * rotate(predictedRotation) * scale(last.scale));
+    return true;
+}
+
+void PrefetchTraversal::prefetch(const View& view)
+{
+    if (!view.camera || !databasePager) return;
+
+    dmat4 predictedViewMatrix;
+    if (!predict(view.camera->viewMatrix->transform(), predictedViewMatrix)) return;
+
+    // predicted requests would just be rejected while the DatabasePager is throttling requests
+    if (databasePager->throttled()) return;
+
+    _projectionMatrix = view.camera->projectionMatrix->transform();
+    _viewMatrix = predictedViewMatrix;
+    _projected = Frustum(Frustum(), _projectionMatrix);
+
+    _modelMatrixStack.assign(1, dmat4());
+    _frustumStack.clear();
+    _pushFrustum();
+
+    view.traverse(*this);
+
+    _frustumStack.clear();
+}
+
+void PrefetchTraversal::_pushFrustum()
+{
+    auto modelview = _viewMatrix * _modelMatrixStack.back();
+
+    _frustumStack.emplace_back(_projected, modelview);
+    _frustumStack.back().computeLodScale(_projectionMatrix, modelview);
+}
+
+double PrefetchTraversal::_lodDistance(const dsphere& s) const
+{
+    const auto& lodScale = _frustumStack.back().lodScale;
+    return std::abs(lodScale[0] * s.x + lodScale[1] * s.y + lodScale[2] * s.z + lodScale[3]);
+}
+
+void PrefetchTraversal::apply(const Node& node)
+{
+    node.traverse(*this);
+}
+
+void PrefetchTraversal::apply(const LOD& lod)
+{
+    const auto& sphere = lod.bound;
+    if (!_frustumStack.back().intersect(sphere)) return;
+
+    auto lodDistance = _lodDistance(sphere);
+    for (auto& child : lod.children)
+    {
+        auto cutoff = lodDistance * child.minimumScreenHeightRatio;
+        bool child_visible = sphere.r > cutoff;
+        if (child_visible)
+        {
+            child.node->accept(*this);
+            return;
+        }
+    }
+}
+
+void PrefetchTraversal::apply(const PagedLOD& plod)
+{
+    const auto& sphere = plod.bound;
+    if (!_frustumStack.back().intersect(sphere)) return;
+
+    auto frameCount = frameStamp ? frameStamp->frameCount : 0;
+    auto lodDistance = _lodDistance(sphere);
+
+    // check the high res child to see if it's visible from the predicted viewpoint
+    {
+        const auto& child = plod.children[0];
+
+        auto cutoff = lodDistance * child.minimumScreenHeightRatio;
+        bool child_visible = sphere.r > cutoff;
+        if (child_visible)
+        {
+            plod.frameHighResPredicted.exchange(frameCount);
+
+            if (child.node)
+            {
+                child.node->accept(*this);
+                return;
+            }
+
+            // requests for visible PagedLOD have a priority of sphere.r / cutoff, which is greater than 1.0, so map predicted requests into the 0.0 to 1.0 range
+            databasePager->requestHighRes(plod, 1.0 - cutoff / sphere.r, true);
+        }
+    }
+
+    // check the low res child to see if it's visible
+    {
+        const auto& child = plod.children[1];
+        auto cutoff = lodDistance * child.minimumScreenHeightRatio;
+        bool child_visible = sphere.r > cutoff;
+        if (child_visible && child.node)
+        {
+            child.node->accept(*this);
+        }
+    }
+}
+
+void PrefetchTraversal::apply(const CullGroup& cullGroup)
+{
+    if (_frustumStack.back().intersect(cullGroup.bound))
+    {
+        cullGroup.traverse(*this);
+    }
+}
+
+void PrefetchTraversal::apply(const CullNode& cullNode)
+{
+    if (cullNode.child && _frustumStack.back().intersect(cullNode.bound))
+    {
+        cullNode.child->accept(*this);
+    }
+}
+
+void PrefetchTraversal::apply(const DepthSorted& depthSorted)
+{
+    if (depthSorted.child && _frustumStack.back().intersect(depthSorted.bound))
+    {
+        depthSorted.child->accept(*this);
+    }
+}
+
+void PrefetchTraversal::apply(const Switch& sw)
+{
+    for (auto& child : sw.children)
+    {
+        if ((traversalMask & (overrideMask | child.mask)) != MASK_OFF)
+        {
+            child.node->accept(*this);
+        }
+    }
+}
+
+void PrefetchTraversal::apply(const Transform& transform)
+{
+    _modelMatrixStack.push_back(transform.transform(_modelMatrixStack.back()));
+
+    if (transform.subgraphRequiresLocalFrustum)
+    {
+        _pushFrustum();
+        transform.traverse(*this);
+        _popFrustum();
+    }
+    else
+    {
+        transform.traverse(*this);
+    }
+
+    _modelMatrixStack.pop_back();
+}
+
+void PrefetchTraversal::apply(const Command&)
+{
+    // commands, including Geometry and StateCommands, don't contain PagedLOD so there is no need to traverse them
+}
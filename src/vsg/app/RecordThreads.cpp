@@ -0,0 +1,359 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/RecordThreads.h>
+#include <vsg/app/RecordTraversal.h>
+#include <vsg/app/View.h>
+#include <vsg/io/DatabasePager.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/state/ViewDependentState.h>
+#include <vsg/ui/FrameStamp.h>
+#include <vsg/utils/Instrumentation.h>
+#include <vsg/vk/CommandPool.h>
+#include <vsg/vk/State.h>
+
+#include <functional>
+
+using namespace vsg;
+
+namespace vsg
+{
+    struct RecordWorkerOperation : public Operation
+    {
+        RecordWorkerOperation(std::function<void()> in_function, ref_ptr<Latch> in_latch) :
+            function(in_function),
+            latch(in_latch) {}
+
+        void run() override
+        {
+            function();
+            latch->count_down();
+        }
+
+        std::function<void()> function;
+        ref_ptr<Latch> latch;
+    };
+
+    static ref_ptr<CommandBuffer> acquireSecondaryCommandBuffer(CommandBuffers& commandBuffers, CommandBuffer& primary)
+    {
+        ref_ptr<CommandBuffer> commandBuffer;
+        for (auto& cb : commandBuffers)
+        {
+            if (cb->numDependentSubmissions() == 0)
+            {
+                commandBuffer = cb;
+                break;
+            }
+        }
+
+        if (!commandBuffer)
+        {
+            auto commandPool = CommandPool::create(primary.getDevice(), primary.getCommandPool()->queueFamilyIndex);
+            commandBuffer = commandPool->allocate(VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+            commandBuffers.push_back(commandBuffer);
+        }
+        else
+        {
+            commandBuffer->reset();
+        }
+
+        commandBuffer->numDependentSubmissions().fetch_add(1);
+
+        // pass on the per View settings used by commands when recording
+        commandBuffer->traversalMask = primary.traversalMask;
+        commandBuffer->overrideMask = primary.overrideMask;
+        commandBuffer->viewID = primary.viewID;
+        commandBuffer->viewDependentState = primary.viewDependentState;
+        commandBuffer->instanceNode = nullptr;
+
+        return commandBuffer;
+    }
+
+    static void beginSecondaryCommandBuffer(CommandBuffer& commandBuffer, const State& state)
+    {
+        VkCommandBufferInheritanceInfo inheritanceInfo = {};
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.pNext = nullptr;
+        inheritanceInfo.renderPass = state.renderPass;
+        inheritanceInfo.subpass = state.subpass;
+        inheritanceInfo.framebuffer = state.framebuffer;
+        inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+        inheritanceInfo.queryFlags = 0;
+        inheritanceInfo.pipelineStatistics = 0;
+
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    }
+} // namespace vsg
+
+RecordThreads::RecordThreads(uint32_t numThreads) :
+    numWorkers(numThreads + 1)
+{
+    if (numThreads > 0) operationThreads = OperationThreads::create(numThreads);
+}
+
+RecordThreads::RecordThreads(ref_ptr<OperationThreads> in_operationThreads, uint32_t in_numWorkers) :
+    operationThreads(in_operationThreads),
+    numWorkers(in_numWorkers)
+{
+}
+
+RecordThreads::~RecordThreads()
+{
+}
+
+bool RecordThreads::record(RecordTraversal& rt, const View& view)
+{
+    auto state = rt.getState();
+    ref_ptr<CommandBuffer> primary = state->_commandBuffer;
+
+    // secondary command buffers can only be executed within a render pass/subpass set up for them.
+    if (!primary || primary->level() != VK_COMMAND_BUFFER_LEVEL_PRIMARY || !rt.recordedCommandBuffers) return false;
+    if (state->renderPass == VK_NULL_HANDLE || state->subpassContents != VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS) return false;
+
+    CPU_INSTRUMENTATION_L1_NC(rt.instrumentation, "RecordThreads record", COLOR_RECORD_L1);
+
+    _collectWorkItems(view);
+
+    size_t numActiveWorkers = std::min(static_cast<size_t>(std::max(numWorkers, 1u)), _workItems.size());
+    if (_workers.size() < numActiveWorkers) _workers.resize(numActiveWorkers);
+
+    // distribute contiguous ranges of work items so that merging the workers in order preserves the serial traversal order
+    for (size_t i = 0; i < numActiveWorkers; ++i)
+    {
+        auto& worker = _workers[i];
+        worker.begin = (i * _workItems.size()) / numActiveWorkers;
+        worker.end = ((i + 1) * _workItems.size()) / numActiveWorkers;
+        _setUpWorker(worker, rt, view);
+    }
+
+    if (operationThreads && numActiveWorkers > 1)
+    {
+        // use latch to synchronize this thread with the record threads
+        auto latch = Latch::create(static_cast<int>(numActiveWorkers));
+
+        for (size_t i = 0; i < numActiveWorkers; ++i)
+        {
+            auto worker = &_workers[i];
+            operationThreads->add(ref_ptr<Operation>(new RecordWorkerOperation([this, worker]() { _recordWorker(*worker); }, latch)));
+        }
+
+        // use this thread to record work items as well
+        operationThreads->run();
+
+        // wait till all the record operations have completed
+        latch->wait();
+    }
+    else
+    {
+        for (size_t i = 0; i < numActiveWorkers; ++i)
+        {
+            _recordWorker(_workers[i]);
+        }
+    }
+
+    std::vector<VkCommandBuffer> vk_commandBuffers;
+    vk_commandBuffers.reserve(numActiveWorkers);
+    for (size_t i = 0; i < numActiveWorkers; ++i)
+    {
+        auto& worker = _workers[i];
+        _mergeWorker(worker, rt);
+        vk_commandBuffers.push_back(*worker.commandBuffer);
+    }
+
+    if (!vk_commandBuffers.empty())
+    {
+        vkCmdExecuteCommands(*primary, static_cast<uint32_t>(vk_commandBuffers.size()), vk_commandBuffers.data());
+    }
+
+    return true;
+}
+
+void RecordThreads::recordBins(RecordTraversal& rt, const View& view)
+{
+    if (view.bins.empty()) return;
+
+    CPU_INSTRUMENTATION_L1_NC(rt.instrumentation, "RecordThreads recordBins", COLOR_RECORD_L1);
+
+    auto state = rt.getState();
+    ref_ptr<CommandBuffer> primary = state->_commandBuffer;
+
+    auto commandBuffer = acquireSecondaryCommandBuffer(_binCommandBuffers, *primary);
+    commandBuffer->state = state;
+
+    // redirect the State to the secondary command buffer, dirtying all state so it's applied afresh.
+    state->_commandBuffer = commandBuffer;
+    state->dirtyStateStacks();
+    state->activeMaxStateSlot = state->maxSlots.max();
+    state->projectionMatrixStack.dirty = true;
+    state->modelviewMatrixStack.dirty = true;
+    state->dirty = true;
+
+    beginSecondaryCommandBuffer(*commandBuffer, *state);
+
+    for (auto& bin : view.bins)
+    {
+        bin->accept(rt);
+    }
+
+    vkEndCommandBuffer(*commandBuffer);
+
+    state->_commandBuffer = primary;
+    state->dirtyStateStacks();
+    state->dirty = true;
+
+    rt.recordedCommandBuffers->add(0, commandBuffer);
+
+    VkCommandBuffer vk_commandBuffer = *commandBuffer;
+    vkCmdExecuteCommands(*primary, 1, &vk_commandBuffer);
+}
+
+void RecordThreads::_collectWorkItems(const View& view)
+{
+    _workItems.clear();
+    for (auto& child : view.children)
+    {
+        _workItems.push_back(child.get());
+    }
+
+    // plain Group nodes have no state or culling of their own so can be expanded into their children
+    // till there are enough work items to balance the load across the workers.
+    size_t targetNumWorkItems = static_cast<size_t>(numWorkers) * workItemsPerWorker;
+    std::vector<const Node*> expandedWorkItems;
+    bool groupsExpanded = true;
+    while (groupsExpanded && _workItems.size() < targetNumWorkItems)
+    {
+        groupsExpanded = false;
+        expandedWorkItems.clear();
+        for (auto node : _workItems)
+        {
+            if (node->type_info() == typeid(Group))
+            {
+                for (auto& child : static_cast<const Group*>(node)->children)
+                {
+                    expandedWorkItems.push_back(child.get());
+                }
+                groupsExpanded = true;
+            }
+            else
+            {
+                expandedWorkItems.push_back(node);
+            }
+        }
+        _workItems.swap(expandedWorkItems);
+    }
+}
+
+void RecordThreads::_setUpWorker(Worker& worker, RecordTraversal& rt, const View& view)
+{
+    auto state = rt.getState();
+
+    if (!worker.recordTraversal)
+    {
+        worker.recordTraversal = RecordTraversal::create(state->maxSlots);
+        worker.viewDependentState = ViewDependentState::create(const_cast<View*>(&view));
+        worker.culledPagedLODs = CulledPagedLODs::create();
+    }
+
+    auto& wrt = *worker.recordTraversal;
+    wrt.traversalMask = rt.traversalMask;
+    wrt.overrideMask = rt.overrideMask;
+    if (rt.instrumentation && !wrt.instrumentation) wrt.instrumentation = shareOrDuplicateForThreadSafety(rt.instrumentation);
+    wrt.recordedCommandBuffers = rt.recordedCommandBuffers;
+    wrt.regionsOfInterest.clear();
+    wrt._frameStamp = rt._frameStamp;
+    wrt._databasePager = rt._databasePager;
+
+    // each worker collects culled/required PagedLOD into its own container, merged after recording
+    worker.culledPagedLODs->clear();
+    wrt._culledPagedLODs = rt._culledPagedLODs ? worker.culledPagedLODs : ref_ptr<CulledPagedLODs>();
+
+    // each worker collects positional state into its own ViewDependentState, merged after recording
+    worker.viewDependentState->view = rt._viewDependentState ? rt._viewDependentState->view : const_cast<View*>(&view);
+    worker.viewDependentState->clear();
+    wrt._viewDependentState = rt._viewDependentState ? worker.viewDependentState : ref_ptr<ViewDependentState>();
+
+    // mirror the View's Bins so that each worker can fill its own
+    wrt._minimumBinNumber = rt._minimumBinNumber;
+    wrt._bins.resize(rt._bins.size());
+    for (size_t i = 0; i < rt._bins.size(); ++i)
+    {
+        auto& bin = rt._bins[i];
+        auto& worker_bin = wrt._bins[i];
+        if (!bin)
+            worker_bin = {};
+        else if (!worker_bin || worker_bin->binNumber != bin->binNumber || worker_bin->sortOrder != bin->sortOrder)
+            worker_bin = Bin::create(bin->binNumber, bin->sortOrder);
+        else
+            worker_bin->clear();
+    }
+
+    // command buffers are allocated and reset on this thread, the worker thread just records to them.
+    worker.commandBuffer = acquireSecondaryCommandBuffer(worker.commandBuffers, *state->_commandBuffer);
+
+    wrt._state->connect(worker.commandBuffer);
+    wrt._state->inherit(*state);
+}
+
+void RecordThreads::_recordWorker(Worker& worker)
+{
+    auto& wrt = *worker.recordTraversal;
+
+    CPU_INSTRUMENTATION_L1_NC(wrt.instrumentation, "RecordThreads worker", COLOR_RECORD_L1);
+
+    beginSecondaryCommandBuffer(*worker.commandBuffer, *wrt._state);
+
+    for (size_t i = worker.begin; i < worker.end; ++i)
+    {
+        _workItems[i]->accept(wrt);
+    }
+
+    vkEndCommandBuffer(*worker.commandBuffer);
+}
+
+void RecordThreads::_mergeWorker(Worker& worker, RecordTraversal& rt)
+{
+    auto& wrt = *worker.recordTraversal;
+
+    // merge the Bin contents prior to the Bins being sorted
+    for (size_t i = 0; i < rt._bins.size(); ++i)
+    {
+        if (rt._bins[i] && wrt._bins[i]) rt._bins[i]->add(*wrt._bins[i]);
+    }
+
+    if (rt._viewDependentState)
+    {
+        auto& src = *worker.viewDependentState;
+        auto& dest = *rt._viewDependentState;
+        dest.ambientLights.insert(dest.ambientLights.end(), src.ambientLights.begin(), src.ambientLights.end());
+        dest.directionalLights.insert(dest.directionalLights.end(), src.directionalLights.begin(), src.directionalLights.end());
+        dest.pointLights.insert(dest.pointLights.end(), src.pointLights.begin(), src.pointLights.end());
+        dest.spotLights.insert(dest.spotLights.end(), src.spotLights.begin(), src.spotLights.end());
+    }
+
+    rt.regionsOfInterest.insert(rt.regionsOfInterest.end(), wrt.regionsOfInterest.begin(), wrt.regionsOfInterest.end());
+
+    if (rt._culledPagedLODs)
+    {
+        auto& src = *worker.culledPagedLODs;
+        auto& dest = *rt._culledPagedLODs;
+        dest.highresCulled.insert(dest.highresCulled.end(), src.highresCulled.begin(), src.highresCulled.end());
+        dest.newHighresRequired.insert(dest.newHighresRequired.end(), src.newHighresRequired.begin(), src.newHighresRequired.end());
+    }
+
+    // the fence associated with the submission tracks when the secondary command buffer can be reused
+    rt.recordedCommandBuffers->add(0, worker.commandBuffer);
+}
@@ -12,6 +12,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/animation/Animation.h>
 #include <vsg/app/CommandGraph.h>
+#include <vsg/app/PrefetchTraversal.h>
+#include <vsg/app/RecordThreads.h>
 #include <vsg/app/RecordTraversal.h>
 #include <vsg/app/View.h>
 #include <vsg/commands/Command.h>
@@ -25,6 +27,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/lighting/PointLight.h>
 #include <vsg/lighting/SpotLight.h>
 #include <vsg/maths/plane.h>
+#include <vsg/nodes/BakedSubgraph.h>
 #include <vsg/nodes/Bin.h>
 #include <vsg/nodes/CoordinateFrame.h>
 #include <vsg/nodes/CullGroup.h>
@@ -57,6 +60,18 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 using namespace vsg;
 
+namespace
+{
+    // record the command to the VkCommandBuffer, or append it to the CommandBuffer's CommandStream when one is assigned.
+    inline void recordCommand(CommandBuffer& commandBuffer, const Command& command)
+    {
+        if (commandBuffer.commandStream)
+            commandBuffer.commandStream->add(commandBuffer, command);
+        else
+            command.record(commandBuffer);
+    }
+} // namespace
+
 #define INLINE_TRAVERSE 0
 
 RecordTraversal::RecordTraversal(const Slots& in_maxSlots, const std::set<Bin*>& in_bins) :
@@ -131,6 +146,12 @@ void RecordTraversal::apply(const Group& group)
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "Group", COLOR_RECORD_L2, &group);
 
     //debug("Visiting Group");
+    if (batchCulling && group.children.size() > 1)
+    {
+        _traverseBatchCulled(group.children.data(), group.children.size());
+        return;
+    }
+
 #if INLINE_TRAVERSE
     vsg::Group::t_traverse(group, *this);
 #else
@@ -143,6 +164,12 @@ void RecordTraversal::apply(const QuadGroup& quadGroup)
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "QuadGroup", COLOR_RECORD_L2, &quadGroup);
 
     //debug("Visiting QuadGroup");
+    if (batchCulling)
+    {
+        _traverseBatchCulled(quadGroup.children.data(), quadGroup.children.size());
+        return;
+    }
+
 #if INLINE_TRAVERSE
     vsg::QuadGroup::t_traverse(quadGroup, *this);
 #else
@@ -150,6 +177,78 @@ void RecordTraversal::apply(const QuadGroup& quadGroup)
 #endif
 }
 
+void RecordTraversal::_traverseBatchCulled(const ref_ptr<Node>* children, size_t numChildren)
+{
+    constexpr size_t batchSize = 8;
+
+    dsphere bounds[batchSize];
+    uint8_t visible[batchSize];
+    int boundIndices[batchSize];
+    bool pagedLOD[batchSize];
+
+    for (size_t first = 0; first < numChildren; first += batchSize)
+    {
+        size_t count = std::min(batchSize, numChildren - first);
+
+        // gather the bounding spheres of the children that cull against the view frustum
+        size_t numBounds = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Node* child = children[first + i].get();
+            const auto& type = child->type_info();
+
+            const dsphere* bound = nullptr;
+            pagedLOD[i] = false;
+            if (type == typeid(CullGroup))
+                bound = &static_cast<const CullGroup*>(child)->bound;
+            else if (type == typeid(CullNode))
+                bound = &static_cast<const CullNode*>(child)->bound;
+            else if (type == typeid(LOD))
+                bound = &static_cast<const LOD*>(child)->bound;
+            else if (type == typeid(DepthSorted))
+                bound = &static_cast<const DepthSorted*>(child)->bound;
+            else if (type == typeid(PagedLOD))
+            {
+                bound = &static_cast<const PagedLOD*>(child)->bound;
+                pagedLOD[i] = true;
+            }
+
+            if (bound)
+            {
+                boundIndices[i] = static_cast<int>(numBounds);
+                bounds[numBounds++] = *bound;
+            }
+            else
+            {
+                boundIndices[i] = -1;
+            }
+        }
+
+        if (numBounds > 0) _state->intersect(bounds, numBounds, visible);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Node* child = children[first + i].get();
+            int boundIndex = boundIndices[i];
+            if (boundIndex < 0)
+            {
+                child->accept(*this);
+            }
+            else if (visible[boundIndex])
+            {
+                _batchVisibleNode = child;
+                child->accept(*this);
+                _batchVisibleNode = nullptr;
+            }
+            else if (pagedLOD[i])
+            {
+                // culled PagedLOD still need to be visited so they are recorded as culled for the DatabasePager
+                child->accept(*this);
+            }
+        }
+    }
+}
+
 void RecordTraversal::apply(const LOD& lod)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "LOD", COLOR_RECORD_L2, &lod);
@@ -157,7 +256,7 @@ void RecordTraversal::apply(const LOD& lod)
     const auto& sphere = lod.bound;
 
     // check if lod bounding sphere is in view frustum.
-    auto lodDistance = _state->lodDistance(sphere);
+    auto lodDistance = _passedBatchCulling(&lod) ? _state->lodDistanceInFrustum(sphere) : _state->lodDistance(sphere);
     if (lodDistance < 0.0)
     {
         return;
@@ -183,7 +282,7 @@ void RecordTraversal::apply(const PagedLOD& plod)
     auto frameCount = _frameStamp->frameCount;
 
     // check if lod bounding sphere is in view frustum.
-    auto lodDistance = _state->lodDistance(sphere);
+    auto lodDistance = _passedBatchCulling(&plod) ? _state->lodDistanceInFrustum(sphere) : _state->lodDistance(sphere);
     if (lodDistance < 0.0)
     {
         if ((frameCount - plod.frameHighResLastUsed) > 1 && _culledPagedLODs)
@@ -216,19 +315,7 @@ void RecordTraversal::apply(const PagedLOD& plod)
             }
             else if (_databasePager)
             {
-                auto priority = sphere.r / cutoff;
-                exchange_if_greater(plod.priority, priority);
-
-                auto previousRequestCount = plod.requestCount.fetch_add(1);
-                if (previousRequestCount == 0)
-                {
-                    // we are the first request so tell the databasePager about it
-                    _databasePager->request(ref_ptr<PagedLOD>(const_cast<PagedLOD*>(&plod)));
-                }
-                else
-                {
-                    //debug("repeat request ",&plod,", ",plod.filename,", ",plod.requestCount.load(),", plod.requestStatus = ",plod.requestStatus.load());
-                }
+                _databasePager->requestHighRes(plod, sphere.r / cutoff);
             }
         }
         else
@@ -266,7 +353,7 @@ void RecordTraversal::apply(const CullGroup& cullGroup)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "CullGroup", COLOR_RECORD_L2, &cullGroup);
 
-    if (_state->intersect(cullGroup.bound))
+    if (_passedBatchCulling(&cullGroup) || _state->intersect(cullGroup.bound))
     {
         // debug("Passed node");
         cullGroup.traverse(*this);
@@ -277,7 +364,7 @@ void RecordTraversal::apply(const CullNode& cullNode)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "CullNode", COLOR_RECORD_L2, &cullNode);
 
-    if (_state->intersect(cullNode.bound))
+    if (_passedBatchCulling(&cullNode) || _state->intersect(cullNode.bound))
     {
         //debug("Passed node");
         cullNode.traverse(*this);
@@ -304,11 +391,91 @@ void RecordTraversal::apply(const RegionOfInterest& roi)
     regionsOfInterest.emplace_back(_state->modelviewMatrixStack.top(), &roi);
 }
 
+void RecordTraversal::apply(const BakedSubgraph& bakedSubgraph)
+{
+    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "BakedSubgraph", COLOR_RECORD_L2, &bakedSubgraph);
+
+    if (bakedSubgraph.instructions.empty())
+    {
+        // nothing baked, or the instructions failed BakedSubgraph::validate() when read, so fall back to the original subgraph
+        bakedSubgraph.traverse(*this);
+        return;
+    }
+
+    // cull all the bounds in one batch, the bounds are in the coordinate frame of the BakedSubgraph so are tested against the current frustum
+    size_t visibleOffset = _bakedVisible.size();
+    size_t numBounds = bakedSubgraph.bounds.size();
+    _bakedVisible.resize(visibleOffset + numBounds);
+    if (numBounds > 0) _state->intersect(bakedSubgraph.bounds.data(), numBounds, _bakedVisible.data() + visibleOffset);
+
+    const uint8_t* visible = _bakedVisible.data() + visibleOffset;
+    const dmat4 modelview = _state->modelviewMatrixStack.top();
+
+    const auto* instructions = bakedSubgraph.instructions.data();
+    size_t numInstructions = bakedSubgraph.instructions.size();
+    for (size_t i = 0; i < numInstructions; ++i)
+    {
+        const auto& instruction = instructions[i];
+        switch (instruction.opcode)
+        {
+        case (BakedSubgraph::CULL):
+            if (!visible[instruction.first]) i += instruction.count;
+            break;
+        case (BakedSubgraph::PUSH_MATRIX):
+            _state->modelviewMatrixStack.push(modelview * bakedSubgraph.matrices[instruction.first]);
+            _state->dirty = true;
+            break;
+        case (BakedSubgraph::PUSH_MATRIX_AND_FRUSTUM):
+            _state->modelviewMatrixStack.push(modelview * bakedSubgraph.matrices[instruction.first]);
+            _state->pushFrustum();
+            _state->dirty = true;
+            break;
+        case (BakedSubgraph::POP_MATRIX):
+            _state->modelviewMatrixStack.pop();
+            _state->dirty = true;
+            break;
+        case (BakedSubgraph::POP_MATRIX_AND_FRUSTUM):
+            _state->popFrustum();
+            _state->modelviewMatrixStack.pop();
+            _state->dirty = true;
+            break;
+        case (BakedSubgraph::PUSH_STATE): {
+            auto begin = bakedSubgraph.stateCommands.begin() + instruction.first;
+            _state->push(begin, begin + instruction.count);
+            break;
+        }
+        case (BakedSubgraph::POP_STATE): {
+            auto begin = bakedSubgraph.stateCommands.begin() + instruction.first;
+            _state->pop(begin, begin + instruction.count);
+            break;
+        }
+        case (BakedSubgraph::DRAW): {
+            _state->record();
+            auto& commandBuffer = *(_state->_commandBuffer);
+            const auto* commands = bakedSubgraph.commands.data() + instruction.first;
+            for (uint32_t c = 0; c < instruction.count; ++c)
+            {
+                recordCommand(commandBuffer, *commands[c]);
+            }
+            break;
+        }
+        case (BakedSubgraph::NODE):
+            bakedSubgraph.nodes[instruction.first]->accept(*this);
+
+            // nested BakedSubgraph may have reallocated _bakedVisible
+            visible = _bakedVisible.data() + visibleOffset;
+            break;
+        }
+    }
+
+    _bakedVisible.resize(visibleOffset);
+}
+
 void RecordTraversal::apply(const DepthSorted& depthSorted)
 {
     CPU_INSTRUMENTATION_L2_NCO(instrumentation, "DepthSorted", COLOR_RECORD_L2, &depthSorted);
 
-    if (_state->intersect(depthSorted.bound))
+    if (_passedBatchCulling(&depthSorted) || _state->intersect(depthSorted.bound))
     {
         const auto& mv = _state->modelviewMatrixStack.top();
         const auto& center = depthSorted.bound.center;
@@ -333,7 +500,7 @@ void RecordTraversal::apply(const VertexDraw& vd)
 
     //debug("Visiting VertexDraw");
     _state->record();
-    vd.record(*(_state->_commandBuffer));
+    recordCommand(*(_state->_commandBuffer), vd);
 }
 
 void RecordTraversal::apply(const VertexIndexDraw& vid)
@@ -342,7 +509,7 @@ void RecordTraversal::apply(const VertexIndexDraw& vid)
 
     //debug("Visiting VertexIndexDraw");
     _state->record();
-    vid.record(*(_state->_commandBuffer));
+    recordCommand(*(_state->_commandBuffer), vid);
 }
 
 void RecordTraversal::apply(const Geometry& geometry)
@@ -351,7 +518,7 @@ void RecordTraversal::apply(const Geometry& geometry)
 
     //debug("Visiting Geometry");
     _state->record();
-    geometry.record(*(_state->_commandBuffer));
+    recordCommand(*(_state->_commandBuffer), geometry);
 }
 
 void RecordTraversal::apply(const Light&)
@@ -484,7 +651,21 @@ void RecordTraversal::apply(const InstanceNode& instanceNode)
 {
     CPU_INSTRUMENTATION_L2(instrumentation);
 
-    if (instanceNode.child)
+    if (instanceNode.culling && instanceNode.culling->cullView(_state->_commandBuffer->viewID, _state->inheritViewForLODScaling))
+    {
+        // draw just the visible instances, using the compacted arrays of each LOD level
+        instanceNode.culling->cull(instanceNode, *_state);
+
+        for (auto& culledInstanceNode : instanceNode.culling->culledInstanceNodes)
+        {
+            if (culledInstanceNode->instanceCount > 0 && culledInstanceNode->child)
+            {
+                _state->_commandBuffer->instanceNode = culledInstanceNode;
+                culledInstanceNode->child->accept(*this);
+            }
+        }
+    }
+    else if (instanceNode.child)
     {
         _state->_commandBuffer->instanceNode = &instanceNode;
         instanceNode.child->accept(*this);
@@ -496,7 +677,7 @@ void RecordTraversal::apply(const InstanceDraw& instanceDraw)
     CPU_INSTRUMENTATION_L2(instrumentation);
 
     _state->record();
-    instanceDraw.record(*(_state->_commandBuffer));
+    recordCommand(*(_state->_commandBuffer), instanceDraw);
 }
 
 void RecordTraversal::apply(const InstanceDrawIndexed& instanceDrawIndexed)
@@ -504,7 +685,7 @@ void RecordTraversal::apply(const InstanceDrawIndexed& instanceDrawIndexed)
     CPU_INSTRUMENTATION_L2(instrumentation);
 
     _state->record();
-    instanceDrawIndexed.record(*(_state->_commandBuffer));
+    recordCommand(*(_state->_commandBuffer), instanceDrawIndexed);
 }
 
 // Vulkan nodes
@@ -531,7 +712,7 @@ void RecordTraversal::apply(const Commands& commands)
     _state->record();
     for (auto& command : commands.children)
     {
-        command->record(*(_state->_commandBuffer));
+        recordCommand(*(_state->_commandBuffer), *command);
     }
 }
 
@@ -541,7 +722,7 @@ void RecordTraversal::apply(const Command& command)
 
     //debug("Visiting Command");
     _state->record();
-    command.record(*(_state->_commandBuffer));
+    recordCommand(*(_state->_commandBuffer), command);
 }
 
 void RecordTraversal::apply(const Bin& bin)
@@ -628,24 +809,29 @@ void RecordTraversal::apply(const View& view)
                     }
                 }
             }
-
-            view.traverse(*this);
-        }
-        else
-        {
-            view.traverse(*this);
         }
     }
-    else
+
+    // if enabled and supported by the current subpass record the View's subgraph in parallel to secondary command buffers
+    // secondary command buffers can't be captured by a CommandStream so fallback to recording in the current thread
+    bool recordedInParallel = view.recordThreads && !_state->_commandBuffer->commandStream && view.recordThreads->record(*this, view);
+    if (!recordedInParallel)
     {
         view.traverse(*this);
     }
 
     _state->popView(view);
 
-    for (auto& bin : view.bins)
+    if (recordedInParallel)
     {
-        bin->accept(*this);
+        view.recordThreads->recordBins(*this, view);
+    }
+    else
+    {
+        for (auto& bin : view.bins)
+        {
+            bin->accept(*this);
+        }
     }
 
     if (_viewDependentState)
@@ -653,6 +839,17 @@ void RecordTraversal::apply(const View& view)
         _viewDependentState->traverse(*this);
     }
 
+    // request the PagedLOD that will be required at the predicted viewpoint, after the visible PagedLOD have been requested so they are queued first
+    if (view.prefetchTraversal && _databasePager)
+    {
+        auto& prefetchTraversal = view.prefetchTraversal;
+        prefetchTraversal->traversalMask = traversalMask;
+        prefetchTraversal->overrideMask = overrideMask;
+        prefetchTraversal->frameStamp = _frameStamp;
+        prefetchTraversal->databasePager = _databasePager;
+        prefetchTraversal->prefetch(view);
+    }
+
     // swap back previous bin setup.
     _minimumBinNumber = cached_minimumBinNumber;
     cached_bins.swap(_bins);
@@ -106,6 +106,13 @@ void RenderGraph::accept(RecordTraversal& recordTraversal) const
 {
     GPU_INSTRUMENTATION_L1_NC(recordTraversal.instrumentation, *recordTraversal.getCommandBuffer(), "RenderGraph", COLOR_RECORD_L1);
 
+    if (recordTraversal.getCommandBuffer()->commandStream)
+    {
+        // render passes aren't captured by a CommandStream, so just record the subgraph to the stream
+        traverse(recordTraversal);
+        return;
+    }
+
     auto extent = getExtent();
     if (previous_extent.width == invalid_dimension || previous_extent.height == invalid_dimension || !windowResizeHandler)
     {
@@ -144,9 +151,14 @@ void RenderGraph::accept(RecordTraversal& recordTraversal) const
     renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
     renderPassInfo.pClearValues = clearValues.data();
 
-    recordTraversal.getState()->viewportStateHint = viewportStateHint;
+    auto state = recordTraversal.getState();
+    state->viewportStateHint = viewportStateHint;
+    state->renderPass = renderPassInfo.renderPass;
+    state->framebuffer = renderPassInfo.framebuffer;
+    state->subpass = 0;
+    state->subpassContents = contents;
 
-    VkCommandBuffer vk_commandBuffer = *(recordTraversal.getState()->_commandBuffer);
+    VkCommandBuffer vk_commandBuffer = *(state->_commandBuffer);
     vkCmdBeginRenderPass(vk_commandBuffer, &renderPassInfo, contents);
 
     // sync the viewportState and push
@@ -154,12 +166,12 @@ void RenderGraph::accept(RecordTraversal& recordTraversal) const
 
     if ((viewportStateHint & DYNAMIC_VIEWPORTSTATE))
     {
-        recordTraversal.getState()->pushView(viewportState);
+        state->pushView(viewportState);
 
         // traverse the subgraph to place commands into the command buffer.
         traverse(recordTraversal);
 
-        recordTraversal.getState()->popView(viewportState);
+        state->popView(viewportState);
     }
     else
     {
@@ -168,6 +180,10 @@ void RenderGraph::accept(RecordTraversal& recordTraversal) const
     }
 
     vkCmdEndRenderPass(vk_commandBuffer);
+
+    state->renderPass = VK_NULL_HANDLE;
+    state->framebuffer = VK_NULL_HANDLE;
+    state->subpassContents = VK_SUBPASS_CONTENTS_INLINE;
 }
 
 void RenderGraph::resized()
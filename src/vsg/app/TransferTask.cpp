@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/View.h>
 #include <vsg/io/Logger.h>
 #include <vsg/ui/ApplicationEvent.h>
+#include <vsg/utils/FormatConversion.h>
 #include <vsg/utils/Instrumentation.h>
 #include <vsg/vk/State.h>
 
@@ -113,8 +114,7 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
     VkDeviceSize alignment = 4;
 
     copyRegions.clear();
-    copyRegions.resize(dataToCopy.dataTotalRegions);
-    VkBufferCopy* pRegions = copyRegions.data();
+    copyRegions.reserve(dataToCopy.dataTotalRegions);
 
     log(level, "  TransferTask::_transferBufferInfos(..) ", this);
 
@@ -123,7 +123,7 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
     {
         auto& bufferInfos = buffer_itr->second;
 
-        uint32_t regionCount = 0;
+        size_t firstRegion = copyRegions.size();
         log(level, "    copying bufferInfos.size() = ", bufferInfos.size(), "{");
         for (auto bufferInfo_itr = bufferInfos.begin(); bufferInfo_itr != bufferInfos.end();)
         {
@@ -135,19 +135,40 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
             }
             else
             {
+                ModifiedCount previousModifiedCount = bufferInfo->copiedModifiedCounts[deviceID];
                 if (bufferInfo->syncModifiedCounts(deviceID))
                 {
-                    // copy data to staging buffer memory
-                    char* ptr = reinterpret_cast<char*>(buffer_data) + offset;
-                    std::memcpy(ptr, bufferInfo->data->dataPointer(), bufferInfo->range);
-
-                    // record region
-                    pRegions[regionCount++] = VkBufferCopy{offset, bufferInfo->offset, bufferInfo->range};
-
-                    log(level, "       copying ", bufferInfo, ", ", bufferInfo->data, " to ", static_cast<void*>(ptr));
-
-                    VkDeviceSize endOfEntry = offset + bufferInfo->range;
-                    offset = (/*alignment == 1 ||*/ (endOfEntry % alignment) == 0) ? endOfEntry : ((endOfEntry / alignment) + 1) * alignment;
+                    const char* source = reinterpret_cast<const char*>(bufferInfo->data->dataPointer());
+                    if (_computeModifiedRanges(*(bufferInfo->data), previousModifiedCount, bufferInfo->range, alignment))
+                    {
+                        // copy just the modified ranges, each range is aligned so the total never exceeds the space reserved for the whole range
+                        for (auto& modifiedRange : _modifiedRanges)
+                        {
+                            char* ptr = reinterpret_cast<char*>(buffer_data) + offset;
+                            std::memcpy(ptr, source + modifiedRange.offset, modifiedRange.size);
+
+                            copyRegions.push_back(VkBufferCopy{offset, bufferInfo->offset + modifiedRange.offset, modifiedRange.size});
+
+                            VkDeviceSize endOfEntry = offset + modifiedRange.size;
+                            offset = ((endOfEntry % alignment) == 0) ? endOfEntry : ((endOfEntry / alignment) + 1) * alignment;
+                        }
+
+                        log(level, "       copying ", _modifiedRanges.size(), " modified ranges of ", bufferInfo, ", ", bufferInfo->data);
+                    }
+                    else
+                    {
+                        // copy data to staging buffer memory
+                        char* ptr = reinterpret_cast<char*>(buffer_data) + offset;
+                        std::memcpy(ptr, source, bufferInfo->range);
+
+                        // record region
+                        copyRegions.push_back(VkBufferCopy{offset, bufferInfo->offset, bufferInfo->range});
+
+                        log(level, "       copying ", bufferInfo, ", ", bufferInfo->data, " to ", static_cast<void*>(ptr));
+
+                        VkDeviceSize endOfEntry = offset + bufferInfo->range;
+                        offset = (/*alignment == 1 ||*/ (endOfEntry % alignment) == 0) ? endOfEntry : ((endOfEntry / alignment) + 1) * alignment;
+                    }
                 }
                 else
                 {
@@ -167,16 +188,15 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
         }
         log(level, "    } bufferInfos.size() = ", bufferInfos.size(), "{");
 
+        uint32_t regionCount = static_cast<uint32_t>(copyRegions.size() - firstRegion);
         if (regionCount > 0)
         {
             auto& buffer = buffer_itr->first;
+            const VkBufferCopy* pRegions = copyRegions.data() + firstRegion;
 
             vkCmdCopyBuffer(vk_commandBuffer, staging->vk(deviceID), buffer->vk(deviceID), regionCount, pRegions);
 
             log(level, "   vkCmdCopyBuffer(", ", ", staging->vk(deviceID), ", ", buffer->vk(deviceID), ", ", regionCount, ", ", pRegions);
-
-            // advance to next buffer
-            pRegions += regionCount;
         }
 
         if (bufferInfos.empty())
@@ -191,6 +211,37 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
     }
 }
 
+bool TransferTask::_computeModifiedRanges(const Data& data, const ModifiedCount& previousModifiedCount, VkDeviceSize range, VkDeviceSize alignment)
+{
+    if (!data.getModifiedRanges(previousModifiedCount, _modifiedRanges) || range == 0) return false;
+
+    // align the ranges to the copy alignment, clamping them to the range and merging any that now overlap
+    size_t numRanges = 0;
+    VkDeviceSize totalSize = 0;
+    for (auto& modifiedRange : _modifiedRanges)
+    {
+        VkDeviceSize begin = (modifiedRange.offset / alignment) * alignment;
+        VkDeviceSize end = std::min(((modifiedRange.offset + modifiedRange.size + alignment - 1) / alignment) * alignment, range);
+        if (begin >= end) continue;
+
+        if (numRanges > 0 && begin <= (_modifiedRanges[numRanges - 1].offset + _modifiedRanges[numRanges - 1].size))
+        {
+            auto& previous = _modifiedRanges[numRanges - 1];
+            totalSize -= previous.size;
+            previous.size = std::max(static_cast<VkDeviceSize>(previous.offset + previous.size), end) - previous.offset;
+            totalSize += previous.size;
+        }
+        else
+        {
+            _modifiedRanges[numRanges++] = ModifiedRange{static_cast<size_t>(begin), static_cast<size_t>(end - begin)};
+            totalSize += (end - begin);
+        }
+    }
+    _modifiedRanges.resize(numRanges);
+
+    return static_cast<double>(totalSize) <= partialTransferThreshold * static_cast<double>(range);
+}
+
 void TransferTask::assign(const ImageInfoList& imageInfoList)
 {
     CPU_INSTRUMENTATION_L2(instrumentation);
@@ -227,9 +278,13 @@ void TransferTask::_transferImageInfos(DataToCopy& dataToCopy, VkCommandBuffer v
         }
         else
         {
+            ModifiedCount previousModifiedCount = imageInfo->copiedModifiedCounts[deviceID];
             if (imageInfo->syncModifiedCounts(deviceID))
             {
-                _transferImageInfo(vk_commandBuffer, frame, offset, *imageInfo);
+                if (!_transferImageInfoRows(vk_commandBuffer, frame, offset, *imageInfo, previousModifiedCount))
+                {
+                    _transferImageInfo(vk_commandBuffer, frame, offset, *imageInfo);
+                }
             }
             else
             {
@@ -301,39 +356,136 @@ void TransferTask::_transferImageInfo(VkCommandBuffer vk_commandBuffer, Transfer
 
             log(level, "    sourceTraits.size and targetTraits.size not compatible. dataSize() = ", data->dataSize(), ", imageTotalSize = ", imageTotalSize);
 
-            // set up a vec4 worth of default values for the type
-            const uint8_t* default_ptr = targetTraits.defaultValue;
-            uint32_t bytesFromSource = sourceTraits.size;
-            uint32_t bytesToTarget = targetTraits.size;
-
             offset += imageTotalSize;
 
-            // copy data
-            using value_type = uint8_t;
-            const value_type* src_ptr = reinterpret_cast<const value_type*>(data->dataPointer());
+            // convert directly into the staging buffer, padding each value with the default values for the type
+            convertPixels(data->dataPointer(), sourceTraits.size, ptr, targetTraits.size, targetTraits.defaultValue, data->valueCount());
+        }
+    }
 
-            value_type* dest_ptr = reinterpret_cast<value_type*>(ptr);
+    // transfer data.
+    transferImageData(imageInfo.imageView, imageInfo.imageLayout, properties, width, height, depth, mipLevels, mipmapOffsets, imageStagingBuffer, source_offset, vk_commandBuffer, device);
+}
 
-            size_t valueCount = data->valueCount();
-            for (size_t i = 0; i < valueCount; ++i)
-            {
-                uint32_t s = 0;
-                for (; s < bytesFromSource; ++s)
-                {
-                    (*dest_ptr++) = *(src_ptr++);
-                }
+bool TransferTask::_transferImageInfoRows(VkCommandBuffer vk_commandBuffer, TransferBlock& frame, VkDeviceSize& offset, ImageInfo& imageInfo, const ModifiedCount& previousModifiedCount)
+{
+    auto& imageView = imageInfo.imageView;
+    auto& data = imageView->image->data;
 
-                const value_type* src_default = default_ptr;
-                for (; s < bytesToTarget; ++s)
-                {
-                    (*dest_ptr++) = *(src_default++);
-                }
-            }
+    // partial updates are only supported for single level, single layer 1D/2D images that can be copied without format conversion
+    if (imageView->viewType != VK_IMAGE_VIEW_TYPE_1D && imageView->viewType != VK_IMAGE_VIEW_TYPE_2D) return false;
+    if (data->depth() != 1 || !data->contiguous()) return false;
+    if (data->properties.blockWidth > 1 || data->properties.blockHeight > 1) return false;
+    if (vsg::computeNumMipMapLevels(data, imageInfo.sampler) != 1) return false;
+
+    VkFormat sourceFormat = data->properties.format;
+    VkFormat targetFormat = imageView->format;
+    if (sourceFormat != targetFormat && getFormatTraits(sourceFormat).size != getFormatTraits(targetFormat).size) return false;
+
+    VkDeviceSize rowSize = static_cast<VkDeviceSize>(data->width()) * data->stride();
+    VkDeviceSize dataSize = rowSize * data->height();
+    if (rowSize == 0 || !data->getModifiedRanges(previousModifiedCount, _modifiedRanges)) return false;
+
+    // convert the byte ranges into spans of whole rows, stored as offset/size in rows
+    size_t numSpans = 0;
+    VkDeviceSize totalRows = 0;
+    for (auto& modifiedRange : _modifiedRanges)
+    {
+        VkDeviceSize beginRow = modifiedRange.offset / rowSize;
+        VkDeviceSize endRow = std::min((modifiedRange.offset + modifiedRange.size + rowSize - 1) / rowSize, static_cast<VkDeviceSize>(data->height()));
+        if (beginRow >= endRow) continue;
+
+        if (numSpans > 0 && beginRow <= (_modifiedRanges[numSpans - 1].offset + _modifiedRanges[numSpans - 1].size))
+        {
+            auto& previous = _modifiedRanges[numSpans - 1];
+            totalRows -= previous.size;
+            previous.size = std::max(static_cast<VkDeviceSize>(previous.offset + previous.size), endRow) - previous.offset;
+            totalRows += previous.size;
+        }
+        else
+        {
+            _modifiedRanges[numSpans++] = ModifiedRange{static_cast<size_t>(beginRow), static_cast<size_t>(endRow - beginRow)};
+            totalRows += (endRow - beginRow);
         }
     }
+    _modifiedRanges.resize(numSpans);
 
-    // transfer data.
-    transferImageData(imageInfo.imageView, imageInfo.imageLayout, properties, width, height, depth, mipLevels, mipmapOffsets, imageStagingBuffer, source_offset, vk_commandBuffer, device);
+    if (static_cast<double>(totalRows * rowSize) > partialTransferThreshold * static_cast<double>(dataSize)) return false;
+
+    // each span is aligned in the staging buffer, make sure the spans fit within the space reserved for the whole image
+    VkDeviceSize image_alignment = std::max(static_cast<VkDeviceSize>(data->stride()), static_cast<VkDeviceSize>(4));
+    if (totalRows * rowSize + numSpans * image_alignment > dataSize) return false;
+
+    log(level, "  TransferTask::_transferImageInfoRows(..) ", this, ", copying ", totalRows, " rows in ", numSpans, " spans of ", data);
+
+    if (numSpans == 0) return true;
+
+    auto deviceID = device->deviceID;
+    auto& buffer_data = frame.buffer_data;
+    const char* source = reinterpret_cast<const char*>(data->dataPointer());
+
+    VkImageAspectFlags aspectMask = computeAspectFlagsForFormat(targetFormat);
+
+    _imageCopyRegions.clear();
+    for (auto& span : _modifiedRanges)
+    {
+        offset = ((offset % image_alignment) == 0) ? offset : ((offset / image_alignment) + 1) * image_alignment;
+
+        VkDeviceSize spanSize = span.size * rowSize;
+        std::memcpy(reinterpret_cast<char*>(buffer_data) + offset, source + span.offset * rowSize, spanSize);
+
+        VkBufferImageCopy region = {};
+        region.bufferOffset = offset;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = aspectMask;
+        region.imageSubresource.mipLevel = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = {0, static_cast<int32_t>(span.offset), 0};
+        region.imageExtent = {data->width(), static_cast<uint32_t>(span.size), 1};
+        _imageCopyRegions.push_back(region);
+
+        offset += spanSize;
+    }
+
+    // transition from the current layout rather than VK_IMAGE_LAYOUT_UNDEFINED so the unmodified rows are preserved
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = imageInfo.imageLayout;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = imageView->image->vk(deviceID);
+    barrier.subresourceRange.aspectMask = aspectMask;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    vkCmdPipelineBarrier(vk_commandBuffer,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                         0, nullptr,
+                         0, nullptr,
+                         1, &barrier);
+
+    vkCmdCopyBufferToImage(vk_commandBuffer, frame.staging->vk(deviceID), imageView->image->vk(deviceID), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(_imageCopyRegions.size()), _imageCopyRegions.data());
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = imageInfo.imageLayout;
+
+    vkCmdPipelineBarrier(vk_commandBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                         0, nullptr,
+                         0, nullptr,
+                         1, &barrier);
+
+    return true;
 }
 
 TransferTask::TransferResult TransferTask::transferData(TransferMask transferMask)
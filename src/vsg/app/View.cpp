@@ -10,6 +10,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/app/PrefetchTraversal.h>
+#include <vsg/app/RecordThreads.h>
 #include <vsg/app/View.h>
 #include <vsg/nodes/Bin.h>
 #include <vsg/state/ViewDependentState.h>
@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/commands/CopyAndReleaseImage.h>
 #include <vsg/commands/PipelineBarrier.h>
 #include <vsg/io/Logger.h>
+#include <vsg/utils/FormatConversion.h>
 #include <vsg/vk/CommandBuffer.h>
 
 using namespace vsg;
@@ -107,34 +108,11 @@ void CopyAndReleaseImage::copy(ref_ptr<Data> data, ref_ptr<ImageInfo> dest, uint
         cd.layout.format = targetFormat;
         cd.layout.stride = targetTraits.size;
 
-        // set up a vec4 worth of default values for the type
-        const uint8_t* default_ptr = targetTraits.defaultValue;
-        uint32_t bytesFromSource = sourceTraits.size;
-        uint32_t bytesToTarget = targetTraits.size;
-
-        // copy data
-        using value_type = uint8_t;
-        const value_type* src_ptr = reinterpret_cast<const value_type*>(data->dataPointer());
-
         void* buffer_data;
         imageStagingMemory->map(imageStagingBuffer->getMemoryOffset(deviceID) + stagingBufferInfo->offset, imageTotalSize, 0, &buffer_data);
-        value_type* dest_ptr = reinterpret_cast<value_type*>(buffer_data);
-
-        size_t valueCount = data->valueCount();
-        for (size_t i = 0; i < valueCount; ++i)
-        {
-            uint32_t s = 0;
-            for (; s < bytesFromSource; ++s)
-            {
-                (*dest_ptr++) = *(src_ptr++);
-            }
-
-            const value_type* src_default = default_ptr;
-            for (; s < bytesToTarget; ++s)
-            {
-                (*dest_ptr++) = *(src_default++);
-            }
-        }
+
+        // convert directly into the mapped staging memory, padding each value with the default values for the type
+        convertPixels(data->dataPointer(), sourceTraits.size, buffer_data, targetTraits.size, targetTraits.defaultValue, data->valueCount());
 
         imageStagingMemory->unmap();
 
@@ -77,21 +77,32 @@ void Auxiliary::resetConnectedObject()
 
 int Auxiliary::compare(const Auxiliary& rhs) const
 {
-    auto lhs_itr = userObjects.begin();
-    auto rhs_itr = rhs.userObjects.begin();
-    while (lhs_itr != userObjects.end() && rhs_itr != rhs.userObjects.end())
+    auto lhs_itr = userValues.begin();
+    auto rhs_itr = rhs.userValues.begin();
+    while (lhs_itr != userValues.end() && rhs_itr != rhs.userValues.end())
     {
-        if (lhs_itr->first < rhs_itr->first) return -1;
-        if (lhs_itr->first > rhs_itr->first) return 1;
-        if (int result = vsg::compare_pointer(lhs_itr->second, rhs_itr->second); result != 0) return result;
+        // keys are interned so matching keys share the same std::string
+        if (&lhs_itr->key() != &rhs_itr->key()) return lhs_itr->key() < rhs_itr->key() ? -1 : 1;
+
+        // compare inline values of the same type directly, avoiding the creation of their Value<T> objects
+        auto lhs_type = lhs_itr->storedObject() ? nullptr : lhs_itr->inlineType();
+        auto rhs_type = rhs_itr->storedObject() ? nullptr : rhs_itr->inlineType();
+        if (lhs_type && rhs_type && lhs_type->type == rhs_type->type)
+        {
+            if (int result = std::memcmp(lhs_itr->inlineValue(), rhs_itr->inlineValue(), UserValues::maxInlineSize); result != 0) return result < 0 ? -1 : 1;
+        }
+        else if (int result = vsg::compare_pointer(ref_ptr<const Object>(lhs_itr->object()), ref_ptr<const Object>(rhs_itr->object())); result != 0)
+        {
+            return result;
+        }
         ++lhs_itr;
         ++rhs_itr;
     }
 
-    // only can get here if either lhs_itr == userObjects.end() || rhs_itr == rhs.userObjects.end()
-    if (lhs_itr == userObjects.end())
+    // only can get here if either lhs_itr == userValues.end() || rhs_itr == rhs.userValues.end()
+    if (lhs_itr == userValues.end())
     {
-        if (rhs_itr != rhs.userObjects.end())
+        if (rhs_itr != rhs.userValues.end())
             return -1;
         else
             return 0;
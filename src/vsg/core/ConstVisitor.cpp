@@ -18,6 +18,12 @@ ConstVisitor::ConstVisitor()
 {
 }
 
+const RuntimeType& ConstVisitor::static_runtime_type() noexcept
+{
+    static const RuntimeType s_runtimeType(typeid(ConstVisitor), Object::static_runtime_type());
+    return s_runtimeType;
+}
+
 void ConstVisitor::apply(const Object&)
 {
 }
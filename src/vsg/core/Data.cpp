@@ -15,8 +15,16 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Input.h>
 #include <vsg/io/Output.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
+const RuntimeType& Data::static_runtime_type() noexcept
+{
+    static const RuntimeType s_runtimeType(typeid(Data), Object::static_runtime_type());
+    return s_runtimeType;
+}
+
 int Data::Properties::compare(const Properties& rhs) const
 {
     return compare_memory(*this, rhs);
@@ -158,3 +166,53 @@ std::size_t Data::computeValueCountIncludingMipmaps(std::size_t w, std::size_t h
 
     return lastPosition;
 }
+
+void Data::dirty(size_t offset, size_t size)
+{
+    ++_modifiedCount;
+
+    if (size == 0) return;
+
+    // merge with any overlapping or adjacent ranges so that the retained ranges remain disjoint
+    size_t begin = offset;
+    size_t end = offset + size;
+    for (auto itr = _modifiedRanges.begin(); itr != _modifiedRanges.end();)
+    {
+        if (itr->begin <= end && begin <= itr->end)
+        {
+            begin = std::min(begin, itr->begin);
+            end = std::max(end, itr->end);
+            itr = _modifiedRanges.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+
+    // ranges are kept in order of modification so the oldest is always at the front
+    _modifiedRanges.push_back(ModifiedRangeEntry{_modifiedCount, begin, end});
+
+    if (_modifiedRanges.size() > maxNumModifiedRanges)
+    {
+        // ModifiedCounts prior to the discarded range can no longer be served by ranges so have to be treated as fully modified
+        _fullyModifiedCount = _modifiedRanges.front().count;
+        _modifiedRanges.erase(_modifiedRanges.begin());
+    }
+}
+
+bool Data::getModifiedRanges(const ModifiedCount& mc, ModifiedRanges& ranges) const
+{
+    ranges.clear();
+
+    if (mc.count < _fullyModifiedCount.count) return false;
+
+    for (auto& entry : _modifiedRanges)
+    {
+        if (entry.count.count > mc.count) ranges.push_back(ModifiedRange{entry.begin, entry.end - entry.begin});
+    }
+
+    std::sort(ranges.begin(), ranges.end(), [](const ModifiedRange& lhs, const ModifiedRange& rhs) { return lhs.offset < rhs.offset; });
+
+    return true;
+}
@@ -16,8 +16,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Logger.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <iostream>
+#include <limits>
+#include <set>
 
 using namespace vsg;
 
@@ -28,6 +31,127 @@ using namespace vsg;
 
 #define DEBUG_ALLOCATOR 0
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ThreadCache
+//
+struct IntrusiveAllocator::ThreadCacheRegistry
+{
+    std::mutex mutex;
+    IntrusiveAllocator* allocator = nullptr;
+    std::set<ThreadCache*> threadCaches;
+
+    // incremented whenever a MemoryBlock is added or removed so thread caches know to update their BlockRanges
+    std::atomic<uint64_t> blocksVersion{0};
+};
+
+struct IntrusiveAllocator::ThreadCache
+{
+    // allocations up to maximumCachedSize are cached in size classes of sizeClassGranularity bytes
+    static constexpr size_t sizeClassGranularity = 16;
+    static constexpr size_t numSizeClasses = 32;
+    static constexpr size_t maximumCachedSize = sizeClassGranularity * numSizeClasses;
+
+    // number of slots allocated from the MemoryBlocks when a size class is empty
+    static constexpr size_t refillCount = 16;
+
+    // maximum number of deallocated slots kept in a size class for reuse before they are returned to the MemoryBlocks
+    static constexpr size_t maximumSlotsPerSizeClass = 2 * refillCount;
+
+    // number of deallocations to accumulate before returning them to the MemoryBlocks
+    static constexpr size_t maximumPendingDeallocations = 64;
+
+    struct Slot
+    {
+        void* ptr;
+        size_t size;
+    };
+
+    struct BlockRange
+    {
+        const void* begin;
+        const void* end;
+        AllocatorAffinity allocatorAffinity;
+    };
+
+    explicit ThreadCache(std::shared_ptr<ThreadCacheRegistry> in_registry) :
+        registry(in_registry),
+        slots(ALLOCATOR_AFFINITY_LAST * numSizeClasses)
+    {
+        pendingDeallocations.reserve(maximumPendingDeallocations);
+        deallocationBatch.reserve(maximumPendingDeallocations);
+    }
+
+    ~ThreadCache();
+
+    static inline size_t sizeClass(size_t size) { return size == 0 ? 0 : (size - 1) / sizeClassGranularity; }
+    static inline size_t sizeClassSize(size_t sc) { return (sc + 1) * sizeClassGranularity; }
+
+    inline std::vector<Slot>& bin(size_t size, AllocatorAffinity allocatorAffinity) { return slots[allocatorAffinity * numSizeClasses + sizeClass(size)]; }
+
+    const BlockRange* findBlockRange(const void* ptr) const
+    {
+        auto itr = std::upper_bound(blockRanges.begin(), blockRanges.end(), ptr, [](const void* p, const BlockRange& range) { return std::less<const void*>()(p, range.begin); });
+        if (itr == blockRanges.begin()) return nullptr;
+        --itr;
+        return std::less<const void*>()(ptr, itr->end) ? &(*itr) : nullptr;
+    }
+
+    std::shared_ptr<ThreadCacheRegistry> registry;
+    std::vector<std::vector<Slot>> slots;
+
+    // deallocations of slots from the MemoryBlocks waiting to be returned in a batch, guarded by pendingMutex so that
+    // IntrusiveAllocator::deleteEmptyMemoryBlocks() can flush the pending deallocations of all threads
+    std::mutex pendingMutex;
+    std::vector<std::pair<void*, size_t>> pendingDeallocations;
+
+    // only used by the thread owning the cache to return a batch of pending deallocations without holding pendingMutex
+    std::vector<std::pair<void*, size_t>> deallocationBatch;
+
+    // address ranges of the MemoryBlocks, used to find the affinity of deallocated pointers without locking the Allocator::mutex
+    std::vector<BlockRange> blockRanges;
+    uint64_t blocksVersion = std::numeric_limits<uint64_t>::max();
+
+    // only modified by the thread owning the cache, read by IntrusiveAllocator::report() and the total*Size() methods
+    std::atomic<size_t> numCachedSlots{0};
+    std::atomic<size_t> cachedSize{0};
+
+    inline void adjustCached(size_t numSlots, size_t size, bool add)
+    {
+        numCachedSlots.store(add ? (numCachedSlots.load(std::memory_order_relaxed) + numSlots) : (numCachedSlots.load(std::memory_order_relaxed) - numSlots), std::memory_order_relaxed);
+        cachedSize.store(add ? (cachedSize.load(std::memory_order_relaxed) + size) : (cachedSize.load(std::memory_order_relaxed) - size), std::memory_order_relaxed);
+    }
+};
+
+IntrusiveAllocator::ThreadCache::~ThreadCache()
+{
+    std::scoped_lock<std::mutex> registry_lock(registry->mutex);
+    if (registry->allocator)
+    {
+        std::scoped_lock<std::mutex> lock(registry->allocator->mutex);
+        registry->allocator->flushThreadCacheLocked(*this);
+    }
+    registry->threadCaches.erase(this);
+}
+
+namespace
+{
+    // set once the calling thread's ThreadCache has been destroyed so that deallocations made later in thread shutdown bypass the cache
+    thread_local bool s_threadCacheDestroyed = false;
+
+    template<class T>
+    struct ThreadCacheHolder
+    {
+        std::unique_ptr<T> threadCache;
+
+        ~ThreadCacheHolder()
+        {
+            threadCache.reset();
+            s_threadCacheDestroyed = true;
+        }
+    };
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // MemoryBlock
@@ -756,6 +880,7 @@ void* IntrusiveAllocator::MemoryBlocks::allocate(std::size_t size)
     if (parent)
     {
         parent->memoryBlocks[new_block->memory] = new_block;
+        if (parent->threadCacheRegistry) ++(parent->threadCacheRegistry->blocksVersion);
     }
 
     if (memoryBlocks.empty())
@@ -855,6 +980,9 @@ IntrusiveAllocator::IntrusiveAllocator(size_t in_defaultAlignment) :
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_DATA].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_DATA", size_t(16) * blockSize, defaultAlignment));
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_NODES].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_NODES", blockSize, defaultAlignment));
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_PHYSICS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_PHYSICS", blockSize, 16));
+
+    threadCacheRegistry = std::make_shared<ThreadCacheRegistry>();
+    threadCacheRegistry->allocator = this;
 }
 
 IntrusiveAllocator::IntrusiveAllocator(std::unique_ptr<Allocator> in_nestedAllocator, size_t in_defaultAlignment) :
@@ -868,10 +996,16 @@ IntrusiveAllocator::IntrusiveAllocator(std::unique_ptr<Allocator> in_nestedAlloc
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_DATA].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_DATA", size_t(16) * blockSize, defaultAlignment));
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_NODES].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_NODES", blockSize, defaultAlignment));
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_PHYSICS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_PHYSICS", blockSize, 16));
+
+    threadCacheRegistry = std::make_shared<ThreadCacheRegistry>();
+    threadCacheRegistry->allocator = this;
 }
 
 IntrusiveAllocator::~IntrusiveAllocator()
 {
+    // detach any remaining thread caches, their slots are released along with the MemoryBlocks
+    std::scoped_lock<std::mutex> registry_lock(threadCacheRegistry->mutex);
+    threadCacheRegistry->allocator = nullptr;
 }
 
 void IntrusiveAllocator::setBlockSize(AllocatorAffinity allocatorAffinity, size_t blockSize)
@@ -900,13 +1034,148 @@ void IntrusiveAllocator::report(std::ostream& out) const
         if (memoryBlock) memoryBlock->report(out);
     }
 
+    {
+        std::scoped_lock<std::mutex> registry_lock(threadCacheRegistry->mutex);
+        size_t numCachedSlots = 0;
+        size_t cachedSize = 0;
+        for (auto& threadCache : threadCacheRegistry->threadCaches)
+        {
+            numCachedSlots += threadCache->numCachedSlots.load(std::memory_order_relaxed);
+            cachedSize += threadCache->cachedSize.load(std::memory_order_relaxed);
+        }
+        out << "IntrusiveAllocator thread caches = " << threadCacheRegistry->threadCaches.size() << ", numCachedSlots = " << numCachedSlots << ", cachedSize = " << cachedSize << std::endl;
+    }
+
     validate();
 }
 
+IntrusiveAllocator::ThreadCache* IntrusiveAllocator::getThreadCache()
+{
+    if (s_threadCacheDestroyed) return nullptr;
+
+    static thread_local ThreadCacheHolder<ThreadCache> s_holder;
+    auto& s_threadCache = s_holder.threadCache;
+
+    auto threadCache = s_threadCache.get();
+    if (threadCache && threadCache->registry == threadCacheRegistry) return threadCache;
+
+    if (threadCache)
+    {
+        // thread cache is associated with another allocator, only replace it if that allocator has been destroyed
+        std::scoped_lock<std::mutex> registry_lock(threadCache->registry->mutex);
+        if (threadCache->registry->allocator) return nullptr;
+    }
+
+    s_threadCache.reset(new ThreadCache(threadCacheRegistry));
+
+    std::scoped_lock<std::mutex> registry_lock(threadCacheRegistry->mutex);
+    threadCacheRegistry->threadCaches.insert(s_threadCache.get());
+    return s_threadCache.get();
+}
+
+void IntrusiveAllocator::updateBlockRanges(ThreadCache& threadCache)
+{
+    uint64_t blocksVersion = threadCacheRegistry->blocksVersion.load();
+    if (threadCache.blocksVersion == blocksVersion) return;
+
+    threadCache.blockRanges.clear();
+    for (size_t affinity = 0; affinity < std::min(allocatorMemoryBlocks.size(), size_t(ALLOCATOR_AFFINITY_LAST)); ++affinity)
+    {
+        if (!allocatorMemoryBlocks[affinity]) continue;
+        for (auto& memoryBlock : allocatorMemoryBlocks[affinity]->memoryBlocks)
+        {
+            threadCache.blockRanges.push_back(ThreadCache::BlockRange{memoryBlock->memory, memoryBlock->memoryEnd, static_cast<AllocatorAffinity>(affinity)});
+        }
+    }
+
+    std::sort(threadCache.blockRanges.begin(), threadCache.blockRanges.end(), [](const ThreadCache::BlockRange& lhs, const ThreadCache::BlockRange& rhs) { return std::less<const void*>()(lhs.begin, rhs.begin); });
+    threadCache.blocksVersion = blocksVersion;
+}
+
+void* IntrusiveAllocator::refillThreadCache(ThreadCache& threadCache, std::size_t size, AllocatorAffinity allocatorAffinity)
+{
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    auto& blocks = allocatorMemoryBlocks[allocatorAffinity];
+    size_t classSize = ThreadCache::sizeClassSize(ThreadCache::sizeClass(size));
+    if (!blocks || classSize > blocks->maximumAllocationSize) return allocateLocked(size, allocatorAffinity);
+
+    auto& slots = threadCache.bin(size, allocatorAffinity);
+    size_t totalSize = 0;
+    for (size_t i = 0; i < ThreadCache::refillCount; ++i)
+    {
+        auto ptr = blocks->allocate(classSize);
+        if (!ptr) break;
+
+        // record the full size of the slot so that the thread cache statistics match those of the MemoryBlock
+        size_t slotSize = (static_cast<MemoryBlock::Element*>(ptr) - 1)->next - 1;
+        slots.push_back(ThreadCache::Slot{ptr, slotSize * sizeof(MemoryBlock::Element)});
+        totalSize += slots.back().size;
+    }
+
+    if (slots.empty()) return allocateLocked(size, allocatorAffinity);
+
+    updateBlockRanges(threadCache);
+
+    auto slot = slots.back();
+    slots.pop_back();
+    threadCache.adjustCached(slots.size(), totalSize - slot.size, true);
+    return slot.ptr;
+}
+
+void IntrusiveAllocator::flushThreadCacheLocked(ThreadCache& threadCache)
+{
+    {
+        std::scoped_lock<std::mutex> pending_lock(threadCache.pendingMutex);
+        for (auto& [ptr, size] : threadCache.pendingDeallocations)
+        {
+            deallocateLocked(ptr, size);
+        }
+        threadCache.pendingDeallocations.clear();
+    }
+
+    for (auto& slots : threadCache.slots)
+    {
+        for (auto& slot : slots)
+        {
+            deallocateLocked(slot.ptr, slot.size);
+        }
+        slots.clear();
+    }
+    threadCache.adjustCached(threadCache.numCachedSlots.load(std::memory_order_relaxed), threadCache.cachedSize.load(std::memory_order_relaxed), false);
+}
+
+void IntrusiveAllocator::flushThreadCache()
+{
+    if (auto threadCache = getThreadCache())
+    {
+        std::scoped_lock<std::mutex> lock(mutex);
+        flushThreadCacheLocked(*threadCache);
+    }
+}
+
 void* IntrusiveAllocator::allocate(std::size_t size, AllocatorAffinity allocatorAffinity)
 {
+    if (threadCaching && size <= ThreadCache::maximumCachedSize && allocatorAffinity < ALLOCATOR_AFFINITY_LAST)
+    {
+        if (auto threadCache = getThreadCache())
+        {
+            auto& slots = threadCache->bin(size, allocatorAffinity);
+            if (slots.empty()) return refillThreadCache(*threadCache, size, allocatorAffinity);
+
+            auto slot = slots.back();
+            slots.pop_back();
+            threadCache->adjustCached(1, slot.size, false);
+            return slot.ptr;
+        }
+    }
+
     std::scoped_lock<std::mutex> lock(mutex);
+    return allocateLocked(size, allocatorAffinity);
+}
 
+void* IntrusiveAllocator::allocateLocked(std::size_t size, AllocatorAffinity allocatorAffinity)
+{
     // create a MemoryBlocks entry if one doesn't already exist
     if (allocatorAffinity > allocatorMemoryBlocks.size())
     {
@@ -941,8 +1210,64 @@ void* IntrusiveAllocator::allocate(std::size_t size, AllocatorAffinity allocator
 
 bool IntrusiveAllocator::deallocate(void* ptr, std::size_t size)
 {
+    if (threadCaching)
+    {
+        if (auto threadCache = getThreadCache())
+        {
+            // if the pointer is from one of the MemoryBlocks then keep the slot in the thread cache for reuse
+            if (threadCache->blocksVersion == threadCacheRegistry->blocksVersion.load(std::memory_order_acquire))
+            {
+                if (auto blockRange = threadCache->findBlockRange(ptr))
+                {
+                    // the next field of an allocated slot is only modified when the slot itself is deallocated, other threads may
+                    // concurrently update the previous field within the same 4 byte Element, but that doesn't affect the slot size.
+                    size_t slotSize = static_cast<size_t>((static_cast<const MemoryBlock::Element*>(ptr) - 1)->next - 1) * sizeof(MemoryBlock::Element);
+                    if (slotSize >= ThreadCache::sizeClassGranularity && slotSize <= ThreadCache::maximumCachedSize)
+                    {
+                        size_t sizeClass = std::min(slotSize / ThreadCache::sizeClassGranularity, ThreadCache::numSizeClasses) - 1;
+                        auto& slots = threadCache->slots[blockRange->allocatorAffinity * ThreadCache::numSizeClasses + sizeClass];
+                        if (slots.size() < ThreadCache::maximumSlotsPerSizeClass)
+                        {
+                            slots.push_back(ThreadCache::Slot{ptr, slotSize});
+                            threadCache->adjustCached(1, slotSize, true);
+                            return true;
+                        }
+
+                        // defer the deallocation of the slot so that it can be batched with others under a single lock
+                        {
+                            std::scoped_lock<std::mutex> pending_lock(threadCache->pendingMutex);
+                            threadCache->pendingDeallocations.emplace_back(ptr, size);
+                            if (threadCache->pendingDeallocations.size() < ThreadCache::maximumPendingDeallocations) return true;
+
+                            threadCache->deallocationBatch.swap(threadCache->pendingDeallocations);
+                        }
+
+                        bool result = true;
+                        std::scoped_lock<std::mutex> lock(mutex);
+                        for (auto& [pending_ptr, pending_size] : threadCache->deallocationBatch)
+                        {
+                            result = deallocateLocked(pending_ptr, pending_size) && result;
+                        }
+                        threadCache->deallocationBatch.clear();
+                        return result;
+                    }
+                }
+            }
+
+            // large allocations, pointers not from the MemoryBlocks and pointers in MemoryBlocks added since the block ranges were last updated
+            // are deallocated immediately so the caller, such as an allocator using this one as its nestedAllocator, gets the correct result
+            std::scoped_lock<std::mutex> lock(mutex);
+            updateBlockRanges(*threadCache);
+            return deallocateLocked(ptr, size);
+        }
+    }
+
     std::scoped_lock<std::mutex> lock(mutex);
+    return deallocateLocked(ptr, size);
+}
 
+bool IntrusiveAllocator::deallocateLocked(void* ptr, std::size_t size)
+{
     if (memoryBlocks.empty()) return false;
 
     auto itr = memoryBlocks.upper_bound(ptr);
@@ -1005,11 +1330,35 @@ bool IntrusiveAllocator::validate() const
 
 size_t IntrusiveAllocator::deleteEmptyMemoryBlocks()
 {
+    flushThreadCache();
+
+    // the pending deallocations of other threads keep slots in use so return them before looking for empty MemoryBlocks,
+    // the cached slots of other threads are only accessed by their owning thread so remain allocated until those threads flush them
+    std::vector<std::pair<void*, size_t>> pendingDeallocations;
+    {
+        std::scoped_lock<std::mutex> registry_lock(threadCacheRegistry->mutex);
+        for (auto threadCache : threadCacheRegistry->threadCaches)
+        {
+            std::scoped_lock<std::mutex> pending_lock(threadCache->pendingMutex);
+            pendingDeallocations.insert(pendingDeallocations.end(), threadCache->pendingDeallocations.begin(), threadCache->pendingDeallocations.end());
+            threadCache->pendingDeallocations.clear();
+        }
+    }
+
+    std::scoped_lock<std::mutex> lock(mutex);
+    for (auto& [ptr, size] : pendingDeallocations)
+    {
+        deallocateLocked(ptr, size);
+    }
+
     size_t count = 0;
     for (auto& blocks : allocatorMemoryBlocks)
     {
         count += blocks->deleteEmptyMemoryBlocks();
     }
+
+    if (count > 0) ++(threadCacheRegistry->blocksVersion);
+
     return count;
 }
 
@@ -1020,6 +1369,13 @@ size_t IntrusiveAllocator::totalAvailableSize() const
     {
         count += blocks->totalAvailableSize();
     }
+
+    // slots held in thread caches are reserved from the MemoryBlocks but still available for allocation
+    std::scoped_lock<std::mutex> registry_lock(threadCacheRegistry->mutex);
+    for (auto& threadCache : threadCacheRegistry->threadCaches)
+    {
+        count += threadCache->cachedSize.load(std::memory_order_relaxed);
+    }
     return count;
 }
 
@@ -1030,6 +1386,12 @@ size_t IntrusiveAllocator::totalReservedSize() const
     {
         count += blocks->totalReservedSize();
     }
+
+    std::scoped_lock<std::mutex> registry_lock(threadCacheRegistry->mutex);
+    for (auto& threadCache : threadCacheRegistry->threadCaches)
+    {
+        count -= threadCache->cachedSize.load(std::memory_order_relaxed);
+    }
     return count;
 }
 
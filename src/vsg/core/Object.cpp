@@ -42,14 +42,14 @@ Object::Object(const Object& rhs, const CopyOp& copyop) :
 
     if (rhs._auxiliary && rhs._auxiliary->getConnectedObject() == &rhs)
     {
-        // the rhs's auxiliary is uniquely attached to it, so we need to create our own and copy its ObjectMap across
-        auto& userObjects = getOrCreateAuxiliary()->userObjects;
-        userObjects = rhs._auxiliary->userObjects;
+        // the rhs's auxiliary is uniquely attached to it, so we need to create our own and copy its UserValues across
+        auto& userValues = getOrCreateAuxiliary()->userValues;
+        userValues = rhs._auxiliary->userValues;
         if (copyop.duplicate)
         {
-            for (auto itr = userObjects.begin(); itr != userObjects.end(); ++itr)
+            for (auto& entry : userValues)
             {
-                itr->second = copyop(itr->second);
+                if (auto object = entry.storedObject()) userValues.setObject(entry.key(), copyop(ref_ptr<Object>(object)));
             }
         }
     }
@@ -63,14 +63,19 @@ Object& Object::operator=(const Object& rhs)
 
     if (rhs._auxiliary)
     {
-        // the rhs's auxiliary is uniquely attached to it, so we need to create our own and copy its ObjectMap across
-        auto& userObjects = getOrCreateAuxiliary()->userObjects;
-        userObjects = rhs._auxiliary->userObjects;
+        // the rhs's auxiliary is uniquely attached to it, so we need to create our own and copy its UserValues across
+        getOrCreateAuxiliary()->userValues = rhs._auxiliary->userValues;
     }
 
     return *this;
 }
 
+const RuntimeType& Object::static_runtime_type() noexcept
+{
+    static const RuntimeType s_runtimeType(typeid(Object));
+    return s_runtimeType;
+}
+
 Object::~Object()
 {
     //debug("Object::~Object() ", this);
@@ -141,11 +146,13 @@ void Object::read(Input& input)
     auto numObjects = input.readValue<uint32_t>("userObjects");
     if (numObjects > 0)
     {
-        auto& objectMap = getOrCreateAuxiliary()->userObjects;
+        auto& userValues = getOrCreateAuxiliary()->userValues;
         for (; numObjects > 0; --numObjects)
         {
             std::string key = input.readValue<std::string>("key");
-            input.readObject("object", objectMap[key]);
+            ref_ptr<Object> object;
+            input.readObject("object", object);
+            userValues.setObjectOrInlineValue(key, object);
         }
     }
 }
@@ -154,13 +161,28 @@ void Object::write(Output& output) const
 {
     if (_auxiliary)
     {
-        // we have a unique auxiliary, need to write out its ObjectMap entries
-        auto& userObjects = _auxiliary->userObjects;
-        output.writeValue<uint32_t>("userObjects", userObjects.size());
-        for (auto& entry : userObjects)
+        // we have a unique auxiliary, need to write out its UserValues entries, values stored inline are written as their Value<T> objects
+        auto& userValues = _auxiliary->userValues;
+        output.writeValue<uint32_t>("userObjects", userValues.size());
+        for (auto& entry : userValues)
         {
-            output.write("key", entry.first);
-            output.writeObject("object", entry.second.get());
+            output.write("key", entry.key());
+            if (auto object = entry.storedObject())
+            {
+                output.writeObject("object", object);
+            }
+            else if (auto inlineType = entry.inlineType())
+            {
+                // write a temporary Value<T> so that serializing doesn't permanently replace the inline value with an Object,
+                // then remove it from the objectIDMap so that a later object allocated at the same address isn't mistaken for it
+                auto value = inlineType->createObject(entry.inlineValue());
+                output.writeObject("object", value.get());
+                output.objectIDMap.erase(value.get());
+            }
+            else
+            {
+                output.writeObject("object", nullptr);
+            }
         }
     }
     else
@@ -169,40 +191,40 @@ void Object::write(Output& output) const
     }
 }
 
-void Object::setObject(const std::string& key, ref_ptr<Object> object)
+void Object::setObject(std::string_view key, ref_ptr<Object> object)
 {
     getOrCreateAuxiliary()->setObject(key, object);
 }
 
-Object* Object::getObject(const std::string& key)
+Object* Object::getObject(std::string_view key)
 {
     if (!_auxiliary) return nullptr;
     return _auxiliary->getObject(key);
 }
 
-const Object* Object::getObject(const std::string& key) const
+const Object* Object::getObject(std::string_view key) const
 {
     if (!_auxiliary) return nullptr;
     return _auxiliary->getObject(key);
 }
 
-ref_ptr<Object> Object::getRefObject(const std::string& key)
+ref_ptr<Object> Object::getRefObject(std::string_view key)
 {
     if (!_auxiliary) return {};
     return _auxiliary->getRefObject(key);
 }
 
-ref_ptr<const Object> Object::getRefObject(const std::string& key) const
+ref_ptr<const Object> Object::getRefObject(std::string_view key) const
 {
     if (!_auxiliary) return {};
     return _auxiliary->getRefObject(key);
 }
 
-void Object::removeObject(const std::string& key)
+void Object::removeObject(std::string_view key)
 {
     if (_auxiliary)
     {
-        _auxiliary->userObjects.erase(key);
+        _auxiliary->removeObject(key);
     }
 }
 
@@ -0,0 +1,50 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/RuntimeType.h>
+
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace vsg;
+
+namespace
+{
+    uint32_t registerType(const std::type_info& type)
+    {
+        static std::mutex s_mutex;
+        static std::unordered_map<std::type_index, uint32_t> s_ids;
+
+        std::scoped_lock<std::mutex> lock(s_mutex);
+        auto [itr, inserted] = s_ids.emplace(type, static_cast<uint32_t>(s_ids.size()));
+        return itr->second;
+    }
+} // namespace
+
+RuntimeType::RuntimeType(const std::type_info& in_type) :
+    type(in_type),
+    id(registerType(in_type)),
+    depth(0),
+    _ancestors{id}
+{
+}
+
+RuntimeType::RuntimeType(const std::type_info& in_type, const RuntimeType& parent) :
+    type(in_type),
+    id(registerType(in_type)),
+    depth(parent.depth + 1),
+    _ancestors(parent._ancestors)
+{
+    _ancestors.push_back(id);
+}
@@ -0,0 +1,261 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2018 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/UserValues.h>
+#include <vsg/core/Value.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+#include <typeindex>
+
+using namespace vsg;
+
+namespace
+{
+    // std::map nodes are never moved so the registered InlineType remain valid for the lifetime of the application
+    struct InlineTypes
+    {
+        std::mutex mutex;
+        std::map<std::type_index, UserValues::InlineType> types;
+    };
+
+    InlineTypes& inlineTypes()
+    {
+        static InlineTypes s_inlineTypes;
+        return s_inlineTypes;
+    }
+
+    template<typename T>
+    void registerValueType()
+    {
+        if constexpr (UserValues::inline_storage_v<T>) userValueInlineType<T>();
+    }
+
+    template<typename... T>
+    void registerValueTypes()
+    {
+        (registerValueType<T>(), ...);
+    }
+
+    // Value<T> written with default properties, matching those created by Object::setValue(..), so nothing is lost by storing them inline
+    bool defaultProperties(const Data::Properties& properties)
+    {
+        Data::Properties defaults;
+        return properties.format == defaults.format && properties.stride == defaults.stride && properties.maxNumMipmaps == defaults.maxNumMipmaps &&
+               properties.blockWidth == defaults.blockWidth && properties.blockHeight == defaults.blockHeight && properties.blockDepth == defaults.blockDepth &&
+               properties.origin == defaults.origin && properties.imageViewType == defaults.imageViewType && properties.dataVariance == defaults.dataVariance;
+    }
+} // namespace
+
+const std::string* UserValues::intern(std::string_view key)
+{
+    // std::set nodes are never moved so the interned strings remain valid for the lifetime of the application
+    static std::mutex s_mutex;
+    static std::set<std::string, std::less<>> s_keys;
+
+    std::scoped_lock<std::mutex> lock(s_mutex);
+    auto itr = s_keys.find(key);
+    if (itr == s_keys.end()) itr = s_keys.emplace(key).first;
+    return &(*itr);
+}
+
+const UserValues::InlineType* UserValues::registerInlineType(const InlineType& inlineType)
+{
+    auto& registry = inlineTypes();
+    std::scoped_lock<std::mutex> lock(registry.mutex);
+    auto itr = registry.types.find(inlineType.objectType);
+    if (itr == registry.types.end()) itr = registry.types.emplace(inlineType.objectType, inlineType).first;
+    return &(itr->second);
+}
+
+const UserValues::InlineType* UserValues::findInlineType(const std::type_info& objectType)
+{
+    // register the standard plain data Value<T> types so values read from files are stored inline without the application having set values of that type first
+    static const bool s_registered = (registerValueTypes<bool, int, unsigned int, float, double, vec2, vec3, vec4, dvec2, bvec2, bvec3, bvec4, ubvec2, ubvec3, ubvec4,
+                                                         svec2, svec3, svec4, usvec2, usvec3, usvec4, ivec2, ivec3, ivec4, uivec2, uivec3, uivec4, mat2, quat, sphere>(),
+                                      true);
+    (void)s_registered;
+
+    auto& registry = inlineTypes();
+    std::scoped_lock<std::mutex> lock(registry.mutex);
+    auto itr = registry.types.find(objectType);
+    return itr != registry.types.end() ? &(itr->second) : nullptr;
+}
+
+Object* UserValues::Entry::object() const
+{
+    Object* existing = _object.load(std::memory_order_acquire);
+    if (existing || !_inlineType) return existing;
+
+    // create the Value<T> for the inline value, if another thread beats us to it use its object instead
+    auto created = _inlineType->createObject(_value);
+    created->ref();
+    if (_object.compare_exchange_strong(existing, created.get(), std::memory_order_acq_rel))
+    {
+        return created.get();
+    }
+    created->unref_nodelete();
+    return existing;
+}
+
+UserValues::UserValues(const UserValues& rhs)
+{
+    *this = rhs;
+}
+
+UserValues& UserValues::operator=(const UserValues& rhs)
+{
+    if (&rhs == this) return *this;
+
+    clear();
+    for (auto& entry : rhs)
+    {
+        Entry& copy = _findOrInsert(entry.key());
+        copy._inlineType = entry._inlineType;
+        std::memcpy(copy._value, entry._value, maxInlineSize);
+        if (auto object = entry.storedObject())
+        {
+            object->ref();
+            copy._object.store(object, std::memory_order_release);
+        }
+    }
+    return *this;
+}
+
+UserValues::~UserValues()
+{
+    clear();
+    if (_entries != _localEntries) delete[] _entries;
+}
+
+UserValues::Entry* UserValues::find(std::string_view key)
+{
+    auto itr = std::lower_bound(begin(), end(), key, [](const Entry& entry, std::string_view k) { return entry.key() < k; });
+    return (itr != end() && itr->key() == key) ? itr : nullptr;
+}
+
+const UserValues::Entry* UserValues::find(std::string_view key) const
+{
+    return const_cast<UserValues*>(this)->find(key);
+}
+
+void UserValues::setObject(std::string_view key, ref_ptr<Object> object)
+{
+    Entry& entry = _findOrInsert(key);
+    _reset(entry);
+    if (object)
+    {
+        object->ref();
+        entry._object.store(object.get(), std::memory_order_release);
+    }
+}
+
+void UserValues::setObjectOrInlineValue(std::string_view key, ref_ptr<Object> object)
+{
+    if (object && !object->getAuxiliary())
+    {
+        auto inlineType = findInlineType(typeid(*object));
+        auto data = inlineType ? object->cast<Data>() : nullptr;
+        if (data && defaultProperties(data->properties) && data->dataSize() <= maxInlineSize)
+        {
+            setInlineValue(key, data->dataPointer(), data->dataSize(), inlineType);
+            return;
+        }
+    }
+
+    setObject(key, object);
+}
+
+void UserValues::setInlineValue(std::string_view key, const void* value, size_t size, const InlineType* inlineType)
+{
+    Entry& entry = _findOrInsert(key);
+    _reset(entry);
+    entry._inlineType = inlineType;
+    // clear the unused bytes so that inline values can be compared with memcmp
+    size = std::min(size, maxInlineSize);
+    std::memcpy(entry._value, value, size);
+    std::memset(entry._value + size, 0, maxInlineSize - size);
+}
+
+bool UserValues::remove(std::string_view key)
+{
+    Entry* entry = find(key);
+    if (!entry) return false;
+
+    _reset(*entry);
+    for (Entry* next = entry + 1; next != end(); ++next, ++entry)
+    {
+        _move(*entry, *next);
+    }
+    entry->_key = nullptr;
+    --_size;
+    return true;
+}
+
+void UserValues::clear()
+{
+    for (auto& entry : *this)
+    {
+        _reset(entry);
+        entry._key = nullptr;
+    }
+    _size = 0;
+}
+
+UserValues::Entry& UserValues::_findOrInsert(std::string_view key)
+{
+    auto itr = std::lower_bound(begin(), end(), key, [](const Entry& entry, std::string_view k) { return entry.key() < k; });
+    if (itr != end() && itr->key() == key) return *itr;
+
+    auto position = static_cast<uint32_t>(itr - begin());
+    if (_size == _capacity)
+    {
+        // grow into a heap allocated array, moving the existing entries across
+        uint32_t newCapacity = _capacity * 2;
+        Entry* newEntries = new Entry[newCapacity];
+        for (uint32_t i = 0; i < _size; ++i) _move(newEntries[i], _entries[i]);
+        if (_entries != _localEntries) delete[] _entries;
+        _entries = newEntries;
+        _capacity = newCapacity;
+    }
+
+    // shift the entries after the insertion position up by one to keep the entries sorted by key
+    for (uint32_t i = _size; i > position; --i)
+    {
+        _move(_entries[i], _entries[i - 1]);
+    }
+    ++_size;
+
+    Entry& entry = _entries[position];
+    entry._key = intern(key);
+    return entry;
+}
+
+void UserValues::_reset(Entry& entry)
+{
+    if (auto object = entry._object.exchange(nullptr, std::memory_order_acq_rel)) object->unref();
+    entry._inlineType = nullptr;
+}
+
+void UserValues::_move(Entry& dest, Entry& source)
+{
+    dest._key = source._key;
+    dest._inlineType = source._inlineType;
+    dest._object.store(source._object.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
+    std::memcpy(dest._value, source._value, maxInlineSize);
+
+    source._key = nullptr;
+    source._inlineType = nullptr;
+}
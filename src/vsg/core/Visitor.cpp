@@ -18,6 +18,12 @@ Visitor::Visitor()
 {
 }
 
+const RuntimeType& Visitor::static_runtime_type() noexcept
+{
+    static const RuntimeType s_runtimeType(typeid(Visitor), Object::static_runtime_type());
+    return s_runtimeType;
+}
+
 void Visitor::apply(Object&)
 {
 }
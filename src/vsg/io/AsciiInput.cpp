@@ -159,10 +159,10 @@ vsg::ref_ptr<vsg::Object> AsciiInput::read()
         ObjectID id = result.second;
         //debug("   matched result=", id);
 
-        if (auto itr = objectIDMap.find(id); itr != objectIDMap.end())
+        if (auto existing = objectIDMap.find(id))
         {
-            //debug("Returning existing object ", itr->second);
-            return itr->second;
+            //debug("Returning existing object ", *existing);
+            return *existing;
         }
         else
         {
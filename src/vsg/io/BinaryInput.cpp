@@ -185,9 +185,40 @@ vsg::ref_ptr<vsg::Object> BinaryInput::read()
 {
     ObjectID id = objectID();
 
-    if (auto itr = objectIDMap.find(id); itr != objectIDMap.end())
+    if (auto existing = objectIDMap.find(id))
     {
-        return itr->second;
+        return *existing;
+    }
+    else if (version_greater_equal(1, 1, 12))
+    {
+        // class names are written once, the first time they are used, and thereafter referenced by index
+        uint32_t classIndex = readValue<uint32_t>(nullptr);
+        if (classIndex == _classes.size())
+        {
+            auto& entry = _classes.emplace_back();
+            _read(entry.className);
+            if (entry.className != "nullptr") entry.createFunction = objectFactory->getCreateFunction(entry.className);
+        }
+        else if (classIndex > _classes.size())
+        {
+            warn("BinaryInput::read() invalid class index : ", classIndex);
+            return objectIDMap[id] = {};
+        }
+
+        const auto& entry = _classes[classIndex];
+        if (entry.className == "nullptr") return objectIDMap[id] = {};
+
+        auto object = entry.createFunction ? entry.createFunction() : objectFactory->create(entry.className);
+        objectIDMap[id] = object;
+        if (object)
+        {
+            object->read(*this);
+        }
+        else
+        {
+            warn("Unable to create instance of class : ", entry.className);
+        }
+        return object;
     }
     else
     {
@@ -212,3 +243,34 @@ vsg::ref_ptr<vsg::Object> BinaryInput::read()
         }
     }
 }
+
+bool BinaryInput::readMapped(size_t size, size_t alignment, ref_ptr<Data>& storage, size_t& offset)
+{
+    if (!mappedFile || size == 0) return false;
+
+    auto pos = _input.tellg();
+    if (pos < 0) return false;
+
+    size_t position = static_cast<size_t>(pos);
+    if (position > mappedFile->size() || size > (mappedFile->size() - position)) return false;
+
+    // only reference the data directly when it's suitably aligned for the array's value type
+    auto address = reinterpret_cast<std::uintptr_t>(mappedFile->data() + position);
+    if (alignment > 1 && (address % alignment) != 0) return false;
+
+    _input.seekg(static_cast<std::streamoff>(size), std::ios::cur);
+
+    storage = mappedFile;
+    offset = position;
+    return true;
+}
+
+void BinaryInput::readAlignmentPadding(size_t alignment)
+{
+    if (alignment <= 1 || version_less(1, 1, 12)) return;
+
+    // the padding count is written explicitly so the stream position doesn't need to be known
+    uint8_t padding = 0;
+    _read(1, &padding);
+    if (padding > 0) _input.ignore(padding);
+}
@@ -102,13 +102,34 @@ void BinaryOutput::write(const vsg::Object* object)
     objectIDMap[object] = id;
 
     _output.write(reinterpret_cast<const char*>(&id), sizeof(id));
-    if (object)
+
+    std::string className(object ? object->className() : "nullptr");
+    if (version_greater_equal(1, 1, 12))
     {
-        _write(std::string(object->className()));
-        object->write(*this);
+        // write the class name the first time it's used, thereafter just write its index
+        auto [itr, inserted] = _classIndices.emplace(className, static_cast<uint32_t>(_classIndices.size()));
+        _write(1, &(itr->second));
+        if (inserted) _write(className);
     }
     else
     {
-        _write(std::string("nullptr"));
+        _write(className);
     }
+
+    if (object) object->write(*this);
+}
+
+void BinaryOutput::writeAlignmentPadding(size_t alignment)
+{
+    if (alignment <= 1 || version_less(1, 1, 12)) return;
+
+    // streams that don't support tellp() are written without padding
+    uint8_t padding = 0;
+    if (auto pos = _output.tellp(); pos >= 0)
+    {
+        padding = static_cast<uint8_t>((alignment - static_cast<size_t>(pos + std::streamoff(1)) % alignment) % alignment);
+    }
+
+    _write(1, &padding);
+    for (uint8_t i = 0; i < padding; ++i) _output.put(0);
 }
@@ -16,6 +16,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/read.h>
 #include <vsg/threading/atomics.h>
 #include <vsg/ui/ApplicationEvent.h>
+#include <vsg/utils/ComputeMemoryFootprint.h>
 #include <vsg/utils/SharedObjects.h>
 
 using namespace vsg;
@@ -38,65 +39,170 @@ void DatabaseQueue::add(ref_ptr<PagedLOD> plod)
     // debug("DatabaseQueue::add(", plod,") status = ",plod->requestStatus.load());
 
     std::scoped_lock lock(_mutex);
-    _queue.emplace_back(plod);
+    _push(plod);
     _cv.notify_one();
 }
 
 void DatabaseQueue::add(ref_ptr<PagedLOD> plod, const CompileResult& cr)
 {
     std::scoped_lock lock(_mutex);
-    _queue.emplace_back(plod);
+    _push(plod);
     _cv.notify_one();
     _compileResult.add(cr);
 }
 
-ref_ptr<PagedLOD> DatabaseQueue::take_when_available()
+void DatabaseQueue::update(const PagedLOD* plod)
+{
+    std::scoped_lock lock(_mutex);
+
+    auto itr = _heapIndices.find(plod);
+    if (itr == _heapIndices.end()) return;
+
+    size_t index = itr->second;
+    double priority = plod->priority;
+    if (priority > _heap[index].priority)
+    {
+        _heap[index].priority = priority;
+        _siftUp(index);
+    }
+}
+
+bool DatabaseQueue::remove(const PagedLOD* plod)
 {
-    // debug("DatabaseQueue::take_when_available() A size = ", _queue.size());
+    std::scoped_lock lock(_mutex);
+
+    auto itr = _heapIndices.find(plod);
+    if (itr == _heapIndices.end()) return false;
+
+    _erase(itr->second);
+    return true;
+}
 
+bool DatabaseQueue::_wait(std::unique_lock<std::mutex>& lock)
+{
     std::chrono::duration waitDuration = std::chrono::milliseconds(100);
-    std::unique_lock lock(_mutex);
 
     // wait until the conditional variable signals that an operation has been added
-    while (_queue.empty() && _status->active())
+    while (_heap.empty() && _status->active())
     {
-        // debug("   Waiting on condition variable B size = ", _queue.size());
+        // debug("   Waiting on condition variable B size = ", _heap.size());
         _cv.wait_for(lock, waitDuration);
     }
 
     // if the threads we are associated with should no longer be running go for a quick exit and return nothing.
-    if (_queue.empty() || _status->cancel())
+    return !_heap.empty() && !_status->cancel();
+}
+
+ref_ptr<PagedLOD> DatabaseQueue::take_when_available()
+{
+    // debug("DatabaseQueue::take_when_available() A size = ", _heap.size());
+
+    std::unique_lock lock(_mutex);
+    if (!_wait(lock))
     {
         // debug("DatabaseQueue::take_when_available() C empty");
         return {};
     }
 
-    // debug("DatabaseQueue::take_when_available() D ", _queue.size());
+    return _pop();
+}
 
-    // find the PagedLOD with the highest priority;
-    auto itr = _queue.begin();
-    auto highest_itr = itr++;
+DatabaseQueue::Nodes DatabaseQueue::take_all(CompileResult& cr)
+{
+    std::scoped_lock lock(_mutex);
+    Nodes nodes;
+    for (auto& entry : _heap)
+    {
+        nodes.push_back(std::move(entry.plod));
+    }
+    _heap.clear();
+    _heapIndices.clear();
 
-    for (; itr != _queue.end(); ++itr)
+    cr.add(_compileResult);
+    _compileResult.reset();
+    return nodes;
+}
+
+size_t DatabaseQueue::size() const
+{
+    std::scoped_lock lock(_mutex);
+    return _heap.size();
+}
+
+void DatabaseQueue::_push(ref_ptr<PagedLOD> plod)
+{
+    auto [itr, inserted] = _heapIndices.emplace(plod.get(), _heap.size());
+    if (!inserted)
     {
-        if ((*itr)->priority > (*highest_itr)->priority) highest_itr = itr;
+        // already queued so just make sure it's position reflects the latest priority
+        size_t index = itr->second;
+        _heap[index].priority = std::max(_heap[index].priority, plod->priority.load());
+        _siftUp(index);
+        return;
     }
 
-    ref_ptr<PagedLOD> plod = *highest_itr;
-    _queue.erase(highest_itr);
+    double priority = plod->priority;
+    _heap.push_back(Entry{priority, plod});
+    _siftUp(_heap.size() - 1);
+}
+
+ref_ptr<PagedLOD> DatabaseQueue::_pop()
+{
+    ref_ptr<PagedLOD> plod = _heap.front().plod;
+    _erase(0);
 
-    // debug("Returning ", plod.get(), std::dec, ", size = ", _queue.size());
+    // debug("Returning ", plod.get(), std::dec, ", size = ", _heap.size());
     return plod;
 }
 
-DatabaseQueue::Nodes DatabaseQueue::take_all(CompileResult& cr)
+void DatabaseQueue::_erase(size_t index)
 {
-    std::scoped_lock lock(_mutex);
-    Nodes nodes;
-    nodes.swap(_queue);
-    cr.add(_compileResult);
-    _compileResult.reset();
-    return nodes;
+    _swap(index, _heap.size() - 1);
+
+    _heapIndices.erase(_heap.back().plod.get());
+    _heap.pop_back();
+
+    // the entry moved into the vacated position may need to move either way to restore the heap ordering
+    if (index < _heap.size())
+    {
+        _siftDown(index);
+        _siftUp(index);
+    }
+}
+
+void DatabaseQueue::_siftUp(size_t index)
+{
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (_heap[parent].priority >= _heap[index].priority) break;
+        _swap(parent, index);
+        index = parent;
+    }
+}
+
+void DatabaseQueue::_siftDown(size_t index)
+{
+    size_t size = _heap.size();
+    for (;;)
+    {
+        size_t highest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < size && _heap[left].priority > _heap[highest].priority) highest = left;
+        if (right < size && _heap[right].priority > _heap[highest].priority) highest = right;
+        if (highest == index) break;
+        _swap(index, highest);
+        index = highest;
+    }
+}
+
+void DatabaseQueue::_swap(size_t lhs, size_t rhs)
+{
+    if (lhs == rhs) return;
+    std::swap(_heap[lhs], _heap[rhs]);
+    _heapIndices[_heap[lhs].plod.get()] = lhs;
+    _heapIndices[_heap[rhs].plod.get()] = rhs;
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -153,7 +259,9 @@ void DatabasePager::start(uint32_t numReadThreads)
             {
                 CPU_INSTRUMENTATION_L1_NC(databasePager.instrumentation, "DatabasePager read", COLOR_PAGER);
 
-                uint64_t frameDelta = databasePager.frameCount - plod->frameHighResLastUsed.load();
+                // predicted requests remain valid while the PagedLOD is still predicted to be required
+                uint64_t frameLastRequired = std::max(plod->frameHighResLastUsed.load(), plod->frameHighResPredicted.load());
+                uint64_t frameDelta = databasePager.frameCount - frameLastRequired;
                 if (frameDelta > 1 || !compare_exchange(plod->requestStatus, PagedLOD::ReadRequest, PagedLOD::Reading))
                 {
                     // debug("Expire read request");
@@ -166,6 +274,12 @@ void DatabasePager::start(uint32_t numReadThreads)
 
                 if (subgraph && compare_exchange(plod->requestStatus, PagedLOD::Reading, PagedLOD::Compiling))
                 {
+                    // estimate the memory footprint before compiling, as the compile may release data that has been transferred to the GPU
+                    ComputeMemoryFootprint footprint;
+                    subgraph->accept(footprint);
+                    plod->cpuMemory = footprint.cpuMemory;
+                    plod->gpuMemory = footprint.gpuMemory;
+
                     {
                         std::scoped_lock<std::mutex> lock(databasePager.pendingPagedLODMutex);
                         plod->pending = subgraph;
@@ -222,6 +336,14 @@ void DatabasePager::start(uint32_t numReadThreads)
 
 void DatabasePager::request(ref_ptr<PagedLOD> plod)
 {
+    if (throttled() && numActiveRequests.load() >= throttledMaxNumActiveRequests)
+    {
+        // reset the requestCount so that the PagedLOD is requested again on a subsequent frame
+        plod->requestCount.exchange(0);
+        ++statistics.numThrottled;
+        return;
+    }
+
     ++numActiveRequests;
 
     bool hasPending = false;
@@ -248,6 +370,69 @@ void DatabasePager::request(ref_ptr<PagedLOD> plod)
     }
 }
 
+void DatabasePager::requestPredicted(ref_ptr<PagedLOD> plod)
+{
+    request(plod);
+
+    if (plod->requestStatus.load() == PagedLOD::ReadRequest)
+    {
+        ++statistics.numPredicted;
+
+        std::scoped_lock<std::mutex> lock(_predictedRequestsMutex);
+        _predictedRequests.push_back(plod);
+    }
+}
+
+void DatabasePager::_cancelStalePredictedRequests()
+{
+    std::scoped_lock<std::mutex> lock(_predictedRequestsMutex);
+
+    auto itr = std::remove_if(_predictedRequests.begin(), _predictedRequests.end(), [&](const ref_ptr<PagedLOD>& plod) {
+        // no longer queued so the read thread is now responsible for it
+        if (plod->requestStatus.load() != PagedLOD::ReadRequest) return true;
+
+        // now visible so handle it as a regular request
+        if ((frameCount - plod->frameHighResLastUsed.load()) <= 1) return true;
+
+        // still predicted so keep tracking it
+        if ((frameCount - plod->frameHighResPredicted.load()) <= 1) return false;
+
+        if (_requestQueue->remove(plod.get()))
+        {
+            requestDiscarded(plod.get());
+            ++statistics.numPredictedCancelled;
+        }
+        return true;
+    });
+    _predictedRequests.erase(itr, _predictedRequests.end());
+}
+
+void DatabasePager::updatePriority(const PagedLOD* plod)
+{
+    if (plod->requestStatus.load() == PagedLOD::ReadRequest) _requestQueue->update(plod);
+}
+
+void DatabasePager::requestHighRes(const PagedLOD& plod, double priority, bool predicted)
+{
+    bool priorityRaised = exchange_if_greater(plod.priority, priority);
+
+    auto previousRequestCount = plod.requestCount.fetch_add(1);
+    if (previousRequestCount == 0)
+    {
+        // we are the first request so add it to the request queue, the PagedLOD is only modified by the DatabasePager so casting away const is safe
+        ref_ptr<PagedLOD> request_plod(const_cast<PagedLOD*>(&plod));
+        if (predicted)
+            requestPredicted(request_plod);
+        else
+            request(request_plod);
+    }
+    else if (priorityRaised)
+    {
+        // already queued so reposition it in the request queue
+        updatePriority(&plod);
+    }
+}
+
 void DatabasePager::requestDiscarded(PagedLOD* plod)
 {
     //std::scoped_lock<std::mutex> lock(pendingPagedLODMutex);
@@ -255,9 +440,26 @@ void DatabasePager::requestDiscarded(PagedLOD* plod)
     plod->requestCount.exchange(0);
     plod->requestStatus.exchange(PagedLOD::NoRequest);
     plod->pending = {};
+    plod->cpuMemory = 0;
+    plod->gpuMemory = 0;
     --numActiveRequests;
 }
 
+bool DatabasePager::throttled() const
+{
+    auto aboveThreshold = [&](uint64_t memory, uint64_t budget) {
+        return budget > 0 && static_cast<double>(memory) >= static_cast<double>(budget) * throttleRatio;
+    };
+    return aboveThreshold(statistics.cpuMemory.load(), targetMaxCpuMemory) || aboveThreshold(statistics.gpuMemory.load(), targetMaxGpuMemory);
+}
+
+bool DatabasePager::_exceedsMemoryBudget(uint64_t pendingCpuMemory, uint64_t pendingGpuMemory) const
+{
+    if (targetMaxCpuMemory > 0 && (statistics.cpuMemory.load() + pendingCpuMemory) > targetMaxCpuMemory) return true;
+    if (targetMaxGpuMemory > 0 && (statistics.gpuMemory.load() + pendingGpuMemory) > targetMaxGpuMemory) return true;
+    return false;
+}
+
 void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResult& cr)
 {
     CPU_INSTRUMENTATION_L1(instrumentation);
@@ -265,6 +467,8 @@ void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResu
     frameCount.exchange(frameStamp ? frameStamp->frameCount : 0);
     _deleteQueue->advance(frameStamp);
 
+    _cancelStalePredictedRequests();
+
     auto nodes = _toMergeQueue->take_all(cr);
 
     std::list<ref_ptr<Object>> deleteList;
@@ -317,41 +521,62 @@ void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResu
 
         debug("DatabasePager : activeList.count = ", pagedLODContainer->activeList.count, ", inactiveList.count = ", pagedLODContainer->inactiveList.count, ", total = ", total);
 
+        uint32_t targetNumInactive = pagedLODContainer->inactiveList.count;
         if ((nodes.size() + total) > targetMaxNumPagedLODWithHighResSubgraphs)
         {
             uint32_t numPagedLODHighRestSubgraphsToRemove = (static_cast<uint32_t>(nodes.size()) + total) - targetMaxNumPagedLODWithHighResSubgraphs;
-            uint32_t targetNumInactive = (numPagedLODHighRestSubgraphsToRemove < pagedLODContainer->inactiveList.count) ? (pagedLODContainer->inactiveList.count - numPagedLODHighRestSubgraphsToRemove) : 0;
+            targetNumInactive = (numPagedLODHighRestSubgraphsToRemove < pagedLODContainer->inactiveList.count) ? (pagedLODContainer->inactiveList.count - numPagedLODHighRestSubgraphsToRemove) : 0;
 
             debug("Need to remove, inactive count = ", pagedLODContainer->inactiveList.count, ", target = ", targetNumInactive);
+        }
 
-            for (uint32_t index = pagedLODContainer->inactiveList.head; (index != 0) && (pagedLODContainer->inactiveList.count > targetNumInactive);)
-            {
-                auto& element = elements[index];
-                index = element.next;
+        // memory of the subgraphs about to be merged
+        uint64_t pendingCpuMemory = 0;
+        uint64_t pendingGpuMemory = 0;
+        for (auto& plod : nodes)
+        {
+            pendingCpuMemory += plod->cpuMemory;
+            pendingGpuMemory += plod->gpuMemory;
+        }
 
-                if (compare_exchange(element.plod->requestStatus, PagedLOD::NoRequest, PagedLOD::DeleteRequest))
+        // the inactiveList is ordered from least to most recently used, so expire from its head until within the count and memory budgets
+        for (uint32_t index = pagedLODContainer->inactiveList.head; (index != 0) && ((pagedLODContainer->inactiveList.count > targetNumInactive) || _exceedsMemoryBudget(pendingCpuMemory, pendingGpuMemory));)
+        {
+            auto& element = elements[index];
+            index = element.next;
+
+            if (compare_exchange(element.plod->requestStatus, PagedLOD::NoRequest, PagedLOD::DeleteRequest))
+            {
+                ref_ptr<PagedLOD> plod = element.plod;
+                if (plod->children[0].node)
                 {
-                    ref_ptr<PagedLOD> plod = element.plod;
-                    plod->children[0].node = nullptr;
-                    plod->requestCount.exchange(0);
-                    plod->requestStatus.exchange(PagedLOD::NoRequest);
+                    statistics.cpuMemory -= plod->cpuMemory;
+                    statistics.gpuMemory -= plod->gpuMemory;
+                    --statistics.numHighResSubgraphs;
+                    ++statistics.numExpired;
+                }
+                plod->cpuMemory = 0;
+                plod->gpuMemory = 0;
+
+                plod->children[0].node = nullptr;
+                plod->requestCount.exchange(0);
+                plod->requestStatus.exchange(PagedLOD::NoRequest);
 
-                    deleteList.push_back(plod->pending);
-                    plod->pending = {};
+                deleteList.push_back(plod->pending);
+                plod->pending = {};
 
-                    deleteList.push_back(plod);
-                    pagedLODContainer->remove(plod);
+                deleteList.push_back(plod);
+                pagedLODContainer->remove(plod);
 
-                    if (plod->options->sharedObjects)
+                if (plod->options->sharedObjects)
+                {
+                    if (std::find(sharedObjectsToPrune.begin(), sharedObjectsToPrune.end(), plod->options->sharedObjects) == sharedObjectsToPrune.end())
                     {
-                        if (std::find(sharedObjectsToPrune.begin(), sharedObjectsToPrune.end(), plod->options->sharedObjects) == sharedObjectsToPrune.end())
-                        {
-                            sharedObjectsToPrune.push_back(plod->options->sharedObjects);
-                        }
+                        sharedObjectsToPrune.push_back(plod->options->sharedObjects);
                     }
-
-                    debug("    trimming ", plod, " ", plod->filename);
                 }
+
+                debug("    trimming ", plod, " ", plod->filename);
             }
         }
     }
@@ -377,6 +602,14 @@ void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResu
                     plod->children[0].node = plod->pending;
                 }
 
+                statistics.cpuMemory += plod->cpuMemory;
+                statistics.gpuMemory += plod->gpuMemory;
+                ++statistics.numHighResSubgraphs;
+                ++statistics.numMerged;
+
+                // subgraphs loaded for a predicted viewpoint that haven't yet been visible aren't tracked by the pagedLODContainer, so add them to the inactiveList so they can be expired
+                if (plod->index == 0 && pagedLODContainer) pagedLODContainer->inactive(plod);
+
                 plod->requestStatus.exchange(PagedLOD::NoRequest);
             }
         }
@@ -387,5 +620,10 @@ void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResu
         debug("DatabasePager::updateSceneGraph() nothing to merge");
     }
 
+    if (auto pools = deviceMemoryBufferPools.ref_ptr())
+    {
+        statistics.deviceMemoryReserved = pools->computeMemoryTotalReserved();
+    }
+
     if (!deleteList.empty() || !sharedObjectsToPrune.empty()) _deleteQueue->add_prune(deleteList, sharedObjectsToPrune);
 }
@@ -219,6 +219,24 @@ bool vsg::makeDirectory(const Path& path)
     return true;
 }
 
+bool vsg::renameFile(const Path& from, const Path& to)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    return MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else // POSIX
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+bool vsg::removeFile(const Path& path)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    return _wremove(path.c_str()) == 0;
+#else // POSIX
+    return std::remove(path.c_str()) == 0;
+#endif
+}
+
 Path vsg::executableFilePath()
 {
     Path path;
@@ -192,6 +192,8 @@ ObjectFactory::ObjectFactory()
     add<vsg::TileDatabaseSettings>();
     add<vsg::InstrumentationNode>();
     add<vsg::InstanceNode>();
+    add<vsg::InstanceCulling>();
+    add<vsg::BakedSubgraph>();
     add<vsg::InstanceDraw>();
     add<vsg::InstanceDrawIndexed>();
 
@@ -354,3 +356,12 @@ vsg::ref_ptr<vsg::Object> ObjectFactory::create(const std::string& className)
     warn("ObjectFactory::create(", className, ") failed to find means to create object.");
     return vsg::ref_ptr<vsg::Object>();
 }
+
+ObjectFactory::CreateFunction ObjectFactory::getCreateFunction(const std::string& className) const
+{
+    if (auto itr = _createMap.find(className); itr != _createMap.end())
+    {
+        return itr->second;
+    }
+    return {};
+}
@@ -58,7 +58,7 @@ Options::Options(const Options& options, const CopyOp& copyop) :
 {
     getOrCreateAuxiliary();
     // copy any meta data.
-    if (options.getAuxiliary()) getAuxiliary()->userObjects = options.getAuxiliary()->userObjects;
+    if (options.getAuxiliary()) getAuxiliary()->userValues = options.getAuxiliary()->userValues;
 }
 
 Options::~Options()
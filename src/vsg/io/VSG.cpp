@@ -10,14 +10,23 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/core/External.h>
 #include <vsg/core/Version.h>
 #include <vsg/io/AsciiInput.h>
 #include <vsg/io/AsciiOutput.h>
 #include <vsg/io/BinaryInput.h>
 #include <vsg/io/BinaryOutput.h>
 #include <vsg/io/Logger.h>
+#include <vsg/io/MemoryMappedFile.h>
 #include <vsg/io/VSG.h>
 #include <vsg/io/mem_stream.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/threading/OperationThreads.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <set>
 
 using namespace vsg;
 
@@ -54,6 +63,7 @@ VSG::FormatInfo VSG::readHeader(std::istream& fin) const
 
     const char* match_token_ascii = "#vsga";
     const char* match_token_binary = "#vsgb";
+    const char* match_token_binary_chunked = "#vsgc";
     char read_token[5];
     fin.read(read_token, 5);
 
@@ -62,6 +72,8 @@ VSG::FormatInfo VSG::readHeader(std::istream& fin) const
         type = ASCII;
     else if (std::strncmp(match_token_binary, read_token, 5) == 0)
         type = BINARY;
+    else if (std::strncmp(match_token_binary_chunked, read_token, 5) == 0)
+        type = BINARY_CHUNKED;
 
     if (type == NOT_RECOGNIZED)
     {
@@ -84,6 +96,8 @@ void VSG::writeHeader(std::ostream& fout, const FormatInfo& formatInfo) const
     fout.imbue(s_class_locale);
     if (formatInfo.first == BINARY)
         fout << "#vsgb";
+    else if (formatInfo.first == BINARY_CHUNKED)
+        fout << "#vsgc";
     else
         fout << "#vsga";
 
@@ -100,6 +114,39 @@ vsg::ref_ptr<vsg::Object> VSG::read(const vsg::Path& filename, ref_ptr<const Opt
     vsg::Path filenameToUse = findFile(filename, options);
     if (!filenameToUse) return {};
 
+    bool memoryMap = false;
+    if (options && options->getValue(VSG::memory_map, memoryMap) && memoryMap)
+    {
+        auto mappedFile = MemoryMappedFile::create(filenameToUse);
+        if (mappedFile->valid())
+        {
+            mem_stream fin(mappedFile->data(), mappedFile->size());
+
+            auto [type, version] = readHeader(fin);
+            if (type == BINARY)
+            {
+                vsg::BinaryInput input(fin, _objectFactory, options);
+                input.filename = filenameToUse;
+                input.version = version;
+                input.mappedFile = mappedFile;
+                return input.readObject("Root");
+            }
+            else if (type == BINARY_CHUNKED)
+            {
+                return readChunks(fin, version, mappedFile, filenameToUse, options);
+            }
+            else if (type == ASCII)
+            {
+                vsg::AsciiInput input(fin, _objectFactory, options);
+                input.filename = filenameToUse;
+                input.version = version;
+                return input.readObject("Root");
+            }
+
+            return {};
+        }
+    }
+
     std::ifstream fin(filenameToUse, std::ios::in | std::ios::binary);
     if (!fin) return {};
 
@@ -111,6 +158,10 @@ vsg::ref_ptr<vsg::Object> VSG::read(const vsg::Path& filename, ref_ptr<const Opt
         input.version = version;
         return input.readObject("Root");
     }
+    else if (type == BINARY_CHUNKED)
+    {
+        return readChunks(fin, version, {}, filenameToUse, options);
+    }
     else if (type == ASCII)
     {
         vsg::AsciiInput input(fin, _objectFactory, options);
@@ -136,6 +187,10 @@ vsg::ref_ptr<vsg::Object> VSG::read(std::istream& fin, vsg::ref_ptr<const vsg::O
         input.version = version;
         return input.readObject("Root");
     }
+    else if (type == BINARY_CHUNKED)
+    {
+        return readChunks(fin, version, {}, {}, options);
+    }
     else if (type == ASCII)
     {
         vsg::AsciiInput input(fin, _objectFactory, options);
@@ -175,6 +230,10 @@ bool VSG::write(const vsg::Object* object, const vsg::Path& filename, ref_ptr<co
     if (ext == ".vsgb")
     {
         std::ofstream fout(filename, std::ios::out | std::ios::binary);
+
+        bool chunkedFormat = false;
+        if (options && options->getValue(VSG::chunked, chunkedFormat) && chunkedFormat && writeChunks(object, fout, version, options)) return true;
+
         writeHeader(fout, FormatInfo{BINARY, version});
 
         vsg::BinaryOutput output(fout, options);
@@ -229,6 +288,9 @@ bool VSG::write(const vsg::Object* object, std::ostream& fout, ref_ptr<const Opt
     }
     else
     {
+        bool chunkedFormat = false;
+        if (options && options->getValue(VSG::chunked, chunkedFormat) && chunkedFormat && writeChunks(object, fout, version, options)) return true;
+
         writeHeader(fout, FormatInfo(BINARY, version));
 
         vsg::BinaryOutput output(fout, options);
@@ -242,5 +304,343 @@ bool VSG::getFeatures(Features& features) const
 {
     features.extensionFeatureMap[".vsgb"] = static_cast<FeatureMask>(READ_FILENAME | READ_ISTREAM | READ_MEMORY | WRITE_FILENAME | WRITE_OSTREAM);
     features.extensionFeatureMap[".vsgt"] = static_cast<FeatureMask>(READ_FILENAME | READ_ISTREAM | READ_MEMORY | WRITE_FILENAME | WRITE_OSTREAM);
+    features.optionNameTypeMap[VSG::memory_map] = type_name<bool>();
+    features.optionNameTypeMap[VSG::chunked] = type_name<bool>();
     return true;
 }
+
+/// entry in the chunk index of a BINARY_CHUNKED file, offsets are relative to the start of the header
+struct ChunkEntry
+{
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    uint32_t rootID = 0;
+};
+
+/// Output that writes nothing, used to find the objects that are referenced by more than one chunk so they can be placed in the shared chunk
+class CollectChunkReferences : public Output
+{
+public:
+    explicit CollectChunkReferences(ref_ptr<const Options> in_options) :
+        Output(in_options) {}
+
+    void writePropertyName(const char*) override {}
+    void writeEndOfLine() override {}
+
+    void write(size_t, const int8_t*) override {}
+    void write(size_t, const uint8_t*) override {}
+    void write(size_t, const int16_t*) override {}
+    void write(size_t, const uint16_t*) override {}
+    void write(size_t, const int32_t*) override {}
+    void write(size_t, const uint32_t*) override {}
+    void write(size_t, const int64_t*) override {}
+    void write(size_t, const uint64_t*) override {}
+    void write(size_t, const float*) override {}
+    void write(size_t, const double*) override {}
+    void write(size_t, const long double*) override {}
+    void write(size_t, const std::string*) override {}
+    void write(size_t, const std::wstring*) override {}
+    void write(size_t, const Path*) override {}
+
+    void write(const Object* object) override
+    {
+        if (!object || excluded.count(object) > 0) return;
+
+        if (auto [itr, inserted] = owners.emplace(object, owner); inserted)
+        {
+            // External::write() writes out its external files so don't traverse into it
+            if (!dynamic_cast<const External*>(object)) object->write(*this);
+        }
+        else if (itr->second != owner && itr->second != SHARED)
+        {
+            itr->second = SHARED;
+            shared.push_back(object);
+        }
+    }
+
+    static constexpr int ROOT = -1;
+    static constexpr int SHARED = -2;
+
+    int owner = ROOT;
+    std::set<const Object*> excluded;
+    std::unordered_map<const Object*, int> owners;
+    std::vector<const Object*> shared;
+};
+
+bool VSG::writeChunks(const vsg::Object* object, std::ostream& fout, const VsgVersion& version, vsg::ref_ptr<const vsg::Options> options) const
+{
+    auto group = dynamic_cast<const Group*>(object);
+    if (!group) return false;
+
+    auto headerPos = fout.tellp();
+    if (headerPos < 0) return false;
+
+    CollectChunkReferences collect(options);
+    collect.version = version;
+
+    // collect the objects referenced by the root, excluding its children
+    collect.excluded.insert(group->children.begin(), group->children.end());
+    collect.write(object);
+    collect.excluded.clear();
+
+    // collect the objects referenced by each child, children shared with the rest of the scene graph are placed in the shared chunk
+    std::set<const Node*> visitedChildren;
+    std::vector<const Node*> chunkRoots;
+    for (auto& child : group->children)
+    {
+        if (!child || !visitedChildren.insert(child).second) continue;
+
+        // child is already referenced from elsewhere in the scene graph
+        if (auto itr = collect.owners.find(child); itr != collect.owners.end())
+        {
+            if (itr->second != CollectChunkReferences::SHARED)
+            {
+                itr->second = CollectChunkReferences::SHARED;
+                collect.shared.push_back(child);
+            }
+            continue;
+        }
+
+        collect.owner = static_cast<int>(chunkRoots.size());
+        collect.write(child);
+        chunkRoots.push_back(child);
+    }
+
+    chunkRoots.erase(std::remove_if(chunkRoots.begin(), chunkRoots.end(), [&](const Node* child) { return collect.owners[child] == CollectChunkReferences::SHARED; }), chunkRoots.end());
+    if (chunkRoots.size() < 2) return false;
+
+    writeHeader(fout, FormatInfo(BINARY_CHUNKED, version));
+
+    // chunk 0 holds the shared objects, followed by a chunk for each child and lastly a chunk for the root
+    std::vector<ChunkEntry> chunks(chunkRoots.size() + 2);
+    uint32_t numChunks = static_cast<uint32_t>(chunks.size());
+    fout.write(reinterpret_cast<const char*>(&numChunks), sizeof(numChunks));
+
+    auto writeIndex = [&]() {
+        for (auto& chunk : chunks)
+        {
+            fout.write(reinterpret_cast<const char*>(&chunk.offset), sizeof(chunk.offset));
+            fout.write(reinterpret_cast<const char*>(&chunk.size), sizeof(chunk.size));
+            fout.write(reinterpret_cast<const char*>(&chunk.rootID), sizeof(chunk.rootID));
+        }
+    };
+
+    // write a placeholder index, to be filled in once the chunks have been written
+    auto indexPos = fout.tellp();
+    writeIndex();
+
+    auto beginChunk = [&](ChunkEntry& chunk) { chunk.offset = static_cast<uint64_t>(fout.tellp() - headerPos); };
+    auto endChunk = [&](ChunkEntry& chunk) { chunk.size = static_cast<uint64_t>(fout.tellp() - headerPos) - chunk.offset; };
+
+    Output::ObjectIDMap sharedObjectIDMap;
+    Output::ObjectID objectID = 0;
+    {
+        beginChunk(chunks.front());
+
+        vsg::BinaryOutput output(fout, options);
+        output.version = version;
+        output.writeValue<uint32_t>("NumObjects", collect.shared.size());
+        for (auto sharedObject : collect.shared)
+        {
+            output.write(sharedObject);
+        }
+
+        sharedObjectIDMap = output.objectIDMap;
+        objectID = output.objectID;
+
+        endChunk(chunks.front());
+    }
+
+    // ObjectIDs are unique across the chunks so that the root chunk can reference the chunk roots
+    Output::ObjectIDMap rootObjectIDMap = sharedObjectIDMap;
+    for (size_t i = 0; i < chunkRoots.size(); ++i)
+    {
+        auto& chunk = chunks[i + 1];
+        beginChunk(chunk);
+
+        vsg::BinaryOutput output(fout, options);
+        output.version = version;
+        output.objectIDMap = sharedObjectIDMap;
+        output.objectID = objectID;
+        output.writeObject("Root", chunkRoots[i]);
+
+        chunk.rootID = output.objectIDMap[chunkRoots[i]];
+        rootObjectIDMap[chunkRoots[i]] = chunk.rootID;
+        objectID = output.objectID;
+
+        endChunk(chunk);
+    }
+
+    {
+        beginChunk(chunks.back());
+
+        vsg::BinaryOutput output(fout, options);
+        output.version = version;
+        output.objectIDMap = rootObjectIDMap;
+        output.objectID = objectID;
+        output.writeObject("Root", object);
+
+        endChunk(chunks.back());
+    }
+
+    auto endPos = fout.tellp();
+    fout.seekp(indexPos);
+    writeIndex();
+    fout.seekp(endPos);
+
+    return fout.good();
+}
+
+vsg::ref_ptr<vsg::Object> VSG::readChunks(std::istream& fin, const VsgVersion& version, ref_ptr<MemoryMappedFile> mappedFile, const vsg::Path& filename, vsg::ref_ptr<const vsg::Options> options) const
+{
+    // size of the stream when it can be determined, used to reject corrupt index entries before allocating memory for them
+    uint64_t streamSize = std::numeric_limits<uint64_t>::max();
+    if (mappedFile)
+    {
+        streamSize = mappedFile->size();
+    }
+    else if (auto indexPos = fin.tellg(); indexPos >= 0)
+    {
+        fin.seekg(0, std::ios::end);
+        auto endPos = fin.tellg();
+        fin.clear();
+        fin.seekg(indexPos);
+        if (endPos >= indexPos) streamSize = static_cast<uint64_t>(endPos);
+    }
+
+    auto remaining = [&]() -> uint64_t {
+        auto pos = fin.tellg();
+        if (streamSize == std::numeric_limits<uint64_t>::max() || pos < 0) return streamSize;
+        return streamSize > static_cast<uint64_t>(pos) ? streamSize - static_cast<uint64_t>(pos) : 0;
+    };
+
+    uint32_t numChunks = 0;
+    fin.read(reinterpret_cast<char*>(&numChunks), sizeof(numChunks));
+    if (!fin || numChunks < 2) return {};
+
+    const uint64_t chunkEntrySize = sizeof(ChunkEntry::offset) + sizeof(ChunkEntry::size) + sizeof(ChunkEntry::rootID);
+    if (static_cast<uint64_t>(numChunks) > remaining() / chunkEntrySize) return {};
+
+    // entries are appended as they are read so a stream of unknown size that ends early doesn't result in a large allocation
+    std::vector<ChunkEntry> chunks;
+    chunks.reserve(std::min<uint32_t>(numChunks, 4096));
+    for (uint32_t i = 0; i < numChunks; ++i)
+    {
+        ChunkEntry chunk;
+        fin.read(reinterpret_cast<char*>(&chunk.offset), sizeof(chunk.offset));
+        fin.read(reinterpret_cast<char*>(&chunk.size), sizeof(chunk.size));
+        fin.read(reinterpret_cast<char*>(&chunk.rootID), sizeof(chunk.rootID));
+        if (!fin) return {};
+        chunks.push_back(chunk);
+    }
+
+    // when neither a memory mapped file or filename is available the chunks are read into memory, the chunks directly follow the index
+    bool readIntoBuffer = !mappedFile && !filename;
+    uint64_t bufferOffset = readIntoBuffer ? chunks.front().offset : 0;
+    uint64_t dataSize = readIntoBuffer ? remaining() : streamSize;
+
+    // every chunk must lie within the file, or within the data following the index when reading into memory
+    uint64_t bufferSize = 0;
+    for (auto& chunk : chunks)
+    {
+        if (chunk.offset < bufferOffset) return {};
+        uint64_t begin = chunk.offset - bufferOffset;
+        if (begin > dataSize || chunk.size > dataSize - begin) return {};
+        bufferSize = std::max(bufferSize, begin + chunk.size);
+    }
+
+    std::vector<uint8_t> buffer;
+    if (readIntoBuffer)
+    {
+        // read in blocks so that a stream of unknown size that ends early doesn't result in a large allocation
+        const uint64_t blockSize = 1 << 24;
+        while (buffer.size() < bufferSize)
+        {
+            size_t pos = buffer.size();
+            buffer.resize(static_cast<size_t>(std::min(bufferSize, pos + blockSize)));
+            fin.read(reinterpret_cast<char*>(buffer.data() + pos), buffer.size() - pos);
+            if (!fin) return {};
+        }
+    }
+
+    // decode a chunk using an ObjectIDMap seeded with the objects it references from other chunks, returning the resulting ObjectIDMap
+    auto readChunk = [&](const ChunkEntry& chunk, Input::ObjectIDMap objectIDMap, auto readObjects) -> Input::ObjectIDMap {
+        std::vector<uint8_t> data;
+        const uint8_t* ptr = nullptr;
+        size_t size = 0;
+        uint64_t pos = 0;
+        if (mappedFile)
+        {
+            // use the whole file so that positions, and hence array alignment, are relative to the start of the mapped file
+            ptr = mappedFile->data();
+            size = mappedFile->size();
+            pos = chunk.offset;
+        }
+        else if (readIntoBuffer)
+        {
+            ptr = buffer.data() + (chunk.offset - bufferOffset);
+            size = static_cast<size_t>(chunk.size);
+        }
+        else
+        {
+            std::ifstream chunk_fin(filename, std::ios::in | std::ios::binary);
+            chunk_fin.seekg(static_cast<std::streamoff>(chunk.offset));
+            data.resize(static_cast<size_t>(chunk.size));
+            chunk_fin.read(reinterpret_cast<char*>(data.data()), data.size());
+            if (!chunk_fin) return {};
+            ptr = data.data();
+            size = data.size();
+        }
+
+        mem_stream chunk_stream(ptr, size);
+        if (pos > 0) chunk_stream.seekg(static_cast<std::streamoff>(pos));
+
+        vsg::BinaryInput input(chunk_stream, _objectFactory, options);
+        input.filename = filename;
+        input.version = version;
+        input.mappedFile = mappedFile;
+        input.objectIDMap = std::move(objectIDMap);
+        readObjects(input);
+        return std::move(input.objectIDMap);
+    };
+
+    Input::ObjectIDMap nullObjectIDMap;
+    nullObjectIDMap[0] = nullptr;
+
+    auto sharedObjectIDMap = readChunk(chunks.front(), nullObjectIDMap, [](BinaryInput& input) {
+        uint32_t numObjects = input.readValue<uint32_t>("NumObjects");
+        for (uint32_t i = 0; i < numObjects; ++i) input.read();
+    });
+
+    // decode the chunks for each child of the root group, in parallel when operationThreads are available
+    size_t numChunkRoots = chunks.size() - 2;
+    std::vector<ref_ptr<Object>> chunkRoots(numChunkRoots);
+    auto readChunkRoot = [&](size_t i) {
+        readChunk(chunks[i + 1], sharedObjectIDMap, [&](BinaryInput& input) { chunkRoots[i] = input.readObject("Root"); });
+    };
+
+    ref_ptr<OperationThreads> operationThreads;
+    if (options) operationThreads = options->operationThreads;
+
+    if (operationThreads && numChunkRoots > 1)
+    {
+        operationThreads->parallel_for(0, numChunkRoots, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) readChunkRoot(i);
+        }, 1);
+    }
+    else
+    {
+        for (size_t i = 0; i < numChunkRoots; ++i) readChunkRoot(i);
+    }
+
+    // decode the root, resolving its children from the shared objects and chunk roots
+    auto rootObjectIDMap = std::move(sharedObjectIDMap);
+    for (size_t i = 0; i < numChunkRoots; ++i)
+    {
+        rootObjectIDMap[chunks[i + 1].rootID] = chunkRoots[i];
+    }
+
+    ref_ptr<Object> root;
+    readChunk(chunks.back(), std::move(rootObjectIDMap), [&](BinaryInput& input) { root = input.readObject("Root"); });
+    return root;
+}
@@ -0,0 +1,291 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/lighting/LightClusters.h>
+#include <vsg/maths/transform.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace vsg;
+
+namespace
+{
+    uint32_t floatBits(double value)
+    {
+        float f = static_cast<float>(value);
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    // project a normalized device coordinate to eye coordinates
+    dvec3 unproject(const dmat4& inverseProjection, double x, double y, double z)
+    {
+        auto v = inverseProjection * dvec4(x, y, z, 1.0);
+        return v.xyz / v.w;
+    }
+
+    // eye coordinate position of the point at the specified depth along the ray through the start and end points
+    dvec3 pointAtDepth(const dvec3& start, const dvec3& end, double depth)
+    {
+        double dz = end.z - start.z;
+        if (dz == 0.0) return start;
+
+        double t = (-depth - start.z) / dz;
+        return start + (end - start) * t;
+    }
+} // namespace
+
+LightClusters::LightClusters(const uivec3& in_dimensions, uint32_t in_maxLightIndices) :
+    dimensions(in_dimensions),
+    maxLightIndices(in_maxLightIndices)
+{
+    clusterData = uintArray::create(headerSize + 2 * numClusters() + maxLightIndices, 0u);
+    clusterData->setValue("name", "lightClusters");
+    clusterData->properties.dataVariance = DYNAMIC_DATA_TRANSFER_AFTER_RECORD;
+
+    _clusterLights.resize(numClusters());
+}
+
+LightClusters::~LightClusters()
+{
+}
+
+double LightClusters::lightRange(const vec3& color, float intensity) const
+{
+    double brightness = static_cast<double>(std::max(color.r, std::max(color.g, color.b)) * intensity);
+    if (brightness <= 0.0) return 0.0;
+    return std::sqrt(brightness / intensityCutoff);
+}
+
+void LightClusters::clear()
+{
+    _lights.clear();
+}
+
+void LightClusters::setProjection(const dmat4& projectionMatrix, double nearDistance, double farDistance)
+{
+    // exponential depth slicing requires a positive near distance and a finite far distance
+    if (!(nearDistance > 0.0)) nearDistance = std::max(farDistance, 1.0) / maxFarNearRatio;
+    if (!(farDistance > nearDistance)) farDistance = nearDistance * 2.0;
+    if (farDistance > nearDistance * maxFarNearRatio) farDistance = nearDistance * maxFarNearRatio;
+
+    if (!_clusterBounds.empty() && projectionMatrix == _projectionMatrix && nearDistance == _nearDistance && farDistance == _farDistance) return;
+
+    _projectionMatrix = projectionMatrix;
+    _nearDistance = nearDistance;
+    _farDistance = farDistance;
+
+    _sliceDepths.resize(dimensions.z + 1);
+    for (uint32_t k = 0; k <= dimensions.z; ++k)
+    {
+        _sliceDepths[k] = nearDistance * std::pow(farDistance / nearDistance, static_cast<double>(k) / static_cast<double>(dimensions.z));
+    }
+
+    // rays through the corners of the tiles
+    auto inverseProjection = inverse(projectionMatrix);
+    std::vector<std::pair<dvec3, dvec3>> rays((dimensions.x + 1) * (dimensions.y + 1));
+    for (uint32_t j = 0; j <= dimensions.y; ++j)
+    {
+        double y = -1.0 + 2.0 * static_cast<double>(j) / static_cast<double>(dimensions.y);
+        for (uint32_t i = 0; i <= dimensions.x; ++i)
+        {
+            double x = -1.0 + 2.0 * static_cast<double>(i) / static_cast<double>(dimensions.x);
+            rays[j * (dimensions.x + 1) + i] = {unproject(inverseProjection, x, y, 1.0), unproject(inverseProjection, x, y, 0.5)};
+        }
+    }
+
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    _clusterBounds.resize(numClusters());
+    _columnRanges.assign(dimensions.z * dimensions.x, dvec2(infinity, -infinity));
+    _rowRanges.assign(dimensions.z * dimensions.y, dvec2(infinity, -infinity));
+
+    for (uint32_t k = 0; k < dimensions.z; ++k)
+    {
+        bool lastSlice = (k + 1) == dimensions.z;
+        double nearDepth = _sliceDepths[k];
+        double farDepth = _sliceDepths[k + 1];
+
+        for (uint32_t j = 0; j < dimensions.y; ++j)
+        {
+            for (uint32_t i = 0; i < dimensions.x; ++i)
+            {
+                dbox bound;
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    const auto& [start, end] = rays[(j + c / 2) * (dimensions.x + 1) + i + (c % 2)];
+                    bound.add(pointAtDepth(start, end, nearDepth));
+                    bound.add(pointAtDepth(start, end, farDepth));
+                }
+
+                if (lastSlice)
+                {
+                    // extend the last slice to infinity so that lights beyond farDistance are still assigned
+                    bound.min.set(-infinity, -infinity, -infinity);
+                    bound.max.x = infinity;
+                    bound.max.y = infinity;
+                }
+
+                _clusterBounds[(k * dimensions.y + j) * dimensions.x + i] = bound;
+
+                auto& column = _columnRanges[k * dimensions.x + i];
+                column.x = std::min(column.x, bound.min.x);
+                column.y = std::max(column.y, bound.max.x);
+
+                auto& row = _rowRanges[k * dimensions.y + j];
+                row.x = std::min(row.x, bound.min.y);
+                row.y = std::max(row.y, bound.max.y);
+            }
+        }
+    }
+}
+
+bool LightClusters::intersects(const dsphere& bound, uint32_t cluster) const
+{
+    const auto& box = _clusterBounds[cluster];
+
+    double distance2 = 0.0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        double v = bound.center[axis];
+        if (v < box.min[axis])
+            distance2 += (box.min[axis] - v) * (box.min[axis] - v);
+        else if (v > box.max[axis])
+            distance2 += (v - box.max[axis]) * (v - box.max[axis]);
+    }
+    return distance2 <= bound.radius * bound.radius;
+}
+
+void LightClusters::_assignSlice(uint32_t k)
+{
+    uint32_t firstCluster = k * dimensions.y * dimensions.x;
+    for (uint32_t c = 0; c < dimensions.y * dimensions.x; ++c)
+    {
+        _clusterLights[firstCluster + c].clear();
+    }
+
+    bool lastSlice = (k + 1) == dimensions.z;
+    double sliceMaxZ = -_sliceDepths[k];
+    double sliceMinZ = lastSlice ? -std::numeric_limits<double>::infinity() : -_sliceDepths[k + 1];
+
+    const dvec2* columns = _columnRanges.data() + k * dimensions.x;
+    const dvec2* rows = _rowRanges.data() + k * dimensions.y;
+
+    for (const auto& light : _lights)
+    {
+        const auto& center = light.bound.center;
+        double radius = light.bound.radius;
+
+        if ((center.z - radius) > sliceMaxZ || (center.z + radius) < sliceMinZ) continue;
+
+        // only the clusters within the columns and rows that overlap the light's bounds can intersect it
+        for (uint32_t j = 0; j < dimensions.y; ++j)
+        {
+            if ((center.y + radius) < rows[j].x || (center.y - radius) > rows[j].y) continue;
+
+            for (uint32_t i = 0; i < dimensions.x; ++i)
+            {
+                if ((center.x + radius) < columns[i].x || (center.x - radius) > columns[i].y) continue;
+
+                uint32_t cluster = firstCluster + j * dimensions.x + i;
+                if (intersects(light.bound, cluster)) _clusterLights[cluster].push_back(light.index);
+            }
+        }
+    }
+}
+
+bool LightClusters::assign()
+{
+    if (_clusterBounds.empty()) return false;
+
+    if (operationThreads && dimensions.z > 1 && !_lights.empty())
+    {
+        operationThreads->parallel_for(
+            0, dimensions.z, [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k) _assignSlice(static_cast<uint32_t>(k));
+            },
+            1);
+    }
+    else
+    {
+        for (uint32_t k = 0; k < dimensions.z; ++k) _assignSlice(k);
+    }
+
+    // pack the header, cluster ranges and light indices into clusterData, tracking the span of changed values within each
+    // of these regions so only those spans are marked as modified and need to be transferred to the GPU
+    struct ChangedSpan
+    {
+        size_t begin = std::numeric_limits<size_t>::max();
+        size_t end = 0;
+    };
+    enum Region
+    {
+        HEADER,
+        CLUSTER_RANGES,
+        LIGHT_INDICES,
+        NUM_REGIONS
+    };
+    ChangedSpan changedSpans[NUM_REGIONS];
+
+    uint32_t numChanges = 0;
+    auto data = clusterData->data();
+    auto assignValue = [&](Region region, size_t index, uint32_t value) {
+        if (data[index] != value)
+        {
+            data[index] = value;
+            ++numChanges;
+
+            auto& span = changedSpans[region];
+            span.begin = std::min(span.begin, index);
+            span.end = std::max(span.end, index + 1);
+        }
+    };
+
+    double sliceScale = static_cast<double>(dimensions.z) / std::log(_farDistance / _nearDistance);
+
+    uint32_t numIndices = 0;
+    size_t rangeIndex = headerSize;
+    size_t lightIndex = headerSize + 2 * numClusters();
+    for (auto& clusterLights : _clusterLights)
+    {
+        // indices beyond maxLightIndices are dropped
+        uint32_t count = std::min(static_cast<uint32_t>(clusterLights.size()), maxLightIndices - numIndices);
+
+        assignValue(CLUSTER_RANGES, rangeIndex++, numIndices);
+        assignValue(CLUSTER_RANGES, rangeIndex++, count);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            assignValue(LIGHT_INDICES, lightIndex++, clusterLights[i]);
+        }
+        numIndices += count;
+    }
+
+    assignValue(HEADER, 0, dimensions.x);
+    assignValue(HEADER, 1, dimensions.y);
+    assignValue(HEADER, 2, dimensions.z);
+    assignValue(HEADER, 3, numIndices);
+    assignValue(HEADER, 4, floatBits(_nearDistance));
+    assignValue(HEADER, 5, floatBits(_farDistance));
+    assignValue(HEADER, 6, floatBits(sliceScale));
+    assignValue(HEADER, 7, floatBits(-std::log(_nearDistance) * sliceScale));
+
+    for (auto& span : changedSpans)
+    {
+        if (span.begin < span.end) clusterData->dirty(span.begin * sizeof(uint32_t), (span.end - span.begin) * sizeof(uint32_t));
+    }
+
+    return numChanges > 0;
+}
@@ -0,0 +1,109 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/maths/intersect.h>
+
+#if defined(__AVX__)
+#    include <immintrin.h>
+#    define VSG_INTERSECT_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define VSG_INTERSECT_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define VSG_INTERSECT_NEON 1
+#endif
+
+using namespace vsg;
+
+void vsg::intersect(const dplane* planes, size_t numPlanes, const dsphere* spheres, size_t numSpheres, uint8_t* results)
+{
+    size_t i = 0;
+
+    // distances are computed as ((nx * x + ny * y) + nz * z) + p so that the results match the scalar distance(plane, vec3)
+#if defined(VSG_INTERSECT_AVX)
+    for (; i + 4 <= numSpheres; i += 4)
+    {
+        const dsphere* s = spheres + i;
+        __m256d x = _mm256_set_pd(s[3].x, s[2].x, s[1].x, s[0].x);
+        __m256d y = _mm256_set_pd(s[3].y, s[2].y, s[1].y, s[0].y);
+        __m256d z = _mm256_set_pd(s[3].z, s[2].z, s[1].z, s[0].z);
+        __m256d negative_radius = _mm256_set_pd(-s[3].r, -s[2].r, -s[1].r, -s[0].r);
+        __m256d visible = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+        for (const dplane* plane = planes; plane != planes + numPlanes; ++plane)
+        {
+            __m256d d = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(plane->n.x), x), _mm256_mul_pd(_mm256_set1_pd(plane->n.y), y));
+            d = _mm256_add_pd(d, _mm256_mul_pd(_mm256_set1_pd(plane->n.z), z));
+            d = _mm256_add_pd(d, _mm256_set1_pd(plane->p));
+            visible = _mm256_andnot_pd(_mm256_cmp_pd(d, negative_radius, _CMP_LT_OQ), visible);
+            if (_mm256_movemask_pd(visible) == 0) break;
+        }
+
+        int mask = _mm256_movemask_pd(visible);
+        results[i] = static_cast<uint8_t>(mask & 1);
+        results[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+        results[i + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+        results[i + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+    }
+#elif defined(VSG_INTERSECT_SSE2)
+    for (; i + 2 <= numSpheres; i += 2)
+    {
+        const dsphere* s = spheres + i;
+        __m128d x = _mm_set_pd(s[1].x, s[0].x);
+        __m128d y = _mm_set_pd(s[1].y, s[0].y);
+        __m128d z = _mm_set_pd(s[1].z, s[0].z);
+        __m128d negative_radius = _mm_set_pd(-s[1].r, -s[0].r);
+        __m128d visible = _mm_castsi128_pd(_mm_set1_epi32(-1));
+
+        for (const dplane* plane = planes; plane != planes + numPlanes; ++plane)
+        {
+            __m128d d = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(plane->n.x), x), _mm_mul_pd(_mm_set1_pd(plane->n.y), y));
+            d = _mm_add_pd(d, _mm_mul_pd(_mm_set1_pd(plane->n.z), z));
+            d = _mm_add_pd(d, _mm_set1_pd(plane->p));
+            visible = _mm_andnot_pd(_mm_cmplt_pd(d, negative_radius), visible);
+            if (_mm_movemask_pd(visible) == 0) break;
+        }
+
+        int mask = _mm_movemask_pd(visible);
+        results[i] = static_cast<uint8_t>(mask & 1);
+        results[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+    }
+#elif defined(VSG_INTERSECT_NEON)
+    for (; i + 2 <= numSpheres; i += 2)
+    {
+        const dsphere* s = spheres + i;
+        float64x2_t x = {s[0].x, s[1].x};
+        float64x2_t y = {s[0].y, s[1].y};
+        float64x2_t z = {s[0].z, s[1].z};
+        float64x2_t negative_radius = {-s[0].r, -s[1].r};
+        uint64x2_t visible = vdupq_n_u64(~uint64_t(0));
+
+        for (const dplane* plane = planes; plane != planes + numPlanes; ++plane)
+        {
+            float64x2_t d = vaddq_f64(vmulq_f64(vdupq_n_f64(plane->n.x), x), vmulq_f64(vdupq_n_f64(plane->n.y), y));
+            d = vaddq_f64(d, vmulq_f64(vdupq_n_f64(plane->n.z), z));
+            d = vaddq_f64(d, vdupq_n_f64(plane->p));
+            visible = vbicq_u64(visible, vcltq_f64(d, negative_radius));
+            if ((vgetq_lane_u64(visible, 0) | vgetq_lane_u64(visible, 1)) == 0) break;
+        }
+
+        results[i] = vgetq_lane_u64(visible, 0) != 0 ? 1 : 0;
+        results[i + 1] = vgetq_lane_u64(visible, 1) != 0 ? 1 : 0;
+    }
+#endif
+
+    for (; i < numSpheres; ++i)
+    {
+        results[i] = intersect(planes, planes + numPlanes, spheres[i]) ? 1 : 0;
+    }
+}
@@ -0,0 +1,181 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2018 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/Output.h>
+#include <vsg/nodes/BakedSubgraph.h>
+
+using namespace vsg;
+
+BakedSubgraph::BakedSubgraph()
+{
+}
+
+BakedSubgraph::BakedSubgraph(const BakedSubgraph& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    instructions(rhs.instructions),
+    bounds(rhs.bounds),
+    matrices(rhs.matrices),
+    stateCommands(copyop(rhs.stateCommands)),
+    commands(copyop(rhs.commands)),
+    nodes(copyop(rhs.nodes)),
+    subgraph(copyop(rhs.subgraph))
+{
+}
+
+BakedSubgraph::~BakedSubgraph()
+{
+}
+
+int BakedSubgraph::compare(const Object& rhs_object) const
+{
+    int result = Node::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_value_container(instructions, rhs.instructions))) return result;
+    if ((result = compare_value_container(bounds, rhs.bounds))) return result;
+    if ((result = compare_value_container(matrices, rhs.matrices))) return result;
+    if ((result = compare_pointer_container(stateCommands, rhs.stateCommands))) return result;
+    if ((result = compare_pointer_container(commands, rhs.commands))) return result;
+    if ((result = compare_pointer_container(nodes, rhs.nodes))) return result;
+    return compare_pointer(subgraph, rhs.subgraph);
+}
+
+bool BakedSubgraph::validate() const
+{
+    struct Scope
+    {
+        Opcode opcode;
+        uint32_t first;
+        uint32_t count;
+        size_t end; // last instruction culled by a CULL
+    };
+
+    std::vector<Scope> scopes;
+    std::vector<size_t> cullScopes;
+
+    auto inRange = [](uint32_t first, uint32_t count, size_t size) { return static_cast<uint64_t>(first) + count <= size; };
+    auto assigned = [](const auto& objects, uint32_t first, uint32_t count) {
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            if (!objects[i]) return false;
+        }
+        return true;
+    };
+
+    size_t numInstructions = instructions.size();
+    for (size_t i = 0; i <= numInstructions; ++i)
+    {
+        // close the CULL ranges that end before this instruction, any matrix or state pushed within them must have been popped
+        while (!cullScopes.empty() && scopes[cullScopes.back()].end < i)
+        {
+            if (cullScopes.back() != scopes.size() - 1) return false;
+            scopes.pop_back();
+            cullScopes.pop_back();
+        }
+
+        if (i == numInstructions) break;
+
+        const auto& instruction = instructions[i];
+        switch (instruction.opcode)
+        {
+        case (CULL): {
+            size_t end = i + instruction.count;
+            if (instruction.first >= bounds.size() || end >= numInstructions) return false;
+            if (!cullScopes.empty() && end > scopes[cullScopes.back()].end) return false;
+            cullScopes.push_back(scopes.size());
+            scopes.push_back(Scope{CULL, instruction.first, instruction.count, end});
+            break;
+        }
+        case (PUSH_MATRIX):
+        case (PUSH_MATRIX_AND_FRUSTUM):
+            if (instruction.first >= matrices.size()) return false;
+            scopes.push_back(Scope{instruction.opcode, instruction.first, 0, 0});
+            break;
+        case (POP_MATRIX):
+        case (POP_MATRIX_AND_FRUSTUM): {
+            auto pushOpcode = (instruction.opcode == POP_MATRIX) ? PUSH_MATRIX : PUSH_MATRIX_AND_FRUSTUM;
+            if (scopes.empty() || scopes.back().opcode != pushOpcode) return false;
+            scopes.pop_back();
+            break;
+        }
+        case (PUSH_STATE):
+            if (!inRange(instruction.first, instruction.count, stateCommands.size()) || !assigned(stateCommands, instruction.first, instruction.count)) return false;
+            scopes.push_back(Scope{PUSH_STATE, instruction.first, instruction.count, 0});
+            break;
+        case (POP_STATE):
+            if (scopes.empty() || scopes.back().opcode != PUSH_STATE || scopes.back().first != instruction.first || scopes.back().count != instruction.count) return false;
+            scopes.pop_back();
+            break;
+        case (DRAW):
+            if (!inRange(instruction.first, instruction.count, commands.size()) || !assigned(commands, instruction.first, instruction.count)) return false;
+            break;
+        case (NODE):
+            if (!inRange(instruction.first, 1, nodes.size()) || !assigned(nodes, instruction.first, 1)) return false;
+            break;
+        default:
+            return false;
+        }
+    }
+
+    return scopes.empty();
+}
+
+void BakedSubgraph::read(Input& input)
+{
+    Node::read(input);
+
+    instructions.resize(input.readValue<uint32_t>("instructions"));
+    for (auto& instruction : instructions)
+    {
+        instruction.opcode = static_cast<Opcode>(input.readValue<uint32_t>("instruction.opcode"));
+        input.read("instruction.first", instruction.first);
+        input.read("instruction.count", instruction.count);
+    }
+
+    input.readValues("bounds", bounds);
+    input.readValues("matrices", matrices);
+    input.readObjects("stateCommands", stateCommands);
+    input.readObjects("commands", commands);
+    input.readObjects("nodes", nodes);
+    input.read("subgraph", subgraph);
+
+    if (!validate())
+    {
+        warn("BakedSubgraph::read() invalid instructions, recording the original subgraph instead.");
+        instructions.clear();
+    }
+}
+
+void BakedSubgraph::write(Output& output) const
+{
+    Node::write(output);
+
+    output.writeValue<uint32_t>("instructions", instructions.size());
+    for (auto& instruction : instructions)
+    {
+        output.writeValue<uint32_t>("instruction.opcode", instruction.opcode);
+        output.write("instruction.first", instruction.first);
+        output.write("instruction.count", instruction.count);
+    }
+
+    output.writeValues("bounds", bounds);
+    output.writeValues("matrices", matrices);
+    output.writeObjects("stateCommands", stateCommands);
+    output.writeObjects("commands", commands);
+    output.writeObjects("nodes", nodes);
+    output.write("subgraph", subgraph);
+}
@@ -58,12 +58,16 @@ void Bin::clear()
 }
 
 void Bin::add(State* state, double value, const Node* node)
+{
+    add(state, state->modelviewMatrixStack.top(), value, node);
+}
+
+void Bin::add(State* state, const dmat4& mv, double value, const Node* node)
 {
     //debug("Bin::add(state= ", state, ", value = ", value, ", ", node, ") ", this, ", binNumber = ", binNumber, ",  binElements.size()=", _binElements.size());
 
     Element element;
 
-    const auto& mv = state->modelviewMatrixStack.top();
 #if 1
     if (_matrices.empty())
     {
@@ -106,6 +110,30 @@ void Bin::add(State* state, double value, const Node* node)
     _elements.push_back(element);
 }
 
+void Bin::add(const Bin& bin)
+{
+    auto matrixOffset = static_cast<uint32_t>(_matrices.size());
+    auto stateCommandOffset = static_cast<uint32_t>(_stateCommands.size());
+    auto elementOffset = static_cast<uint32_t>(_elements.size());
+
+    _matrices.insert(_matrices.end(), bin._matrices.begin(), bin._matrices.end());
+    _stateCommands.insert(_stateCommands.end(), bin._stateCommands.begin(), bin._stateCommands.end());
+
+    _elements.reserve(_elements.size() + bin._elements.size());
+    for (auto element : bin._elements)
+    {
+        element.matrixIndex += matrixOffset;
+        element.stateCommandIndex += stateCommandOffset;
+        _elements.push_back(element);
+    }
+
+    _binElements.reserve(_binElements.size() + bin._binElements.size());
+    for (const auto& [value, index] : bin._binElements)
+    {
+        _binElements.emplace_back(value, index + elementOffset);
+    }
+}
+
 void Bin::traverse(RecordTraversal& rt) const
 {
     //debug("Bin::traverse(RecordTraversal& visitor) ", sortOrder, " ", _binElements.size());
@@ -0,0 +1,309 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/nodes/InstanceCulling.h>
+#include <vsg/nodes/InstanceNode.h>
+#include <vsg/utils/ComputeBounds.h>
+#include <vsg/vk/ResourceRequirements.h>
+#include <vsg/vk/State.h>
+
+#include <cstring>
+
+using namespace vsg;
+
+namespace
+{
+    // copy of the array elements of visible instances from the source array to the compacted array of one LOD level
+    struct CompactArray
+    {
+        const uint8_t* source = nullptr;
+        size_t sourceStride = 0;
+        uint8_t* destination = nullptr;
+        size_t valueSize = 0;
+
+        CompactArray() = default;
+
+        CompactArray(const ref_ptr<BufferInfo>& sourceBufferInfo, const ref_ptr<BufferInfo>& destinationBufferInfo)
+        {
+            if (!sourceBufferInfo || !sourceBufferInfo->data || !destinationBufferInfo || !destinationBufferInfo->data) return;
+
+            source = static_cast<const uint8_t*>(sourceBufferInfo->data->dataPointer(0));
+            sourceStride = sourceBufferInfo->data->stride();
+            destination = static_cast<uint8_t*>(destinationBufferInfo->data->dataPointer(0));
+            valueSize = destinationBufferInfo->data->valueSize();
+        }
+
+        inline void copy(size_t sourceIndex, size_t destinationIndex) const
+        {
+            if (destination) std::memcpy(destination + destinationIndex * valueSize, source + sourceIndex * sourceStride, valueSize);
+        }
+    };
+
+    ref_ptr<BufferInfo> createCompactedArray(const ref_ptr<BufferInfo>& bufferInfo, ResourceRequirements& requirements)
+    {
+        if (!bufferInfo || !bufferInfo->data) return {};
+
+        auto data = bufferInfo->data->clone().cast<Data>();
+        if (!data) return {};
+
+        // the cloned array is tightly packed so reset any stride inherited from the source array
+        data->properties.stride = static_cast<uint32_t>(data->valueSize());
+        data->properties.dataVariance = DYNAMIC_DATA_TRANSFER_AFTER_RECORD;
+
+        auto compactedBufferInfo = BufferInfo::create(data);
+        requirements.dynamicData.bufferInfos.push_back(compactedBufferInfo);
+        return compactedBufferInfo;
+    }
+} // namespace
+
+InstanceCulling::InstanceCulling()
+{
+}
+
+InstanceCulling::InstanceCulling(const InstanceCulling& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    bound(rhs.bound),
+    operationThreads(rhs.operationThreads),
+    grainSize(rhs.grainSize)
+{
+    lodChildren.reserve(rhs.lodChildren.size());
+    for (auto& child : rhs.lodChildren)
+    {
+        lodChildren.push_back(LODChild{child.minimumScreenHeightRatio, copyop(child.node)});
+    }
+}
+
+InstanceCulling::~InstanceCulling()
+{
+}
+
+int InstanceCulling::compare(const Object& rhs_object) const
+{
+    int result = Object::compare(rhs_object);
+    if (result != 0) return result;
+
+    auto& rhs = static_cast<decltype(*this)>(rhs_object);
+
+    if ((result = compare_value(bound, rhs.bound)) != 0) return result;
+    if ((result = compare_value(grainSize, rhs.grainSize)) != 0) return result;
+
+    if (lodChildren.size() < rhs.lodChildren.size()) return -1;
+    if (lodChildren.size() > rhs.lodChildren.size()) return 1;
+
+    auto rhs_itr = rhs.lodChildren.begin();
+    for (auto lhs_itr = lodChildren.begin(); lhs_itr != lodChildren.end(); ++lhs_itr, ++rhs_itr)
+    {
+        if ((result = compare_value(lhs_itr->minimumScreenHeightRatio, rhs_itr->minimumScreenHeightRatio)) != 0) return result;
+        if ((result = compare_pointer(lhs_itr->node, rhs_itr->node)) != 0) return result;
+    }
+    return 0;
+}
+
+void InstanceCulling::read(Input& input)
+{
+    Object::read(input);
+
+    input.read("bound", bound);
+    input.read("grainSize", grainSize);
+
+    lodChildren.resize(input.readValue<uint32_t>("lodChildren"));
+    for (auto& child : lodChildren)
+    {
+        input.read("child.minimumScreenHeightRatio", child.minimumScreenHeightRatio);
+        input.read("child.node", child.node);
+    }
+}
+
+void InstanceCulling::write(Output& output) const
+{
+    Object::write(output);
+
+    output.write("bound", bound);
+    output.write("grainSize", grainSize);
+
+    output.writeValue<uint32_t>("lodChildren", lodChildren.size());
+    for (auto& child : lodChildren)
+    {
+        output.write("child.minimumScreenHeightRatio", child.minimumScreenHeightRatio);
+        output.write("child.node", child.node);
+    }
+}
+
+void InstanceCulling::init(const InstanceNode& instanceNode, ResourceRequirements& requirements)
+{
+    if (!bound.valid())
+    {
+        // compute the bound of a single untransformed instance, so InstanceDraw/InstanceDrawIndexed are given an InstanceNode without per instance arrays
+        auto prototype = InstanceNode::create();
+        prototype->instanceCount = 1;
+
+        auto computeBounds = ComputeBounds::create();
+        computeBounds->instanceNode = prototype.get();
+        if (instanceNode.child) instanceNode.child->accept(*computeBounds);
+        for (auto& lodChild : lodChildren)
+        {
+            if (lodChild.node) lodChild.node->accept(*computeBounds);
+        }
+
+        auto& bb = computeBounds->bounds;
+        if (bb.valid()) bound.set((bb.min + bb.max) * 0.5, length(bb.max - bb.min) * 0.5);
+    }
+
+    size_t numLevels = lodChildren.empty() ? 1 : std::min(lodChildren.size(), size_t(255));
+
+    culledInstanceNodes.clear();
+    culledInstanceNodes.reserve(numLevels);
+    for (size_t level = 0; level < numLevels; ++level)
+    {
+        auto culledInstanceNode = InstanceNode::create();
+        culledInstanceNode->firstInstance = 0;
+        culledInstanceNode->instanceCount = 0;
+        culledInstanceNode->colors = createCompactedArray(instanceNode.colors, requirements);
+        culledInstanceNode->translations = createCompactedArray(instanceNode.translations, requirements);
+        culledInstanceNode->rotations = createCompactedArray(instanceNode.rotations, requirements);
+        culledInstanceNode->scales = createCompactedArray(instanceNode.scales, requirements);
+        culledInstanceNode->child = lodChildren.empty() ? instanceNode.child : lodChildren[level].node;
+        culledInstanceNodes.push_back(culledInstanceNode);
+    }
+
+    _capacity = instanceNode.instanceCount;
+}
+
+bool InstanceCulling::cullView(uint32_t in_viewID, bool inheritViewpoint)
+{
+    // without a valid bound the instances can't be tested against the view frustum
+    if (culledInstanceNodes.empty() || !bound.valid()) return false;
+
+    uint32_t current = viewID.load();
+    if (current == in_viewID) return true;
+    if (current != unassignedViewID || inheritViewpoint) return false;
+
+    // compare_exchange_strong updates current if another thread has assigned viewID first
+    return viewID.compare_exchange_strong(current, in_viewID) || current == in_viewID;
+}
+
+void InstanceCulling::cull(const InstanceNode& instanceNode, const State& state)
+{
+    uint32_t instanceCount = std::min(instanceNode.instanceCount, _capacity);
+    uint32_t firstInstance = instanceNode.firstInstance;
+
+    auto translations = instanceNode.getTranslations();
+    auto rotations = instanceNode.getRotations();
+    auto scales = instanceNode.getScales();
+
+    // clamp to the instances that all the arrays provide
+    for (auto& bufferInfo : {instanceNode.colors, instanceNode.translations, instanceNode.rotations, instanceNode.scales})
+    {
+        if (!bufferInfo || !bufferInfo->data) continue;
+        auto valueCount = static_cast<uint32_t>(bufferInfo->data->valueCount());
+        instanceCount = std::min(instanceCount, valueCount > firstInstance ? valueCount - firstInstance : 0u);
+    }
+
+    _spheres.resize(instanceCount);
+    _levels.resize(instanceCount);
+
+    // compute the bounding sphere of each instance, test them against the view frustum in batches, then select the LOD level of the visible instances.
+    // _levels[i] is set to 0 for culled instances, otherwise the index of the LOD level + 1.
+    auto classify = [&](size_t begin, size_t end) -> void {
+        dsphere* spheres = _spheres.data();
+        for (size_t i = begin; i < end; ++i)
+        {
+            size_t index = firstInstance + i;
+            dvec3 scale = scales ? dvec3(scales->at(index)) : dvec3(1.0, 1.0, 1.0);
+            dvec3 center(bound.center.x * scale.x, bound.center.y * scale.y, bound.center.z * scale.z);
+            if (rotations) center = dquat(rotations->at(index)) * center;
+            if (translations) center += dvec3(translations->at(index));
+
+            double maxScale = std::max(std::abs(scale.x), std::max(std::abs(scale.y), std::abs(scale.z)));
+            spheres[i].set(center, bound.radius * maxScale);
+        }
+
+        uint8_t* levels = _levels.data();
+        state.intersect(spheres + begin, end - begin, levels + begin);
+
+        if (lodChildren.empty()) return;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (levels[i] == 0) continue;
+
+            const auto& sphere = spheres[i];
+            auto lodDistance = state.lodDistanceInFrustum(sphere);
+
+            levels[i] = 0;
+            for (size_t level = 0; level < culledInstanceNodes.size(); ++level)
+            {
+                if (sphere.r > lodDistance * lodChildren[level].minimumScreenHeightRatio)
+                {
+                    levels[i] = static_cast<uint8_t>(level + 1);
+                    break;
+                }
+            }
+        }
+    };
+
+    if (operationThreads && grainSize > 0 && instanceCount > grainSize)
+        operationThreads->parallel_for(0, instanceCount, classify, grainSize);
+    else
+        classify(0, instanceCount);
+
+    // compact the arrays of the visible instances into the arrays of their LOD level
+    struct LevelArrays
+    {
+        CompactArray colors, translations, rotations, scales;
+        uint32_t count = 0;
+    };
+
+    std::vector<LevelArrays> levelArrays(culledInstanceNodes.size());
+    for (size_t level = 0; level < culledInstanceNodes.size(); ++level)
+    {
+        auto& culled = *culledInstanceNodes[level];
+        auto& arrays = levelArrays[level];
+        arrays.colors = CompactArray(instanceNode.colors, culled.colors);
+        arrays.translations = CompactArray(instanceNode.translations, culled.translations);
+        arrays.rotations = CompactArray(instanceNode.rotations, culled.rotations);
+        arrays.scales = CompactArray(instanceNode.scales, culled.scales);
+    }
+
+    for (size_t i = 0; i < instanceCount; ++i)
+    {
+        if (_levels[i] == 0) continue;
+
+        auto& arrays = levelArrays[_levels[i] - 1];
+        size_t index = firstInstance + i;
+        arrays.colors.copy(index, arrays.count);
+        arrays.translations.copy(index, arrays.count);
+        arrays.rotations.copy(index, arrays.count);
+        arrays.scales.copy(index, arrays.count);
+        ++arrays.count;
+    }
+
+    // only the compacted instances need transferring to the GPU
+    auto dirty = [](InstanceNode& culled, ref_ptr<BufferInfo>& bufferInfo) {
+        if (bufferInfo) bufferInfo->data->dirty(0, static_cast<size_t>(culled.instanceCount) * bufferInfo->data->stride());
+    };
+
+    for (size_t level = 0; level < culledInstanceNodes.size(); ++level)
+    {
+        auto& culled = *culledInstanceNodes[level];
+        culled.instanceCount = levelArrays[level].count;
+        if (culled.instanceCount == 0) continue;
+
+        dirty(culled, culled.colors);
+        dirty(culled, culled.translations);
+        dirty(culled, culled.rotations);
+        dirty(culled, culled.scales);
+    }
+}
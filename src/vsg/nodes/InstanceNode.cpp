@@ -27,7 +27,8 @@ InstanceNode::InstanceNode(const InstanceNode& rhs, const CopyOp& copyop) :
     rotations(copyop(rhs.rotations)),
     scales(copyop(rhs.scales)),
     colors(copyop(rhs.colors)),
-    child(copyop(rhs.child))
+    child(copyop(rhs.child)),
+    culling(copyop(rhs.culling))
 {
 }
 
@@ -47,7 +48,8 @@ int InstanceNode::compare(const Object& rhs_object) const
     if ((result = compare_pointer(rotations, rhs.rotations)) != 0) return result;
     if ((result = compare_pointer(scales, rhs.scales)) != 0) return result;
     if ((result = compare_pointer(colors, rhs.colors)) != 0) return result;
-    return compare_pointer(child, rhs.child);
+    if ((result = compare_pointer(child, rhs.child)) != 0) return result;
+    return compare_pointer(culling, rhs.culling);
 }
 
 void InstanceNode::read(Input& input)
@@ -83,6 +85,11 @@ void InstanceNode::read(Input& input)
         colors = {};
 
     input.read("child", child);
+
+    if (input.version_greater_equal(1, 1, 13))
+        input.read("culling", culling);
+    else
+        culling = {};
 }
 
 void InstanceNode::write(Output& output) const
@@ -113,6 +120,8 @@ void InstanceNode::write(Output& output) const
         output.writeObject("colors", nullptr);
 
     output.write("child", child);
+
+    if (output.version_greater_equal(1, 1, 13)) output.write("culling", culling);
 }
 
 void InstanceNode::compile(Context& context)
@@ -135,4 +144,12 @@ void InstanceNode::compile(Context& context)
 
         createBufferAndTransferData(context, combinedBufferInfos, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE);
     }
+
+    if (culling)
+    {
+        for (auto& culledInstanceNode : culling->culledInstanceNodes)
+        {
+            culledInstanceNode->compile(context);
+        }
+    }
 }
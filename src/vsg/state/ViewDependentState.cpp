@@ -10,9 +10,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/app/MultiViewCullTraversal.h>
 #include <vsg/app/View.h>
 #include <vsg/commands/PipelineBarrier.h>
 #include <vsg/core/compare.h>
+#include <vsg/io/DatabasePager.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/write.h>
 #include <vsg/lighting/AmbientLight.h>
@@ -25,6 +27,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/RegionOfInterest.h>
 #include <vsg/state/DescriptorImage.h>
 #include <vsg/state/ViewDependentState.h>
+#include <vsg/ui/FrameStamp.h>
 #include <vsg/utils/GraphicsPipelineConfigurator.h>
 #include <vsg/utils/ShaderSet.h>
 #include <vsg/vk/Context.h>
@@ -299,6 +302,19 @@ void ViewDependentState::init(ResourceRequirements& requirements)
     viewportDataBufferInfo = BufferInfo::create(viewportData.get());
     descriptorConfigurator->assignDescriptor("viewportData", BufferInfoList{viewportDataBufferInfo});
 
+    // set up clustered light assignment only when it's been enabled on the ShaderSet, so the pipelines created from it declare and read the lightClusters buffer
+    if (lightClustersEnabled(*shaderSet))
+    {
+        if (!lightClusters) lightClusters = LightClusters::create();
+        lightClustersBufferInfo = BufferInfo::create(lightClusters->clusterData.get());
+        descriptorConfigurator->assignDescriptor("lightClusters", BufferInfoList{lightClustersBufferInfo});
+    }
+    else
+    {
+        if (lightClusters) warn("ViewDependentState::init() lightClusters assigned but ShaderSet doesn't have clustered lighting enabled, see vsg::enableLightClusters(..).");
+        lightClusters = {};
+    }
+
     // set up ShadowMaps
     auto shadowMapDirectSampler = Sampler::create();
     shadowMapDirectSampler->minFilter = VK_FILTER_NEAREST;
@@ -410,9 +426,15 @@ void ViewDependentState::init(ResourceRequirements& requirements)
             shadowMap.view = first_view;
         }
 
+        // each shadow map view either traverses the main view's scene graph or records the draw list filled in by the single pass shadow culling
+        shadowMap.drawList = Bin::create();
+        shadowMap.sceneSwitch = Switch::create();
+        shadowMap.sceneSwitch->addChild(MASK_ALL, tcon);
+        shadowMap.sceneSwitch->addChild(MASK_OFF, shadowMap.drawList);
+
         shadowMap.view->mask = shadowMask;
         shadowMap.view->camera = Camera::create();
-        shadowMap.view->addChild(tcon);
+        shadowMap.view->children = {shadowMap.sceneSwitch};
         shadowMap.view->camera->viewportState = viewportState;
 
         shadowMap.renderGraph = RenderGraph::create();
@@ -567,6 +589,8 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
 
     bool requiresPerRenderShadowMaps = false;
     uint32_t shadowMapIndex = 0;
+    // index of the next light's first shadow map as computed by shaders stepping through the lights, the sum of the preceding lights' shadow map counts
+    uint32_t lightDataShadowMapIndex = 0;
     uint32_t numShadowMaps = static_cast<uint32_t>(shadowMaps.size());
     if (preRenderSwitch)
         preRenderSwitch->setAllChildren(false);
@@ -656,6 +680,12 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
     auto n = -(clipToEye * dvec3(0.0, 0.0, 1.0)).z;
     auto f = -(clipToEye * dvec3(0.0, 0.0, 0.0)).z;
 
+    if (lightClusters)
+    {
+        lightClusters->setProjection(projectionMatrix, n, f);
+        lightClusters->clear();
+    }
+
     // if regions of interest have been found in the scene graph use them to clamp the near/far values.
     if (!rt.regionsOfInterest.empty())
     {
@@ -743,6 +773,8 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         else
             assignLightData4(0.0f, 0.0f, 0.0f, 0.0f);
 
+        lightDataShadowMapIndex += activeNumShadowMaps;
+
         if (activeNumShadowMaps == 0) continue;
 
         // set up shadow map rendering backend
@@ -868,6 +900,12 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
     for (auto& [mv, light] : pointLights)
     {
         auto eye_position = mv * light->position;
+        if (lightClusters)
+        {
+            auto lightIndex = static_cast<uint32_t>(&(*light_itr) - lightData->data());
+            lightClusters->add(dsphere(eye_position, lightClusters->lightRange(light->color, light->intensity)), lightIndex);
+        }
+
         assignLightData4(light->color.r, light->color.g, light->color.b, light->intensity);
         assignLightData4(static_cast<float>(eye_position.x), static_cast<float>(eye_position.y), static_cast<float>(eye_position.z), 0.0f);
     }
@@ -878,31 +916,52 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         auto eye_direction = normalize(light->direction * inverse_3x3(mv));
         float cos_innerAngle = static_cast<float>(cos(light->innerAngle));
         float cos_outerAngle = static_cast<float>(cos(light->outerAngle));
+        if (lightClusters)
+        {
+            // bound the light's cone, for narrow cones a sphere through the apex and the rim of the cone is tighter than one centered on the apex
+            auto lightIndex = static_cast<uint32_t>(&(*light_itr) - lightData->data()) | LightClusters::spotLightBit;
+            double range = lightClusters->lightRange(light->color, light->intensity);
+            if (light->outerAngle < PI * 0.25)
+            {
+                double radius = range / (2.0 * cos(light->outerAngle));
+                lightClusters->add(dsphere(eye_position + eye_direction * radius, radius), lightIndex);
+            }
+            else
+            {
+                lightClusters->add(dsphere(eye_position, range), lightIndex);
+            }
+        }
+
         assignLightData4(light->color.r, light->color.g, light->color.b, light->intensity);
         assignLightData4(static_cast<float>(eye_position.x), static_cast<float>(eye_position.y), static_cast<float>(eye_position.z), cos_innerAngle);
         assignLightData4(static_cast<float>(eye_direction.x), static_cast<float>(eye_direction.y), static_cast<float>(eye_direction.z), cos_outerAngle);
 
         auto shadowSettings = getActiveShadowSettings(light);
         uint32_t activeNumShadowMaps = shadowSettings ? std::min(shadowSettings->shadowMapCount, numShadowMaps - shadowMapIndex) : 0;
+        // the alpha component of a spot light's shadow settings holds the index of its first shadow map so that
+        // the clustered lighting path, which doesn't step through all the lights, can look up its shadow maps
+        auto firstShadowMapIndex = static_cast<float>(lightDataShadowMapIndex);
         if (shadowSettings)
         {
             if (shadowSettings->type_info() == typeid(HardShadows))
             {
-                assignLightData4(static_cast<float>(activeNumShadowMaps), -1.0f, -1.0f, 0.0f);
+                assignLightData4(static_cast<float>(activeNumShadowMaps), -1.0f, -1.0f, firstShadowMapIndex);
             }
             else if (shadowSettings->type_info() == typeid(SoftShadows))
             {
                 const SoftShadows& pcfShadowSettings = static_cast<const SoftShadows&>(*shadowSettings);
-                assignLightData4(static_cast<float>(activeNumShadowMaps), pcfShadowSettings.penumbraRadius, -1.0f, 0.0f);
+                assignLightData4(static_cast<float>(activeNumShadowMaps), pcfShadowSettings.penumbraRadius, -1.0f, firstShadowMapIndex);
             }
             else if (shadowSettings->type_info() == typeid(PercentageCloserSoftShadows))
             {
-                assignLightData4(static_cast<float>(activeNumShadowMaps), 0.1f /* todo: calculate blocker search radius */, static_cast<float>(light->radius), 0.0f);
+                assignLightData4(static_cast<float>(activeNumShadowMaps), 0.1f /* todo: calculate blocker search radius */, static_cast<float>(light->radius), firstShadowMapIndex);
             }
         }
         else
             assignLightData4(0.0f, 0.0f, 0.0f, 0.0f);
 
+        lightDataShadowMapIndex += activeNumShadowMaps;
+
         if (activeNumShadowMaps == 0) continue;
 
         // set up shadow map rendering backend
@@ -1045,8 +1104,47 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         lightData->dirty();
     }
 
+    if (lightClusters)
+    {
+        lightClusters->assign();
+    }
+
     if (requiresPerRenderShadowMaps && preRenderCommandGraph)
     {
+        bool useDrawLists = singlePassShadowCulling && shadowMapIndex <= MultiViewCullTraversal::maxNumViews;
+        if (useDrawLists)
+        {
+            if (!multiViewCullTraversal) multiViewCullTraversal = MultiViewCullTraversal::create();
+
+            // cull the scene graph against all the active shadow map frustums in one traversal, filling in each shadow map's drawList
+            auto& mvct = *multiViewCullTraversal;
+            mvct.reset(preRenderCommandGraph->maxSlots);
+            mvct.traversalMask = shadowMaps[0].view->mask;
+            mvct.overrideMask = rt.overrideMask;
+            mvct.frameStamp = rt.getFrameStamp();
+            mvct.databasePager = rt.getDatabasePager();
+            mvct.setLODViewpoint(projectionMatrix, viewMatrix);
+
+            for (uint32_t i = 0; i < shadowMapIndex; ++i)
+            {
+                const auto& shadowMap = shadowMaps[i];
+                const auto& camera = shadowMap.view->camera;
+                mvct.addView(camera->projectionMatrix->transform(), camera->viewMatrix->transform(), shadowMap.drawList);
+            }
+
+            for (const auto& child : view->children)
+            {
+                child->accept(mvct);
+            }
+        }
+
+        for (uint32_t i = 0; i < shadowMapIndex; ++i)
+        {
+            auto& children = shadowMaps[i].sceneSwitch->children;
+            children[0].mask = useDrawLists ? MASK_OFF : MASK_ALL;
+            children[1].mask = useDrawLists ? MASK_ALL : MASK_OFF;
+        }
+
         if (rt.instrumentation && !preRenderCommandGraph->instrumentation)
         {
             preRenderCommandGraph->instrumentation = shareOrDuplicateForThreadSafety(rt.instrumentation);
@@ -12,14 +12,71 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/threading/OperationThreads.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
-OperationThreads::OperationThreads(uint32_t numThreads, ref_ptr<ActivityStatus> in_status) :
-    status(in_status)
+namespace
+{
+    /// identifies which OperationThreads, if any, the current thread belongs to, so that operations it adds go on its own deque
+    struct WorkerThread
+    {
+        const OperationThreads* operationThreads = nullptr;
+        size_t index = 0;
+    };
+    thread_local WorkerThread t_workerThread;
+} // namespace
+
+OperationThreads::OperationThreads(uint32_t numThreads, ref_ptr<ActivityStatus> in_status, SchedulingMode in_schedulingMode) :
+    status(in_status),
+    schedulingMode(in_schedulingMode)
 {
     if (!status) status = ActivityStatus::create();
     queue = OperationQueue::create(status);
 
+    if (schedulingMode == WORK_STEALING)
+    {
+        for (size_t i = 0; i < numThreads; ++i)
+        {
+            _deques.emplace_back(new Deque);
+        }
+
+        auto runWorkStealingThread = [this](size_t index) {
+            t_workerThread = WorkerThread{this, index};
+            auto deque = _deques[index].get();
+
+            auto workAvailable = [&]() {
+                if (!queue->empty()) return true;
+                for (auto& other : _deques)
+                {
+                    if (!other->empty()) return true;
+                }
+                return false;
+            };
+
+            while (status->active())
+            {
+                if (auto operation = _take(deque, index))
+                {
+                    operation->run();
+                    continue;
+                }
+
+                // no work found so wait till more operations are added, _numIdle is incremented before checking for work so that _notify() can't be missed
+                std::unique_lock lock(_idleMutex);
+                ++_numIdle;
+                if (!workAvailable()) _idleCV.wait_for(lock, std::chrono::milliseconds(100));
+                --_numIdle;
+            }
+        };
+
+        for (size_t i = 0; i < numThreads; ++i)
+        {
+            threads.emplace_back(runWorkStealingThread, i);
+        }
+        return;
+    }
+
     auto runThread = [](ref_ptr<OperationQueue> q, ref_ptr<ActivityStatus> thread_status) {
         while (thread_status->active())
         {
@@ -42,18 +99,138 @@ OperationThreads::~OperationThreads()
     stop();
 }
 
+void OperationThreads::_add(ref_ptr<Operation> operation, InsertionPosition insertionPosition)
+{
+    if (!operation) return;
+
+    // operations added from one of our threads go on its own deque, unless they need to go ahead of everything else or the deque is full
+    bool pushed = false;
+    if (insertionPosition == INSERT_BACK && t_workerThread.operationThreads == this)
+    {
+        pushed = _deques[t_workerThread.index]->push(operation);
+    }
+
+    if (!pushed) queue->add(operation, insertionPosition);
+
+    _notify();
+}
+
+ref_ptr<Operation> OperationThreads::_take(Deque* deque, size_t index)
+{
+    if (deque)
+    {
+        if (auto operation = deque->pop()) return operation;
+    }
+
+    if (auto operation = queue->take()) return operation;
+
+    // steal from the other threads, starting with the next one along to spread out contention
+    size_t numDeques = _deques.size();
+    for (size_t i = 1; i <= numDeques; ++i)
+    {
+        auto& victim = _deques[(index + i) % numDeques];
+        if (victim.get() == deque) continue;
+
+        if (auto operation = victim->steal()) return operation;
+    }
+
+    return {};
+}
+
+void OperationThreads::_notify()
+{
+    // pairs with the increment of _numIdle in the threads before they check for work
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_numIdle.load() > 0)
+    {
+        std::scoped_lock lock(_idleMutex);
+        _idleCV.notify_one();
+    }
+}
+
 void OperationThreads::run()
 {
+    if (schedulingMode == WORK_STEALING)
+    {
+        Deque* deque = nullptr;
+        size_t index = 0;
+        if (t_workerThread.operationThreads == this)
+        {
+            index = t_workerThread.index;
+            deque = _deques[index].get();
+        }
+
+        while (ref_ptr<Operation> operation = _take(deque, index))
+        {
+            operation->run();
+        }
+        return;
+    }
+
     while (ref_ptr<Operation> operation = queue->take())
     {
         operation->run();
     }
 }
 
+void OperationThreads::parallel_for(size_t first, size_t last, const std::function<void(size_t begin, size_t end)>& function, size_t grainSize)
+{
+    if (first >= last) return;
+
+    size_t count = last - first;
+    if (grainSize == 0) grainSize = std::max(count / (threads.size() + 1), size_t(1));
+    if (grainSize >= count || threads.empty())
+    {
+        function(first, last);
+        return;
+    }
+
+    struct RangeOperation : public Operation
+    {
+        RangeOperation(const std::function<void(size_t, size_t)>& in_function, size_t in_begin, size_t in_end, ref_ptr<Latch> in_latch) :
+            function(in_function),
+            begin(in_begin),
+            end(in_end),
+            latch(in_latch) {}
+
+        void run() override
+        {
+            function(begin, end);
+            latch->count_down();
+        }
+
+        const std::function<void(size_t, size_t)>& function;
+        size_t begin;
+        size_t end;
+        ref_ptr<Latch> latch;
+    };
+
+    // the first range is run on this thread so use the latch to wait for the rest
+    size_t numRanges = (count + grainSize - 1) / grainSize;
+    auto latch = Latch::create(static_cast<int>(numRanges - 1));
+    for (size_t begin = first + grainSize; begin < last; begin += grainSize)
+    {
+        add(ref_ptr<Operation>(new RangeOperation(function, begin, std::min(begin + grainSize, last), latch)));
+    }
+
+    function(first, first + grainSize);
+
+    // help out with the remaining ranges, and any other queued operations, then wait for those still being run by other threads
+    run();
+
+    latch->wait();
+}
+
 void OperationThreads::stop()
 {
     status->set(false);
 
+    if (schedulingMode == WORK_STEALING)
+    {
+        std::scoped_lock lock(_idleMutex);
+        _idleCV.notify_all();
+    }
+
     for (auto& thread : threads)
     {
         thread.join();
@@ -0,0 +1,277 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2018 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/Commands.h>
+#include <vsg/nodes/CullGroup.h>
+#include <vsg/nodes/CullNode.h>
+#include <vsg/nodes/MatrixTransform.h>
+#include <vsg/nodes/QuadGroup.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/utils/BakeSubgraph.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace vsg;
+
+namespace
+{
+    dsphere transformBound(const dmat4& matrix, const dsphere& bound)
+    {
+        if (!bound.valid()) return bound;
+
+        // scale the radius by the largest scale of the matrix so the sphere still encloses the transformed subgraph
+        double sx = length2(dvec3(matrix[0][0], matrix[0][1], matrix[0][2]));
+        double sy = length2(dvec3(matrix[1][0], matrix[1][1], matrix[1][2]));
+        double sz = length2(dvec3(matrix[2][0], matrix[2][1], matrix[2][2]));
+        double scale2 = std::max(sx, std::max(sy, sz));
+        return dsphere(matrix * bound.center, bound.radius * std::sqrt(scale2));
+    }
+} // namespace
+
+BakeSubgraph::BakeSubgraph()
+{
+}
+
+ref_ptr<BakedSubgraph> BakeSubgraph::bake(ref_ptr<Node> subgraph)
+{
+    _baked = BakedSubgraph::create();
+    _matrixStack.assign(1, dmat4());
+    _drawMergeBarrier = 0;
+    _nodeAdded = false;
+
+    if (subgraph)
+    {
+        subgraph->accept(*this);
+        _baked->subgraph = subgraph;
+    }
+
+    auto baked = _baked;
+    _baked = {};
+    return baked;
+}
+
+void BakeSubgraph::_addNode(Node& node)
+{
+    _baked->instructions.push_back(BakedSubgraph::Instruction{BakedSubgraph::NODE, static_cast<uint32_t>(_baked->nodes.size()), 0});
+    _baked->nodes.emplace_back(&node);
+    _nodeAdded = true;
+}
+
+void BakeSubgraph::_addCommand(Command& command)
+{
+    auto& instructions = _baked->instructions;
+    auto index = static_cast<uint32_t>(_baked->commands.size());
+    _baked->commands.emplace_back(&command);
+
+    // extend the previous DRAW when the commands are contiguous so they are recorded in one loop, unless it's the last instruction culled by a CULL
+    if (instructions.size() > _drawMergeBarrier && instructions.back().opcode == BakedSubgraph::DRAW && (instructions.back().first + instructions.back().count) == index)
+    {
+        ++instructions.back().count;
+    }
+    else
+    {
+        instructions.push_back(BakedSubgraph::Instruction{BakedSubgraph::DRAW, index, 1});
+    }
+}
+
+size_t BakeSubgraph::_pushCull(const dsphere& bound)
+{
+    size_t position = _baked->instructions.size();
+    _baked->instructions.push_back(BakedSubgraph::Instruction{BakedSubgraph::CULL, static_cast<uint32_t>(_baked->bounds.size()), 0});
+    _baked->bounds.push_back(transformBound(_matrixStack.back(), bound));
+    return position;
+}
+
+void BakeSubgraph::_popCull(size_t position)
+{
+    auto& instructions = _baked->instructions;
+    if (instructions.size() == position + 1)
+    {
+        // nothing to cull
+        instructions.pop_back();
+        _baked->bounds.pop_back();
+    }
+    else
+    {
+        instructions[position].count = static_cast<uint32_t>(instructions.size() - position - 1);
+        _drawMergeBarrier = instructions.size();
+    }
+}
+
+void BakeSubgraph::apply(Node& node)
+{
+    _addNode(node);
+}
+
+void BakeSubgraph::apply(Group& group)
+{
+    if (!_bakeable(group))
+    {
+        _addNode(group);
+        return;
+    }
+
+    for (auto& child : group.children) child->accept(*this);
+}
+
+void BakeSubgraph::apply(QuadGroup& quadGroup)
+{
+    if (!_bakeable(quadGroup))
+    {
+        _addNode(quadGroup);
+        return;
+    }
+
+    for (auto& child : quadGroup.children) child->accept(*this);
+}
+
+void BakeSubgraph::apply(CullGroup& cullGroup)
+{
+    if (!_bakeable(cullGroup))
+    {
+        _addNode(cullGroup);
+        return;
+    }
+
+    auto position = _pushCull(cullGroup.bound);
+    for (auto& child : cullGroup.children) child->accept(*this);
+    _popCull(position);
+}
+
+void BakeSubgraph::apply(CullNode& cullNode)
+{
+    if (!_bakeable(cullNode))
+    {
+        _addNode(cullNode);
+        return;
+    }
+
+    if (!cullNode.child) return;
+
+    auto position = _pushCull(cullNode.bound);
+    cullNode.child->accept(*this);
+    _popCull(position);
+}
+
+void BakeSubgraph::apply(Transform& transform)
+{
+    // only the matrix of MatrixTransform is fixed, other transforms are computed during the RecordTraversal
+    _addNode(transform);
+}
+
+void BakeSubgraph::apply(MatrixTransform& transform)
+{
+    if (!_bakeable(transform))
+    {
+        _addNode(transform);
+        return;
+    }
+
+    if (transform.matrix == dmat4())
+    {
+        for (auto& child : transform.children) child->accept(*this);
+        return;
+    }
+
+    auto& instructions = _baked->instructions;
+    auto& matrices = _baked->matrices;
+
+    _matrixStack.push_back(_matrixStack.back() * transform.matrix);
+
+    size_t position = instructions.size();
+    auto matrixIndex = static_cast<uint32_t>(matrices.size());
+    instructions.push_back(BakedSubgraph::Instruction{BakedSubgraph::PUSH_MATRIX, matrixIndex, 0});
+    matrices.push_back(_matrixStack.back());
+
+    bool parentNodeAdded = _nodeAdded;
+    _nodeAdded = false;
+
+    for (auto& child : transform.children) child->accept(*this);
+
+    _matrixStack.pop_back();
+
+    if (instructions.size() == position + 1)
+    {
+        // nothing to transform
+        instructions.pop_back();
+        matrices.pop_back();
+        _nodeAdded = parentNodeAdded;
+        return;
+    }
+
+    // nodes like LOD and DepthSorted cull against the local view frustum, so only push it when they are present
+    bool pushFrustum = _nodeAdded && transform.subgraphRequiresLocalFrustum;
+    if (pushFrustum)
+    {
+        instructions[position].opcode = BakedSubgraph::PUSH_MATRIX_AND_FRUSTUM;
+        instructions.push_back(BakedSubgraph::Instruction{BakedSubgraph::POP_MATRIX_AND_FRUSTUM, matrixIndex, 0});
+    }
+    else
+    {
+        instructions.push_back(BakedSubgraph::Instruction{BakedSubgraph::POP_MATRIX, matrixIndex, 0});
+    }
+
+    _nodeAdded = parentNodeAdded || (_nodeAdded && !pushFrustum);
+}
+
+void BakeSubgraph::apply(StateGroup& stateGroup)
+{
+    if (!_bakeable(stateGroup))
+    {
+        _addNode(stateGroup);
+        return;
+    }
+
+    if (stateGroup.stateCommands.empty())
+    {
+        for (auto& child : stateGroup.children) child->accept(*this);
+        return;
+    }
+
+    auto& instructions = _baked->instructions;
+    auto& stateCommands = _baked->stateCommands;
+
+    size_t position = instructions.size();
+    auto first = static_cast<uint32_t>(stateCommands.size());
+    auto count = static_cast<uint32_t>(stateGroup.stateCommands.size());
+    instructions.push_back(BakedSubgraph::Instruction{BakedSubgraph::PUSH_STATE, first, count});
+    stateCommands.insert(stateCommands.end(), stateGroup.stateCommands.begin(), stateGroup.stateCommands.end());
+
+    for (auto& child : stateGroup.children) child->accept(*this);
+
+    if (instructions.size() == position + 1)
+    {
+        // nothing to apply the state to
+        instructions.pop_back();
+        stateCommands.resize(first);
+        return;
+    }
+
+    instructions.push_back(BakedSubgraph::Instruction{BakedSubgraph::POP_STATE, first, count});
+}
+
+void BakeSubgraph::apply(Commands& commands)
+{
+    if (!_bakeable(commands))
+    {
+        _addNode(commands);
+        return;
+    }
+
+    for (auto& child : commands.children) _addCommand(*child);
+}
+
+void BakeSubgraph::apply(Command& command)
+{
+    _addCommand(command);
+}
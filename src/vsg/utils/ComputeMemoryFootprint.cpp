@@ -0,0 +1,151 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/BindIndexBuffer.h>
+#include <vsg/commands/BindVertexBuffers.h>
+#include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/VertexDraw.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/state/DescriptorImage.h>
+#include <vsg/utils/ComputeMemoryFootprint.h>
+
+using namespace vsg;
+
+void ComputeMemoryFootprint::reset()
+{
+    cpuMemory = 0;
+    gpuMemory = 0;
+    _visited.clear();
+    _gpuData.clear();
+}
+
+bool ComputeMemoryFootprint::_visit(const Object& object)
+{
+    if (!_visited.insert(&object).second) return false;
+
+    cpuMemory += object.sizeofObject();
+    return true;
+}
+
+void ComputeMemoryFootprint::_addGpuData(const Data* data)
+{
+    if (!data) return;
+
+    data->accept(*this);
+
+    if (_gpuData.insert(data).second) gpuMemory += data->dataSize();
+}
+
+void ComputeMemoryFootprint::apply(const Object& object)
+{
+    if (_visit(object)) object.traverse(*this);
+}
+
+void ComputeMemoryFootprint::apply(const Data& data)
+{
+    if (_visit(data)) cpuMemory += data.dataSize();
+}
+
+void ComputeMemoryFootprint::apply(const BufferInfo& info)
+{
+    if (_visit(info)) _addGpuData(info.data);
+}
+
+void ComputeMemoryFootprint::apply(const Image& image)
+{
+    if (_visit(image)) _addGpuData(image.data);
+}
+
+void ComputeMemoryFootprint::apply(const ImageView& imageView)
+{
+    if (_visit(imageView) && imageView.image) imageView.image->accept(*this);
+}
+
+void ComputeMemoryFootprint::apply(const ImageInfo& info)
+{
+    if (!_visit(info)) return;
+
+    if (info.sampler) info.sampler->accept(*this);
+    if (info.imageView) info.imageView->accept(*this);
+}
+
+void ComputeMemoryFootprint::apply(const DescriptorBuffer& db)
+{
+    if (!_visit(db)) return;
+
+    for (auto& info : db.bufferInfoList)
+    {
+        if (info) info->accept(*this);
+    }
+}
+
+void ComputeMemoryFootprint::apply(const DescriptorImage& di)
+{
+    if (!_visit(di)) return;
+
+    for (auto& info : di.imageInfoList)
+    {
+        if (info) info->accept(*this);
+    }
+}
+
+void ComputeMemoryFootprint::apply(const BindIndexBuffer& bib)
+{
+    if (_visit(bib) && bib.indices) bib.indices->accept(*this);
+}
+
+void ComputeMemoryFootprint::apply(const BindVertexBuffers& bvb)
+{
+    if (!_visit(bvb)) return;
+
+    for (auto& info : bvb.arrays)
+    {
+        if (info) info->accept(*this);
+    }
+}
+
+void ComputeMemoryFootprint::apply(const VertexDraw& vd)
+{
+    if (!_visit(vd)) return;
+
+    for (auto& info : vd.arrays)
+    {
+        if (info) info->accept(*this);
+    }
+}
+
+void ComputeMemoryFootprint::apply(const VertexIndexDraw& vid)
+{
+    if (!_visit(vid)) return;
+
+    if (vid.indices) vid.indices->accept(*this);
+    for (auto& info : vid.arrays)
+    {
+        if (info) info->accept(*this);
+    }
+}
+
+void ComputeMemoryFootprint::apply(const Geometry& geom)
+{
+    if (!_visit(geom)) return;
+
+    if (geom.indices) geom.indices->accept(*this);
+    for (auto& info : geom.arrays)
+    {
+        if (info) info->accept(*this);
+    }
+    for (auto& command : geom.commands)
+    {
+        if (command) command->accept(*this);
+    }
+}
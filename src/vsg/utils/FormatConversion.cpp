@@ -0,0 +1,505 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/utils/CoordinateSpace.h>
+#include <vsg/utils/FormatConversion.h>
+
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define VSG_FORMATCONVERSION_SSE2 1
+#    if defined(__SSSE3__) || defined(__AVX__)
+#        include <tmmintrin.h>
+#        define VSG_FORMATCONVERSION_SSSE3 1
+#    endif
+#    if defined(__F16C__)
+#        include <immintrin.h>
+#        define VSG_FORMATCONVERSION_F16C 1
+#    endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define VSG_FORMATCONVERSION_NEON 1
+#endif
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_WIN32)
+#    define VSG_FORMATCONVERSION_LITTLE_ENDIAN 1
+#endif
+
+using namespace vsg;
+
+namespace
+{
+    template<size_t sourceSize, size_t targetSize>
+    void convertFixedSize(const uint8_t* src, uint8_t* dst, const uint8_t* defaultValue, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if constexpr (sourceSize < targetSize)
+            {
+                std::memcpy(dst, src, sourceSize);
+                std::memcpy(dst + sourceSize, defaultValue, targetSize - sourceSize);
+            }
+            else
+            {
+                std::memcpy(dst, src, targetSize);
+            }
+            src += sourceSize;
+            dst += targetSize;
+        }
+    }
+
+    uint32_t asUint(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float asFloat(uint32_t bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // exponent bits of the smallest normalized half, values below it are handled as half denormals
+    constexpr uint32_t halfDenormLimit = 113u << 23;
+    // adding this float shifts a half denormal's mantissa bits into the low bits of the sum
+    constexpr uint32_t halfDenormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+    // floats at or above 65536.0 overflow to infinity
+    constexpr uint32_t halfOverflow = (127 + 16) << 23;
+    constexpr uint32_t floatInfinity = 255u << 23;
+
+    const std::array<float, 256>& sRGBToLinearTable()
+    {
+        static const std::array<float, 256> s_table = []() {
+            std::array<float, 256> table;
+            for (size_t i = 0; i < table.size(); ++i) table[i] = sRGB_to_linear(static_cast<float>(i) / 255.0f);
+            return table;
+        }();
+        return s_table;
+    }
+
+    constexpr size_t linearToSRGBTableSize = 4096;
+
+    const std::array<uint8_t, linearToSRGBTableSize>& linearToSRGBTable()
+    {
+        static const std::array<uint8_t, linearToSRGBTableSize> s_table = []() {
+            std::array<uint8_t, linearToSRGBTableSize> table;
+            for (size_t i = 0; i < table.size(); ++i)
+            {
+                float c = linear_to_sRGB(static_cast<float>(i) / static_cast<float>(linearToSRGBTableSize - 1));
+                table[i] = static_cast<uint8_t>(c * 255.0f + 0.5f);
+            }
+            return table;
+        }();
+        return s_table;
+    }
+
+    // clamp to the 0 to 1 range, mapping NaN to 0
+    float clampUnit(float value)
+    {
+        return value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+    }
+} // namespace
+
+void vsg::convertPixels(const void* source, uint32_t sourceSize, void* dest, uint32_t targetSize, const uint8_t* defaultValue, size_t count)
+{
+    auto src = static_cast<const uint8_t*>(source);
+    auto dst = static_cast<uint8_t*>(dest);
+
+    if (sourceSize == targetSize)
+    {
+        std::memcpy(dst, src, count * sourceSize);
+        return;
+    }
+
+    if (sourceSize == 3 && targetSize == 4) return convertRGB8ToRGBA8(src, dst, count, defaultValue[0]);
+    if (sourceSize == 4 && targetSize == 3) return convertRGBA8ToRGB8(src, dst, count);
+    if (sourceSize == 6 && targetSize == 8) return convertFixedSize<6, 8>(src, dst, defaultValue, count);
+    if (sourceSize == 8 && targetSize == 6) return convertFixedSize<8, 6>(src, dst, defaultValue, count);
+    if (sourceSize == 12 && targetSize == 16) return convertFixedSize<12, 16>(src, dst, defaultValue, count);
+    if (sourceSize == 16 && targetSize == 12) return convertFixedSize<16, 12>(src, dst, defaultValue, count);
+    if (sourceSize == 24 && targetSize == 32) return convertFixedSize<24, 32>(src, dst, defaultValue, count);
+
+    uint32_t bytesToCopy = sourceSize < targetSize ? sourceSize : targetSize;
+    uint32_t bytesToFill = targetSize - bytesToCopy;
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::memcpy(dst, src, bytesToCopy);
+        if (bytesToFill > 0) std::memcpy(dst + bytesToCopy, defaultValue, bytesToFill);
+        src += sourceSize;
+        dst += targetSize;
+    }
+}
+
+void vsg::convertRGB8ToRGBA8(const uint8_t* source, uint8_t* dest, size_t count, uint8_t alpha)
+{
+    size_t i = 0;
+
+#if defined(VSG_FORMATCONVERSION_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>(alpha) << 24));
+    // each 16 byte load consumes 4 pixels, so stop while 6 pixels remain to avoid reading past the end of source
+    for (; i + 6 <= count; i += 4)
+    {
+        __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i * 4), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alphaMask));
+    }
+#elif defined(VSG_FORMATCONVERSION_NEON)
+    const uint8x16_t alphas = vdupq_n_u8(alpha);
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x3_t rgb = vld3q_u8(source + i * 3);
+        uint8x16x4_t rgba;
+        rgba.val[0] = rgb.val[0];
+        rgba.val[1] = rgb.val[1];
+        rgba.val[2] = rgb.val[2];
+        rgba.val[3] = alphas;
+        vst4q_u8(dest + i * 4, rgba);
+    }
+#endif
+
+#if defined(VSG_FORMATCONVERSION_LITTLE_ENDIAN)
+    // expand 4 pixels at a time using 32 bit words
+    const uint32_t alphaBits = static_cast<uint32_t>(alpha) << 24;
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32_t rgb[3];
+        std::memcpy(rgb, source + i * 3, sizeof(rgb));
+
+        uint32_t rgba[4];
+        rgba[0] = (rgb[0] & 0xffffff) | alphaBits;
+        rgba[1] = (((rgb[0] >> 24) | (rgb[1] << 8)) & 0xffffff) | alphaBits;
+        rgba[2] = (((rgb[1] >> 16) | (rgb[2] << 16)) & 0xffffff) | alphaBits;
+        rgba[3] = (rgb[2] >> 8) | alphaBits;
+        std::memcpy(dest + i * 4, rgba, sizeof(rgba));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const uint8_t* src = source + i * 3;
+        uint8_t* dst = dest + i * 4;
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = alpha;
+    }
+}
+
+void vsg::convertRGBA8ToRGB8(const uint8_t* source, uint8_t* dest, size_t count)
+{
+    size_t i = 0;
+
+#if defined(VSG_FORMATCONVERSION_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i rgb = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4)), shuffle);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + i * 3), rgb);
+        uint32_t last = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(rgb, 8)));
+        std::memcpy(dest + i * 3 + 8, &last, sizeof(last));
+    }
+#elif defined(VSG_FORMATCONVERSION_NEON)
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t rgba = vld4q_u8(source + i * 4);
+        uint8x16x3_t rgb;
+        rgb.val[0] = rgba.val[0];
+        rgb.val[1] = rgba.val[1];
+        rgb.val[2] = rgba.val[2];
+        vst3q_u8(dest + i * 3, rgb);
+    }
+#endif
+
+#if defined(VSG_FORMATCONVERSION_LITTLE_ENDIAN)
+    // pack 4 pixels at a time using 32 bit words
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32_t rgba[4];
+        std::memcpy(rgba, source + i * 4, sizeof(rgba));
+
+        uint32_t rgb[3];
+        rgb[0] = (rgba[0] & 0xffffff) | (rgba[1] << 24);
+        rgb[1] = ((rgba[1] >> 8) & 0xffff) | (rgba[2] << 16);
+        rgb[2] = ((rgba[2] >> 16) & 0xff) | (rgba[3] << 8);
+        std::memcpy(dest + i * 3, rgb, sizeof(rgb));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const uint8_t* src = source + i * 4;
+        uint8_t* dst = dest + i * 3;
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+    }
+}
+
+void vsg::convertUNorm8ToUNorm16(const uint8_t* source, uint16_t* dest, size_t count)
+{
+    size_t i = 0;
+
+#if defined(VSG_FORMATCONVERSION_SSE2)
+    // interleaving a byte with itself gives v * 257, mapping 255 to 65535
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_unpacklo_epi8(v, v));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i + 8), _mm_unpackhi_epi8(v, v));
+    }
+#elif defined(VSG_FORMATCONVERSION_NEON)
+    for (; i + 8 <= count; i += 8)
+    {
+        uint16x8_t v = vmovl_u8(vld1_u8(source + i));
+        vst1q_u16(dest + i, vorrq_u16(vshlq_n_u16(v, 8), v));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        dest[i] = static_cast<uint16_t>(source[i] * 257);
+    }
+}
+
+void vsg::convertUNorm16ToUNorm8(const uint16_t* source, uint8_t* dest, size_t count)
+{
+    size_t i = 0;
+
+    // round(v / 257) computed as (x - (x >> 8)) >> 8 where x = min(v + 128, 65535), exact for all 16 bit values
+
+#if defined(VSG_FORMATCONVERSION_SSE2)
+    const __m128i half = _mm_set1_epi16(128);
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i a = _mm_adds_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)), half);
+        __m128i b = _mm_adds_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 8)), half);
+        a = _mm_srli_epi16(_mm_sub_epi16(a, _mm_srli_epi16(a, 8)), 8);
+        b = _mm_srli_epi16(_mm_sub_epi16(b, _mm_srli_epi16(b, 8)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_packus_epi16(a, b));
+    }
+#elif defined(VSG_FORMATCONVERSION_NEON)
+    const uint16x8_t half = vdupq_n_u16(128);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint16x8_t x = vqaddq_u16(vld1q_u16(source + i), half);
+        vst1_u8(dest + i, vshrn_n_u16(vsubq_u16(x, vshrq_n_u16(x, 8)), 8));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        uint32_t x = source[i] + 128u;
+        if (x > 65535u) x = 65535u;
+        dest[i] = static_cast<uint8_t>((x - (x >> 8)) >> 8);
+    }
+}
+
+uint16_t vsg::floatToHalf(float value)
+{
+    uint32_t bits = asUint(value);
+    uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t result;
+    if (bits >= halfOverflow)
+    {
+        // infinity or NaN, overflowed values become infinity
+        result = (bits > floatInfinity) ? 0x7e00 : 0x7c00;
+    }
+    else if (bits < halfDenormLimit)
+    {
+        // denormal or zero, the float addition performs the round to nearest even
+        result = asUint(asFloat(bits) + asFloat(halfDenormMagic)) - halfDenormMagic;
+    }
+    else
+    {
+        // normalized, rebias the exponent and round the mantissa to nearest even
+        uint32_t mantissaOdd = (bits >> 13) & 1;
+        bits += ((15u - 127u) << 23) + 0xfff;
+        bits += mantissaOdd;
+        result = bits >> 13;
+    }
+
+    return static_cast<uint16_t>(result | (sign >> 16));
+}
+
+float vsg::halfToFloat(uint16_t value)
+{
+    constexpr uint32_t shiftedExponent = 0x7c00u << 13;
+
+    uint32_t bits = (value & 0x7fffu) << 13;
+    uint32_t exponent = bits & shiftedExponent;
+    bits += (127u - 15u) << 23;
+
+    if (exponent == shiftedExponent)
+    {
+        // infinity or NaN
+        bits += (128u - 16u) << 23;
+    }
+    else if (exponent == 0)
+    {
+        // zero or denormal, renormalize
+        bits += 1u << 23;
+        bits = asUint(asFloat(bits) - asFloat(halfDenormLimit));
+    }
+
+    return asFloat(bits | (static_cast<uint32_t>(value & 0x8000u) << 16));
+}
+
+void vsg::convertFloatToHalf(const float* source, uint16_t* dest, size_t count)
+{
+    size_t i = 0;
+
+#if defined(VSG_FORMATCONVERSION_F16C)
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i lo = _mm_cvtps_ph(_mm_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+        __m128i hi = _mm_cvtps_ph(_mm_loadu_ps(source + i + 4), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_unpacklo_epi64(lo, hi));
+    }
+#elif defined(VSG_FORMATCONVERSION_SSE2)
+    // vectorized form of floatToHalf(..)
+    const __m128i signMask = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i overflow = _mm_set1_epi32(static_cast<int>(halfOverflow - 1));
+    const __m128i infinity = _mm_set1_epi32(static_cast<int>(floatInfinity));
+    const __m128i denormLimit = _mm_set1_epi32(static_cast<int>(halfDenormLimit));
+    const __m128i denormMagic = _mm_set1_epi32(static_cast<int>(halfDenormMagic));
+    const __m128i rebias = _mm_set1_epi32(static_cast<int>(((15u - 127u) << 23) + 0xfff));
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i halfInfinity = _mm_set1_epi32(0x7c00);
+    const __m128i halfNaNBit = _mm_set1_epi32(0x0200);
+
+    auto convert4 = [&](const float* ptr) {
+        __m128i bits = _mm_castps_si128(_mm_loadu_ps(ptr));
+        __m128i sign = _mm_and_si128(bits, signMask);
+        bits = _mm_xor_si128(bits, sign);
+
+        __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(bits), _mm_castsi128_ps(denormMagic))), denormMagic);
+
+        __m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(bits, 13), one);
+        __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, rebias), mantissaOdd), 13);
+
+        __m128i isDenormal = _mm_cmplt_epi32(bits, denormLimit);
+        __m128i result = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+
+        __m128i isSpecial = _mm_cmpgt_epi32(bits, overflow);
+        __m128i special = _mm_or_si128(halfInfinity, _mm_and_si128(_mm_cmpgt_epi32(bits, infinity), halfNaNBit));
+        result = _mm_or_si128(_mm_and_si128(isSpecial, special), _mm_andnot_si128(isSpecial, result));
+
+        result = _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+
+        // sign extend the low 16 bits so the signed saturating pack leaves them unchanged
+        return _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+    };
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i lo = convert4(source + i);
+        __m128i hi = convert4(source + i + 4);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_packs_epi32(lo, hi));
+    }
+#elif defined(VSG_FORMATCONVERSION_NEON)
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1_u16(dest + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(source + i))));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        dest[i] = floatToHalf(source[i]);
+    }
+}
+
+void vsg::convertHalfToFloat(const uint16_t* source, float* dest, size_t count)
+{
+    size_t i = 0;
+
+#if defined(VSG_FORMATCONVERSION_F16C)
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(dest + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i))));
+    }
+#elif defined(VSG_FORMATCONVERSION_SSE2)
+    // vectorized form of halfToFloat(..)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i magnitudeMask = _mm_set1_epi32(0x7fff);
+    const __m128i signMask = _mm_set1_epi32(0x8000);
+    const __m128i shiftedExponent = _mm_set1_epi32(0x7c00 << 13);
+    const __m128i rebias = _mm_set1_epi32((127 - 15) << 23);
+    const __m128i specialRebias = _mm_set1_epi32((128 - 16) << 23);
+    const __m128i denormalBias = _mm_set1_epi32(1 << 23);
+    const __m128 denormLimit = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(halfDenormLimit)));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i)), zero);
+
+        __m128i bits = _mm_slli_epi32(_mm_and_si128(h, magnitudeMask), 13);
+        __m128i exponent = _mm_and_si128(bits, shiftedExponent);
+        bits = _mm_add_epi32(bits, rebias);
+
+        bits = _mm_add_epi32(bits, _mm_and_si128(_mm_cmpeq_epi32(exponent, shiftedExponent), specialRebias));
+
+        __m128i isDenormal = _mm_cmpeq_epi32(exponent, zero);
+        __m128i denormal = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, denormalBias)), denormLimit));
+        bits = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, bits));
+
+        bits = _mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(h, signMask), 16));
+        _mm_storeu_ps(dest + i, _mm_castsi128_ps(bits));
+    }
+#elif defined(VSG_FORMATCONVERSION_NEON)
+    for (; i + 4 <= count; i += 4)
+    {
+        vst1q_f32(dest + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(source + i))));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        dest[i] = halfToFloat(source[i]);
+    }
+}
+
+void vsg::convertSRGB8ToLinearFloat(const uint8_t* source, float* dest, size_t count, uint32_t numComponents)
+{
+    const auto& table = sRGBToLinearTable();
+    uint32_t numColorComponents = numComponents < 4 ? numComponents : 3;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t c = 0;
+        for (; c < numColorComponents; ++c) dest[c] = table[source[c]];
+        for (; c < numComponents; ++c) dest[c] = static_cast<float>(source[c]) / 255.0f;
+        source += numComponents;
+        dest += numComponents;
+    }
+}
+
+void vsg::convertLinearFloatToSRGB8(const float* source, uint8_t* dest, size_t count, uint32_t numComponents)
+{
+    const auto& table = linearToSRGBTable();
+    constexpr float scale = static_cast<float>(linearToSRGBTableSize - 1);
+    uint32_t numColorComponents = numComponents < 4 ? numComponents : 3;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t c = 0;
+        for (; c < numColorComponents; ++c) dest[c] = table[static_cast<size_t>(clampUnit(source[c]) * scale + 0.5f)];
+        for (; c < numComponents; ++c) dest[c] = static_cast<uint8_t>(clampUnit(source[c]) * 255.0f + 0.5f);
+        source += numComponents;
+        dest += numComponents;
+    }
+}
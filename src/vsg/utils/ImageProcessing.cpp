@@ -0,0 +1,963 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Array2D.h>
+#include <vsg/io/Logger.h>
+#include <vsg/utils/FormatConversion.h>
+#include <vsg/utils/ImageProcessing.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define VSG_IMAGEPROCESSING_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define VSG_IMAGEPROCESSING_NEON 1
+#endif
+
+using namespace vsg;
+
+namespace
+{
+    // the working images hold 4 floats per pixel so that each pixel maps to a single SIMD register
+#if defined(VSG_IMAGEPROCESSING_SSE2)
+    using float4 = __m128;
+    inline float4 load4(const float* ptr) { return _mm_loadu_ps(ptr); }
+    inline void store4(float* ptr, float4 v) { _mm_storeu_ps(ptr, v); }
+    inline float4 splat4(float value) { return _mm_set1_ps(value); }
+    inline float4 multiplyAdd4(float4 acc, float4 a, float4 b) { return _mm_add_ps(acc, _mm_mul_ps(a, b)); }
+#elif defined(VSG_IMAGEPROCESSING_NEON)
+    using float4 = float32x4_t;
+    inline float4 load4(const float* ptr) { return vld1q_f32(ptr); }
+    inline void store4(float* ptr, float4 v) { vst1q_f32(ptr, v); }
+    inline float4 splat4(float value) { return vdupq_n_f32(value); }
+    inline float4 multiplyAdd4(float4 acc, float4 a, float4 b) { return vmlaq_f32(acc, a, b); }
+#else
+    struct float4
+    {
+        float v[4];
+    };
+    inline float4 load4(const float* ptr) { return float4{{ptr[0], ptr[1], ptr[2], ptr[3]}}; }
+    inline void store4(float* ptr, float4 v) { std::memcpy(ptr, v.v, sizeof(v.v)); }
+    inline float4 splat4(float value) { return float4{{value, value, value, value}}; }
+    inline float4 multiplyAdd4(float4 acc, float4 a, float4 b)
+    {
+        for (int i = 0; i < 4; ++i) acc.v[i] += a.v[i] * b.v[i];
+        return acc;
+    }
+#endif
+
+    void forEachRow(OperationThreads* operationThreads, size_t numRows, const std::function<void(size_t begin, size_t end)>& function)
+    {
+        if (operationThreads && numRows > 1)
+            operationThreads->parallel_for(0, numRows, function);
+        else
+            function(0, numRows);
+    }
+
+    struct PixelLayout
+    {
+        uint32_t numComponents = 0;
+        uint32_t componentSize = 0; // 1 for 8 bit normalized components, 4 for 32 bit floats
+        bool sRGB = false;
+        bool swizzleBGR = false;
+
+        uint32_t pixelSize() const { return numComponents * componentSize; }
+    };
+
+    bool getPixelLayout(VkFormat format, PixelLayout& layout)
+    {
+        switch (format)
+        {
+        case VK_FORMAT_R8_UNORM: layout = {1, 1, false, false}; return true;
+        case VK_FORMAT_R8_SRGB: layout = {1, 1, true, false}; return true;
+        case VK_FORMAT_R8G8_UNORM: layout = {2, 1, false, false}; return true;
+        case VK_FORMAT_R8G8_SRGB: layout = {2, 1, true, false}; return true;
+        case VK_FORMAT_R8G8B8_UNORM: layout = {3, 1, false, false}; return true;
+        case VK_FORMAT_R8G8B8_SRGB: layout = {3, 1, true, false}; return true;
+        case VK_FORMAT_B8G8R8_UNORM: layout = {3, 1, false, true}; return true;
+        case VK_FORMAT_B8G8R8_SRGB: layout = {3, 1, true, true}; return true;
+        case VK_FORMAT_R8G8B8A8_UNORM: layout = {4, 1, false, false}; return true;
+        case VK_FORMAT_R8G8B8A8_SRGB: layout = {4, 1, true, false}; return true;
+        case VK_FORMAT_B8G8R8A8_UNORM: layout = {4, 1, false, true}; return true;
+        case VK_FORMAT_B8G8R8A8_SRGB: layout = {4, 1, true, true}; return true;
+        case VK_FORMAT_R32_SFLOAT: layout = {1, 4, false, false}; return true;
+        case VK_FORMAT_R32G32_SFLOAT: layout = {2, 4, false, false}; return true;
+        case VK_FORMAT_R32G32B32_SFLOAT: layout = {3, 4, false, false}; return true;
+        case VK_FORMAT_R32G32B32A32_SFLOAT: layout = {4, 4, false, false}; return true;
+        default: return false;
+        }
+    }
+
+    bool checkImage(const Data* data, const char* function, PixelLayout& layout)
+    {
+        if (!data || !data->dataAvailable()) return false;
+
+        if (data->dimensions() != 2 || data->properties.blockWidth != 1 || data->properties.blockHeight != 1)
+        {
+            warn(function, "(..) only supports uncompressed 2D images.");
+            return false;
+        }
+
+        if (!getPixelLayout(data->properties.format, layout) || data->valueSize() != layout.pixelSize())
+        {
+            warn(function, "(..) unsupported image format ", data->properties.format);
+            return false;
+        }
+
+        return true;
+    }
+
+    // allocate an Array2D with room for the specified number of mipmap levels, using the same allocator as Array2D::_allocate(..)
+    template<class A>
+    ref_ptr<Data> createArray2D(uint32_t width, uint32_t height, Data::Properties properties)
+    {
+        using value_type = typename A::value_type;
+
+        size_t count = Data::computeValueCountIncludingMipmaps(width, height, 1, properties.maxNumMipmaps);
+        properties.stride = sizeof(value_type);
+        properties.allocatorType = ALLOCATOR_TYPE_VSG_ALLOCATOR;
+
+        auto values = new (vsg::allocate(sizeof(value_type) * count, ALLOCATOR_AFFINITY_DATA)) value_type[count];
+        return A::create(width, height, values, properties);
+    }
+
+    ref_ptr<Data> createImage(const PixelLayout& layout, uint32_t width, uint32_t height, const Data::Properties& properties)
+    {
+        if (layout.componentSize == 1)
+        {
+            switch (layout.numComponents)
+            {
+            case 1: return createArray2D<ubyteArray2D>(width, height, properties);
+            case 2: return createArray2D<ubvec2Array2D>(width, height, properties);
+            case 3: return createArray2D<ubvec3Array2D>(width, height, properties);
+            default: return createArray2D<ubvec4Array2D>(width, height, properties);
+            }
+        }
+        else
+        {
+            switch (layout.numComponents)
+            {
+            case 1: return createArray2D<floatArray2D>(width, height, properties);
+            case 2: return createArray2D<vec2Array2D>(width, height, properties);
+            case 3: return createArray2D<vec3Array2D>(width, height, properties);
+            default: return createArray2D<vec4Array2D>(width, height, properties);
+            }
+        }
+    }
+
+    // copy a row of pixels, gathering them into contiguous memory when the source has a custom stride
+    const uint8_t* sourceRow(const Data* data, size_t index, uint32_t width, uint32_t pixelSize, std::vector<uint8_t>& buffer)
+    {
+        auto ptr = static_cast<const uint8_t*>(data->dataPointer(index));
+        uint32_t stride = data->stride();
+        if (stride == pixelSize) return ptr;
+
+        buffer.resize(static_cast<size_t>(width) * pixelSize);
+        for (uint32_t x = 0; x < width; ++x) std::memcpy(buffer.data() + x * pixelSize, ptr + static_cast<size_t>(x) * stride, pixelSize);
+        return buffer.data();
+    }
+
+    // decode a row of pixels to 4 linear floats per pixel
+    void decodeRow(const PixelLayout& layout, const uint8_t* source, float* dest, uint32_t width, std::vector<float>& buffer)
+    {
+        uint32_t n = layout.numComponents;
+        const float* values = nullptr;
+        if (layout.componentSize == 4)
+        {
+            values = reinterpret_cast<const float*>(source);
+        }
+        else
+        {
+            buffer.resize(static_cast<size_t>(width) * n);
+            if (layout.sRGB)
+            {
+                convertSRGB8ToLinearFloat(source, buffer.data(), width, n);
+            }
+            else
+            {
+                for (size_t i = 0; i < buffer.size(); ++i) buffer[i] = static_cast<float>(source[i]) * (1.0f / 255.0f);
+            }
+            values = buffer.data();
+        }
+
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            float* pixel = dest + x * 4;
+            for (uint32_t c = 0; c < 4; ++c) pixel[c] = c < n ? values[x * n + c] : (c == 3 ? 1.0f : 0.0f);
+        }
+    }
+
+    // encode a row of 4 linear floats per pixel to the image format
+    void encodeRow(const PixelLayout& layout, const float* source, uint8_t* dest, uint32_t width, std::vector<float>& buffer)
+    {
+        uint32_t n = layout.numComponents;
+        float* values = (layout.componentSize == 4) ? reinterpret_cast<float*>(dest) : nullptr;
+        if (!values)
+        {
+            buffer.resize(static_cast<size_t>(width) * n);
+            values = buffer.data();
+        }
+
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            for (uint32_t c = 0; c < n; ++c) values[x * n + c] = source[x * 4 + c];
+        }
+
+        if (layout.componentSize == 4) return;
+
+        if (layout.sRGB)
+        {
+            convertLinearFloatToSRGB8(values, dest, width, n);
+        }
+        else
+        {
+            for (size_t i = 0; i < buffer.size(); ++i)
+            {
+                float v = values[i];
+                dest[i] = static_cast<uint8_t>((v > 0.0f ? (v < 1.0f ? v : 1.0f) : 0.0f) * 255.0f + 0.5f);
+            }
+        }
+    }
+
+    // filter taps of each destination coordinate along one axis, all coordinates have numTaps taps with unused taps given zero weight
+    struct AxisFilter
+    {
+        uint32_t numTaps = 0;
+        std::vector<uint32_t> indices;
+        std::vector<float> weights;
+    };
+
+    // modified Bessel function of the first kind, used by the Kaiser window
+    double besselI0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        double halfX = x * 0.5;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+            if (term < sum * 1e-12) break;
+        }
+        return sum;
+    }
+
+    double kaiserSinc(double t)
+    {
+        constexpr double width = 3.0;
+        constexpr double alpha = 4.0;
+        constexpr double pi = 3.14159265358979323846;
+
+        double u = t / width;
+        if (std::abs(u) >= 1.0) return 0.0;
+
+        double window = besselI0(alpha * std::sqrt(1.0 - u * u)) / besselI0(alpha);
+        double sinc = (t == 0.0) ? 1.0 : std::sin(pi * t) / (pi * t);
+        return window * sinc;
+    }
+
+    AxisFilter computeAxisFilter(uint32_t sourceSize, uint32_t destSize, MipmapFilter filter)
+    {
+        std::vector<std::vector<std::pair<uint32_t, double>>> taps(destSize);
+
+        double scale = static_cast<double>(sourceSize) / static_cast<double>(destSize);
+        for (uint32_t x = 0; x < destSize; ++x)
+        {
+            auto& destTaps = taps[x];
+            if (sourceSize == destSize)
+            {
+                destTaps.emplace_back(x, 1.0);
+            }
+            else if (filter == MIPMAP_FILTER_KAISER)
+            {
+                // windowed sinc centered on the destination texel, stretched to the source texel spacing, sampling beyond the edges clamps to the edge texels
+                double center = (x + 0.5) * scale;
+                double radius = 3.0 * scale;
+                auto first = static_cast<int64_t>(std::floor(center - radius));
+                auto last = static_cast<int64_t>(std::ceil(center + radius));
+                for (int64_t i = first; i <= last; ++i)
+                {
+                    double weight = kaiserSinc((static_cast<double>(i) + 0.5 - center) / scale);
+                    if (weight == 0.0) continue;
+
+                    auto index = static_cast<uint32_t>(std::clamp<int64_t>(i, 0, sourceSize - 1));
+                    auto itr = std::find_if(destTaps.begin(), destTaps.end(), [index](const std::pair<uint32_t, double>& tap) { return tap.first == index; });
+                    if (itr != destTaps.end())
+                        itr->second += weight;
+                    else
+                        destTaps.emplace_back(index, weight);
+                }
+            }
+            else
+            {
+                // weight each source texel by how much of it the destination texel covers
+                double begin = x * scale;
+                double end = (x + 1) * scale;
+                for (auto i = static_cast<uint32_t>(begin); i < sourceSize && i < end; ++i)
+                {
+                    double coverage = std::min<double>(end, i + 1) - std::max<double>(begin, i);
+                    if (coverage > 0.0) destTaps.emplace_back(i, coverage);
+                }
+            }
+
+            double sum = 0.0;
+            for (auto& tap : destTaps) sum += tap.second;
+            for (auto& tap : destTaps) tap.second /= sum;
+        }
+
+        AxisFilter axisFilter;
+        for (auto& destTaps : taps) axisFilter.numTaps = std::max(axisFilter.numTaps, static_cast<uint32_t>(destTaps.size()));
+
+        axisFilter.indices.resize(static_cast<size_t>(destSize) * axisFilter.numTaps, 0);
+        axisFilter.weights.resize(static_cast<size_t>(destSize) * axisFilter.numTaps, 0.0f);
+        for (uint32_t x = 0; x < destSize; ++x)
+        {
+            for (size_t t = 0; t < taps[x].size(); ++t)
+            {
+                axisFilter.indices[x * axisFilter.numTaps + t] = taps[x][t].first;
+                axisFilter.weights[x * axisFilter.numTaps + t] = static_cast<float>(taps[x][t].second);
+            }
+        }
+        return axisFilter;
+    }
+
+    // separable downsample of a 4 float per pixel image, filtering the rows into intermediate and then the columns into dest
+    void downsample(const float* source, uint32_t sourceWidth, uint32_t sourceHeight, float* dest, uint32_t destWidth, uint32_t destHeight, MipmapFilter filter, std::vector<float>& intermediate, OperationThreads* operationThreads)
+    {
+        auto horizontal = computeAxisFilter(sourceWidth, destWidth, filter);
+        auto vertical = computeAxisFilter(sourceHeight, destHeight, filter);
+
+        intermediate.resize(static_cast<size_t>(destWidth) * sourceHeight * 4);
+        float* rows = intermediate.data();
+
+        forEachRow(operationThreads, sourceHeight, [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y)
+            {
+                const float* src = source + y * sourceWidth * 4;
+                float* dst = rows + y * destWidth * 4;
+                const uint32_t* indices = horizontal.indices.data();
+                const float* weights = horizontal.weights.data();
+                for (uint32_t x = 0; x < destWidth; ++x)
+                {
+                    float4 acc = splat4(0.0f);
+                    for (uint32_t t = 0; t < horizontal.numTaps; ++t)
+                    {
+                        acc = multiplyAdd4(acc, load4(src + indices[t] * 4), splat4(weights[t]));
+                    }
+                    store4(dst + x * 4, acc);
+                    indices += horizontal.numTaps;
+                    weights += horizontal.numTaps;
+                }
+            }
+        });
+
+        forEachRow(operationThreads, destHeight, [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y)
+            {
+                float* dst = dest + y * destWidth * 4;
+                std::fill(dst, dst + destWidth * 4, 0.0f);
+
+                const uint32_t* indices = vertical.indices.data() + y * vertical.numTaps;
+                const float* weights = vertical.weights.data() + y * vertical.numTaps;
+                for (uint32_t t = 0; t < vertical.numTaps; ++t)
+                {
+                    if (weights[t] == 0.0f) continue;
+
+                    const float* src = rows + static_cast<size_t>(indices[t]) * destWidth * 4;
+                    float4 weight = splat4(weights[t]);
+                    for (uint32_t x = 0; x < destWidth; ++x)
+                    {
+                        store4(dst + x * 4, multiplyAdd4(load4(dst + x * 4), load4(src + x * 4), weight));
+                    }
+                }
+            }
+        });
+    }
+
+    //
+    // block compression
+    //
+    struct Block
+    {
+        float texels[16][4]; // RGBA in the 0 to 255 range
+    };
+
+    float clamp255(float v)
+    {
+        return v > 0.0f ? (v < 255.0f ? v : 255.0f) : 0.0f;
+    }
+
+    // fetch the 4x4 block at bx, by of a mipmap level, replicating the edge texels of partial blocks
+    void fetchBlock(const PixelLayout& layout, const uint8_t* level, uint32_t stride, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, Block& block)
+    {
+        uint32_t n = layout.numComponents;
+        for (uint32_t j = 0; j < 4; ++j)
+        {
+            uint32_t y = std::min(by * 4 + j, height - 1);
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                uint32_t x = std::min(bx * 4 + i, width - 1);
+                const uint8_t* pixel = level + (static_cast<size_t>(y) * width + x) * stride;
+                float* texel = block.texels[j * 4 + i];
+                texel[0] = texel[1] = texel[2] = 0.0f;
+                texel[3] = 255.0f;
+                for (uint32_t c = 0; c < n; ++c)
+                {
+                    if (layout.componentSize == 4)
+                    {
+                        float value;
+                        std::memcpy(&value, pixel + c * 4, sizeof(float));
+                        texel[c] = std::round(clamp255(value * 255.0f));
+                    }
+                    else
+                    {
+                        texel[c] = pixel[c];
+                    }
+                }
+                if (layout.swizzleBGR) std::swap(texel[0], texel[2]);
+            }
+        }
+    }
+
+    // fit endpoints to the first numChannels channels of the block along the principal axis of the texel distribution
+    void principalEndpoints(const Block& block, uint32_t numChannels, float e0[4], float e1[4])
+    {
+        float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (auto& texel : block.texels)
+        {
+            for (uint32_t c = 0; c < numChannels; ++c) mean[c] += texel[c];
+        }
+        for (uint32_t c = 0; c < numChannels; ++c) mean[c] /= 16.0f;
+
+        float covariance[4][4] = {};
+        for (auto& texel : block.texels)
+        {
+            for (uint32_t r = 0; r < numChannels; ++r)
+            {
+                for (uint32_t c = 0; c < numChannels; ++c) covariance[r][c] += (texel[r] - mean[r]) * (texel[c] - mean[c]);
+            }
+        }
+
+        // power iteration, starting from the diagonal so that the initial axis isn't orthogonal to the principal axis
+        float axis[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t c = 0; c < numChannels; ++c) axis[c] = covariance[c][c];
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            float next[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            float length2 = 0.0f;
+            for (uint32_t r = 0; r < numChannels; ++r)
+            {
+                for (uint32_t c = 0; c < numChannels; ++c) next[r] += covariance[r][c] * axis[c];
+                length2 += next[r] * next[r];
+            }
+            if (length2 <= 0.0f) break;
+
+            float inverseLength = 1.0f / std::sqrt(length2);
+            for (uint32_t c = 0; c < numChannels; ++c) axis[c] = next[c] * inverseLength;
+        }
+
+        float minT = 0.0f, maxT = 0.0f;
+        for (auto& texel : block.texels)
+        {
+            float t = 0.0f;
+            for (uint32_t c = 0; c < numChannels; ++c) t += (texel[c] - mean[c]) * axis[c];
+            minT = std::min(minT, t);
+            maxT = std::max(maxT, t);
+        }
+
+        for (uint32_t c = 0; c < numChannels; ++c)
+        {
+            e0[c] = clamp255(mean[c] + axis[c] * minT);
+            e1[c] = clamp255(mean[c] + axis[c] * maxT);
+        }
+    }
+
+    // least squares fit of the endpoints to the texels given the interpolation weight of each texel between the endpoints, return false if the system is degenerate
+    bool refineEndpoints(const Block& block, uint32_t numChannels, const float weights[16], float e0[4], float e1[4])
+    {
+        double aa = 0.0, ab = 0.0, bb = 0.0;
+        double ax[4] = {0.0, 0.0, 0.0, 0.0};
+        double bx[4] = {0.0, 0.0, 0.0, 0.0};
+        for (int i = 0; i < 16; ++i)
+        {
+            double b = weights[i];
+            double a = 1.0 - b;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (uint32_t c = 0; c < numChannels; ++c)
+            {
+                ax[c] += a * block.texels[i][c];
+                bx[c] += b * block.texels[i][c];
+            }
+        }
+
+        double determinant = aa * bb - ab * ab;
+        if (std::abs(determinant) < 1e-6) return false;
+
+        for (uint32_t c = 0; c < numChannels; ++c)
+        {
+            e0[c] = clamp255(static_cast<float>((ax[c] * bb - bx[c] * ab) / determinant));
+            e1[c] = clamp255(static_cast<float>((bx[c] * aa - ax[c] * ab) / determinant));
+        }
+        return true;
+    }
+
+    void writeUint16(uint8_t* dest, uint16_t value)
+    {
+        dest[0] = static_cast<uint8_t>(value & 0xff);
+        dest[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    uint16_t packRGB565(const float color[4])
+    {
+        auto r = static_cast<uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+        auto g = static_cast<uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+        auto b = static_cast<uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void unpackRGB565(uint16_t value, int color[3])
+    {
+        int r = (value >> 11) & 31;
+        int g = (value >> 5) & 63;
+        int b = value & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    // assign the BC1 4 color palette indices, returning the squared error
+    float computeBC1Indices(const Block& block, uint16_t c0, uint16_t c1, uint8_t indices[16])
+    {
+        int palette[4][3];
+        unpackRGB565(c0, palette[0]);
+        unpackRGB565(c1, palette[1]);
+        for (int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        float error = 0.0f;
+        for (int i = 0; i < 16; ++i)
+        {
+            float bestError = std::numeric_limits<float>::max();
+            for (uint8_t p = 0; p < 4; ++p)
+            {
+                float e = 0.0f;
+                for (int c = 0; c < 3; ++c)
+                {
+                    float d = block.texels[i][c] - static_cast<float>(palette[p][c]);
+                    e += d * d;
+                }
+                if (e < bestError)
+                {
+                    bestError = e;
+                    indices[i] = p;
+                }
+            }
+            error += bestError;
+        }
+        return error;
+    }
+
+    // encode the RGB channels as a BC1 color block, only using the 4 color mode so that the block can also be used by BC3
+    void encodeBC1(const Block& block, uint8_t* dest)
+    {
+        float e0[4], e1[4];
+        principalEndpoints(block, 3, e0, e1);
+
+        // the palette runs from c0 to c1, so start with the brighter endpoint as c0 to favour c0 > c1
+        uint16_t c0 = packRGB565(e1);
+        uint16_t c1 = packRGB565(e0);
+        uint8_t indices[16];
+        float error = computeBC1Indices(block, c0, c1, indices);
+
+        constexpr float paletteWeights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+        for (int iteration = 0; iteration < 2 && error > 0.0f; ++iteration)
+        {
+            float weights[16];
+            for (int i = 0; i < 16; ++i) weights[i] = paletteWeights[indices[i]];
+            if (!refineEndpoints(block, 3, weights, e0, e1)) break;
+
+            uint16_t refined0 = packRGB565(e0);
+            uint16_t refined1 = packRGB565(e1);
+            uint8_t refinedIndices[16];
+            float refinedError = computeBC1Indices(block, refined0, refined1, refinedIndices);
+            if (refinedError >= error) break;
+
+            c0 = refined0;
+            c1 = refined1;
+            error = refinedError;
+            std::copy(refinedIndices, refinedIndices + 16, indices);
+        }
+
+        if (c0 < c1)
+        {
+            // swap the endpoints so c0 > c1 selects the 4 color mode, swapping indices 0 <-> 1 and 2 <-> 3
+            std::swap(c0, c1);
+            for (auto& index : indices) index ^= 1;
+        }
+        else if (c0 == c1)
+        {
+            for (auto& index : indices) index = 0;
+        }
+
+        uint32_t bits = 0;
+        for (int i = 0; i < 16; ++i) bits |= static_cast<uint32_t>(indices[i]) << (i * 2);
+
+        writeUint16(dest, c0);
+        writeUint16(dest + 2, c1);
+        writeUint16(dest + 4, static_cast<uint16_t>(bits & 0xffff));
+        writeUint16(dest + 6, static_cast<uint16_t>(bits >> 16));
+    }
+
+    // encode a single channel as a BC4 block, using the 8 value mode between the channel's minimum and maximum
+    void encodeBC4(const Block& block, uint32_t channel, uint8_t* dest)
+    {
+        float minValue = 255.0f, maxValue = 0.0f;
+        for (auto& texel : block.texels)
+        {
+            minValue = std::min(minValue, texel[channel]);
+            maxValue = std::max(maxValue, texel[channel]);
+        }
+
+        auto a0 = static_cast<uint8_t>(std::lround(maxValue));
+        auto a1 = static_cast<uint8_t>(std::lround(minValue));
+
+        uint64_t bits = 0;
+        if (a0 > a1)
+        {
+            float scale = 7.0f / static_cast<float>(a0 - a1);
+            for (int i = 0; i < 16; ++i)
+            {
+                // position 0 is a0 and 7 is a1, codes 0 and 1 are the endpoints and codes 2 to 7 the interpolated values between them
+                auto position = static_cast<uint64_t>(std::lround((static_cast<float>(a0) - block.texels[i][channel]) * scale));
+                position = std::min<uint64_t>(position, 7);
+                uint64_t code = position == 0 ? 0 : (position == 7 ? 1 : position + 1);
+                bits |= code << (i * 3);
+            }
+        }
+
+        dest[0] = a0;
+        dest[1] = a1;
+        for (int i = 0; i < 6; ++i) dest[2 + i] = static_cast<uint8_t>((bits >> (i * 8)) & 0xff);
+    }
+
+    // BC7 mode 6, a single subset of RGBA endpoints with 7 bit components plus a per endpoint p-bit, and 4 bit indices
+    constexpr int bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    struct BC7Endpoint
+    {
+        int components[4]; // 7 bit
+        int pbit;
+
+        int value(int c) const { return (components[c] << 1) | pbit; }
+    };
+
+    BC7Endpoint quantizeBC7Endpoint(const float endpoint[4])
+    {
+        BC7Endpoint best{};
+        float bestError = std::numeric_limits<float>::max();
+        for (int pbit = 0; pbit < 2; ++pbit)
+        {
+            BC7Endpoint candidate{};
+            candidate.pbit = pbit;
+            float error = 0.0f;
+            for (int c = 0; c < 4; ++c)
+            {
+                candidate.components[c] = std::clamp(static_cast<int>(std::lround((endpoint[c] - static_cast<float>(pbit)) * 0.5f)), 0, 127);
+                float d = endpoint[c] - static_cast<float>(candidate.value(c));
+                error += d * d;
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                best = candidate;
+            }
+        }
+        return best;
+    }
+
+    float computeBC7Indices(const Block& block, const BC7Endpoint& q0, const BC7Endpoint& q1, uint8_t indices[16])
+    {
+        int palette[16][4];
+        for (int p = 0; p < 16; ++p)
+        {
+            int w = bc7Weights4[p];
+            for (int c = 0; c < 4; ++c) palette[p][c] = ((64 - w) * q0.value(c) + w * q1.value(c) + 32) >> 6;
+        }
+
+        float error = 0.0f;
+        for (int i = 0; i < 16; ++i)
+        {
+            float bestError = std::numeric_limits<float>::max();
+            for (uint8_t p = 0; p < 16; ++p)
+            {
+                float e = 0.0f;
+                for (int c = 0; c < 4; ++c)
+                {
+                    float d = block.texels[i][c] - static_cast<float>(palette[p][c]);
+                    e += d * d;
+                }
+                if (e < bestError)
+                {
+                    bestError = e;
+                    indices[i] = p;
+                }
+            }
+            error += bestError;
+        }
+        return error;
+    }
+
+    struct BitWriter
+    {
+        uint8_t* dest;
+        uint32_t position = 0;
+
+        void write(uint32_t value, uint32_t numBits)
+        {
+            for (uint32_t i = 0; i < numBits; ++i, ++position)
+            {
+                if ((value >> i) & 1) dest[position / 8] |= static_cast<uint8_t>(1u << (position % 8));
+            }
+        }
+    };
+
+    void encodeBC7(const Block& block, uint8_t* dest)
+    {
+        float e0[4], e1[4];
+        principalEndpoints(block, 4, e0, e1);
+
+        BC7Endpoint q0 = quantizeBC7Endpoint(e0);
+        BC7Endpoint q1 = quantizeBC7Endpoint(e1);
+        uint8_t indices[16];
+        float error = computeBC7Indices(block, q0, q1, indices);
+
+        for (int iteration = 0; iteration < 2 && error > 0.0f; ++iteration)
+        {
+            float weights[16];
+            for (int i = 0; i < 16; ++i) weights[i] = static_cast<float>(bc7Weights4[indices[i]]) / 64.0f;
+            if (!refineEndpoints(block, 4, weights, e0, e1)) break;
+
+            BC7Endpoint refined0 = quantizeBC7Endpoint(e0);
+            BC7Endpoint refined1 = quantizeBC7Endpoint(e1);
+            uint8_t refinedIndices[16];
+            float refinedError = computeBC7Indices(block, refined0, refined1, refinedIndices);
+            if (refinedError >= error) break;
+
+            q0 = refined0;
+            q1 = refined1;
+            error = refinedError;
+            std::copy(refinedIndices, refinedIndices + 16, indices);
+        }
+
+        // the most significant bit of the first texel's index is implicitly 0, so swap the endpoints if it's set
+        if (indices[0] >= 8)
+        {
+            std::swap(q0, q1);
+            for (auto& index : indices) index = static_cast<uint8_t>(15 - index);
+        }
+
+        std::fill(dest, dest + 16, uint8_t(0));
+        BitWriter writer{dest};
+        writer.write(1u << 6, 7);
+        for (int c = 0; c < 4; ++c)
+        {
+            writer.write(static_cast<uint32_t>(q0.components[c]), 7);
+            writer.write(static_cast<uint32_t>(q1.components[c]), 7);
+        }
+        writer.write(static_cast<uint32_t>(q0.pbit), 1);
+        writer.write(static_cast<uint32_t>(q1.pbit), 1);
+        writer.write(indices[0], 3);
+        for (int i = 1; i < 16; ++i) writer.write(indices[i], 4);
+    }
+
+    void encodeBlock(BlockCompression compression, const Block& block, uint8_t* dest)
+    {
+        switch (compression)
+        {
+        case BLOCK_COMPRESSION_BC1:
+            encodeBC1(block, dest);
+            break;
+        case BLOCK_COMPRESSION_BC3:
+            encodeBC4(block, 3, dest);
+            encodeBC1(block, dest + 8);
+            break;
+        case BLOCK_COMPRESSION_BC4:
+            encodeBC4(block, 0, dest);
+            break;
+        case BLOCK_COMPRESSION_BC5:
+            encodeBC4(block, 0, dest);
+            encodeBC4(block, 1, dest + 8);
+            break;
+        case BLOCK_COMPRESSION_BC7:
+            encodeBC7(block, dest);
+            break;
+        }
+    }
+
+    VkFormat blockFormat(BlockCompression compression, bool sRGB)
+    {
+        switch (compression)
+        {
+        case BLOCK_COMPRESSION_BC1: return sRGB ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+        case BLOCK_COMPRESSION_BC3: return sRGB ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+        case BLOCK_COMPRESSION_BC4: return VK_FORMAT_BC4_UNORM_BLOCK;
+        case BLOCK_COMPRESSION_BC5: return VK_FORMAT_BC5_UNORM_BLOCK;
+        default: return sRGB ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+        }
+    }
+} // namespace
+
+ref_ptr<Data> vsg::createMipmaps(const Data* data, uint32_t maxNumMipmaps, MipmapFilter filter, OperationThreads* operationThreads)
+{
+    PixelLayout layout;
+    if (!checkImage(data, "vsg::createMipmaps", layout)) return {};
+
+    uint32_t width = data->width();
+    uint32_t height = data->height();
+
+    uint32_t numLevels = 1;
+    while ((std::max(width, height) >> numLevels) > 0) ++numLevels;
+    if (maxNumMipmaps > 0) numLevels = std::min(numLevels, maxNumMipmaps);
+    numLevels = std::min(numLevels, 255u);
+
+    auto properties = data->properties;
+    properties.maxNumMipmaps = static_cast<uint8_t>(numLevels);
+
+    auto image = createImage(layout, width, height, properties);
+    auto mipmapOffsets = image->computeMipmapOffsets();
+    if (mipmapOffsets.empty()) mipmapOffsets.push_back(0);
+
+    uint32_t pixelSize = layout.pixelSize();
+    auto dest = static_cast<uint8_t*>(image->dataPointer());
+
+    // decode the base level to linear floats, while copying it unchanged to the new image
+    std::vector<float> levelImage(static_cast<size_t>(width) * height * 4);
+    forEachRow(operationThreads, height, [&](size_t begin, size_t end) {
+        std::vector<uint8_t> rowBuffer;
+        std::vector<float> decodeBuffer;
+        for (size_t y = begin; y < end; ++y)
+        {
+            auto row = sourceRow(data, y * width, width, pixelSize, rowBuffer);
+            std::memcpy(dest + y * width * pixelSize, row, static_cast<size_t>(width) * pixelSize);
+            decodeRow(layout, row, levelImage.data() + y * width * 4, width, decodeBuffer);
+        }
+    });
+
+    std::vector<float> nextLevelImage;
+    std::vector<float> intermediate;
+    for (size_t level = 1; level < mipmapOffsets.size(); ++level)
+    {
+        uint32_t nextWidth = width > 1 ? width / 2 : 1;
+        uint32_t nextHeight = height > 1 ? height / 2 : 1;
+
+        nextLevelImage.resize(static_cast<size_t>(nextWidth) * nextHeight * 4);
+        downsample(levelImage.data(), width, height, nextLevelImage.data(), nextWidth, nextHeight, filter, intermediate, operationThreads);
+
+        uint8_t* levelDest = dest + mipmapOffsets[level] * pixelSize;
+        forEachRow(operationThreads, nextHeight, [&](size_t begin, size_t end) {
+            std::vector<float> encodeBuffer;
+            for (size_t y = begin; y < end; ++y)
+            {
+                encodeRow(layout, nextLevelImage.data() + y * nextWidth * 4, levelDest + y * nextWidth * pixelSize, nextWidth, encodeBuffer);
+            }
+        });
+
+        levelImage.swap(nextLevelImage);
+        width = nextWidth;
+        height = nextHeight;
+    }
+
+    return image;
+}
+
+ref_ptr<Data> vsg::compressImage(const Data* data, BlockCompression compression, OperationThreads* operationThreads)
+{
+    PixelLayout layout;
+    if (!checkImage(data, "vsg::compressImage", layout)) return {};
+
+    auto sourceOffsets = data->computeMipmapOffsets();
+    if (sourceOffsets.empty()) sourceOffsets.push_back(0);
+
+    uint32_t width = data->width();
+    uint32_t height = data->height();
+    uint32_t blocksWide = (width + 3) / 4;
+    uint32_t blocksHigh = (height + 3) / 4;
+
+    // only compress the levels whose dimensions in blocks match the halving of the block dimensions done by Data::computeMipmapOffsets(), which stops at a single block
+    uint32_t numLevels = 1;
+    for (uint32_t bw = blocksWide, bh = blocksHigh; numLevels < sourceOffsets.size() && (bw > 1 || bh > 1); ++numLevels)
+    {
+        if (bw > 1) bw /= 2;
+        if (bh > 1) bh /= 2;
+
+        uint32_t levelWidth = std::max(width >> numLevels, 1u);
+        uint32_t levelHeight = std::max(height >> numLevels, 1u);
+        if ((levelWidth + 3) / 4 != bw || (levelHeight + 3) / 4 != bh) break;
+    }
+
+    Data::Properties properties = data->properties;
+    properties.format = blockFormat(compression, layout.sRGB);
+    properties.blockWidth = 4;
+    properties.blockHeight = 4;
+    properties.maxNumMipmaps = static_cast<uint8_t>(numLevels > 1 ? numLevels : 0);
+
+    ref_ptr<Data> image;
+    if (compression == BLOCK_COMPRESSION_BC1 || compression == BLOCK_COMPRESSION_BC4)
+        image = createArray2D<block64Array2D>(blocksWide, blocksHigh, properties);
+    else
+        image = createArray2D<block128Array2D>(blocksWide, blocksHigh, properties);
+
+    auto mipmapOffsets = image->computeMipmapOffsets();
+    if (mipmapOffsets.empty()) mipmapOffsets.push_back(0);
+
+    uint32_t blockSize = static_cast<uint32_t>(image->valueSize());
+    uint32_t stride = data->stride();
+    auto dest = static_cast<uint8_t*>(image->dataPointer());
+
+    for (uint32_t level = 0; level < numLevels; ++level)
+    {
+        uint32_t levelWidth = std::max(width >> level, 1u);
+        uint32_t levelHeight = std::max(height >> level, 1u);
+        uint32_t levelBlocksWide = (levelWidth + 3) / 4;
+        uint32_t levelBlocksHigh = (levelHeight + 3) / 4;
+
+        auto source = static_cast<const uint8_t*>(data->dataPointer(sourceOffsets[level]));
+        uint8_t* levelDest = dest + mipmapOffsets[level] * blockSize;
+
+        forEachRow(operationThreads, levelBlocksHigh, [&](size_t begin, size_t end) {
+            Block block;
+            for (size_t by = begin; by < end; ++by)
+            {
+                for (uint32_t bx = 0; bx < levelBlocksWide; ++bx)
+                {
+                    fetchBlock(layout, source, stride, levelWidth, levelHeight, bx, static_cast<uint32_t>(by), block);
+                    encodeBlock(compression, block, levelDest + (by * levelBlocksWide + bx) * blockSize);
+                }
+            }
+        });
+    }
+
+    return image;
+}
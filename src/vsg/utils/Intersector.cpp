@@ -236,3 +236,11 @@ void Intersector::apply(const DrawIndexed& drawIndexed)
 
     intersectDrawIndexed(drawIndexed.firstIndex, drawIndexed.indexCount, drawIndexed.firstInstance, drawIndexed.instanceCount);
 }
+
+ref_ptr<const TriangleBVH> Intersector::getTriangleBVH(ref_ptr<const vec3Array> vertices, ref_ptr<const Data> indices, uint32_t first, uint32_t count)
+{
+    // building a TriangleBVH only pays off when it's reused, so only use one when a long lived TriangleBVHCache has been assigned
+    if (!useTriangleBVH || !triangleBVHCache || !vertices || _nodePath.empty() || (count / 3) < minimumTriangleBVHSize) return {};
+
+    return triangleBVHCache->getOrCreate(_nodePath.back(), vertices, indices, first, count);
+}
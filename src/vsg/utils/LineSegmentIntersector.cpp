@@ -244,6 +244,45 @@ bool LineSegmentIntersector::intersects(const dsphere& bs)
     return true;
 }
 
+bool LineSegmentIntersector::intersectTriangleBVH(ArrayState& arrayState, ref_ptr<const Data> indices, uint32_t first, uint32_t count, uint32_t firstInstance, uint32_t instanceCount)
+{
+    auto bvh = getTriangleBVH(arrayState.vertices, indices, first, count);
+    if (!bvh) return false;
+
+    const auto& ls = _lineSegmentStack.back();
+
+    _triangleCandidates.clear();
+    bvh->intersect(ls.start, ls.end, _triangleCandidates);
+
+    uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
+    for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
+    {
+        TriangleIntersector<double> triIntersector(*this, ls.start, ls.end, arrayState.vertexArray(instanceIndex));
+        if (!triIntersector.vertices) continue;
+
+        triIntersector.instanceIndex = instanceIndex;
+
+        if (triIntersector.vertices == arrayState.vertices)
+        {
+            for (auto c : _triangleCandidates)
+            {
+                const auto& t = bvh->triangles[c];
+                triIntersector.intersect(t.x, t.y, t.z);
+            }
+        }
+        else
+        {
+            // per instance vertex arrays computed by the ArrayState aren't covered by the TriangleBVH so test all the triangles
+            for (const auto& t : bvh->triangles)
+            {
+                triIntersector.intersect(t.x, t.y, t.z);
+            }
+        }
+    }
+
+    return true;
+}
+
 bool LineSegmentIntersector::intersectDraw(uint32_t firstVertex, uint32_t vertexCount, uint32_t firstInstance, uint32_t instanceCount)
 {
     auto& arrayState = *arrayStateStack.back();
@@ -252,6 +291,8 @@ bool LineSegmentIntersector::intersectDraw(uint32_t firstVertex, uint32_t vertex
     const auto& ls = _lineSegmentStack.back();
 
     size_t previous_size = intersections.size();
+    if (intersectTriangleBVH(arrayState, {}, firstVertex, vertexCount, firstInstance, instanceCount)) return intersections.size() != previous_size;
+
     uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
     for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
     {
@@ -277,6 +318,9 @@ bool LineSegmentIntersector::intersectDrawIndexed(uint32_t firstIndex, uint32_t
     const auto& ls = _lineSegmentStack.back();
 
     size_t previous_size = intersections.size();
+    if (ushort_indices && intersectTriangleBVH(arrayState, ushort_indices, firstIndex, indexCount, firstInstance, instanceCount)) return intersections.size() != previous_size;
+    if (uint_indices && intersectTriangleBVH(arrayState, uint_indices, firstIndex, indexCount, firstInstance, instanceCount)) return intersections.size() != previous_size;
+
     uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
     for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
     {
@@ -303,11 +303,52 @@ bool PolytopeIntersector::intersects(const dsphere& bs)
     return vsg::intersect(polytope, bs);
 }
 
+bool PolytopeIntersector::intersectTriangleBVH(ArrayState& arrayState, ref_ptr<const Data> indices, uint32_t first, uint32_t count, uint32_t firstInstance, uint32_t instanceCount)
+{
+    if (arrayState.topology != VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST) return false;
+
+    auto bvh = getTriangleBVH(arrayState.vertices, indices, first, count);
+    if (!bvh) return false;
+
+    const auto& polytope = _polytopeStack.back();
+
+    _triangleCandidates.clear();
+    bvh->intersect(polytope, _triangleCandidates);
+
+    PolytopePrimitiveIntersection primitiveIntersection(*this, arrayState, polytope);
+
+    uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
+    for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
+    {
+        if (!primitiveIntersection.instance(instanceIndex)) continue;
+
+        if (primitiveIntersection.sourceVertices == arrayState.vertices)
+        {
+            for (auto c : _triangleCandidates)
+            {
+                const auto& t = bvh->triangles[c];
+                primitiveIntersection.triangle(t.x, t.y, t.z);
+            }
+        }
+        else
+        {
+            // per instance vertex arrays computed by the ArrayState aren't covered by the TriangleBVH so test all the triangles
+            for (const auto& t : bvh->triangles)
+            {
+                primitiveIntersection.triangle(t.x, t.y, t.z);
+            }
+        }
+    }
+
+    return true;
+}
+
 bool PolytopeIntersector::intersectDraw(uint32_t firstVertex, uint32_t vertexCount, uint32_t firstInstance, uint32_t instanceCount)
 {
     size_t previous_size = intersections.size();
 
     auto& arrayState = *arrayStateStack.back();
+    if (intersectTriangleBVH(arrayState, {}, firstVertex, vertexCount, firstInstance, instanceCount)) return intersections.size() != previous_size;
 
     vsg::PrimitiveFunctor<vsg::PolytopePrimitiveIntersection> printPrimitives(*this, arrayState, _polytopeStack.back());
     printPrimitives.draw(arrayState.topology, firstVertex, vertexCount, firstInstance, instanceCount);
@@ -321,6 +362,16 @@ bool PolytopeIntersector::intersectDrawIndexed(uint32_t firstIndex, uint32_t ind
 
     auto& arrayState = *arrayStateStack.back();
 
+    ref_ptr<const Data> indices;
+    if (ubyte_indices)
+        indices = ubyte_indices;
+    else if (ushort_indices)
+        indices = ushort_indices;
+    else if (uint_indices)
+        indices = uint_indices;
+
+    if (indices && intersectTriangleBVH(arrayState, indices, firstIndex, indexCount, firstInstance, instanceCount)) return intersections.size() != previous_size;
+
     vsg::PrimitiveFunctor<vsg::PolytopePrimitiveIntersection> printPrimtives(*this, arrayState, _polytopeStack.back());
     if (ubyte_indices)
         printPrimtives.drawIndexed(arrayState.topology, ubyte_indices, firstIndex, indexCount, firstInstance, instanceCount);
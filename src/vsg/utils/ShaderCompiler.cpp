@@ -17,7 +17,10 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/raytracing/RayTracingPipeline.h>
 #include <vsg/state/ComputePipeline.h>
 #include <vsg/state/GraphicsPipeline.h>
+#include <vsg/threading/OperationThreads.h>
+#include <vsg/utils/Instrumentation.h>
 #include <vsg/utils/ShaderCompiler.h>
+#include <vsg/utils/ShaderSet.h>
 
 #if VSG_SUPPORTS_ShaderCompiler
 #    include <glslang/Public/ResourceLimits.h>
@@ -30,7 +33,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <future>
 #include <iomanip>
+#include <thread>
 
 #ifndef VK_API_VERSION_MAJOR
 #    define VK_API_VERSION_MAJOR(version) (((uint32_t)(version) >> 22) & 0x7FU)
@@ -93,6 +102,77 @@ namespace
         }
     }
 #endif
+
+    // identifies the format of SPIRV cache files, increment when the layout changes
+    constexpr char s_cacheMagic[8] = {'v', 's', 'g', 's', 'p', 'v', '0', '1'};
+
+    uint64_t fnv1a(const std::string& str)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (auto c : str)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    Path cacheFilename(const Path& directory, const std::string& key)
+    {
+        std::ostringstream str;
+        str << std::hex << std::setw(16) << std::setfill('0') << fnv1a(key) << ".spv";
+        return directory / str.str();
+    }
+
+    template<typename T>
+    bool readValue(FILE* file, T& value)
+    {
+        return std::fread(&value, sizeof(T), 1, file) == 1;
+    }
+
+    template<typename T>
+    bool writeValue(FILE* file, const T& value)
+    {
+        return std::fwrite(&value, sizeof(T), 1, file) == 1;
+    }
+
+    bool requiresCompile(const ref_ptr<ShaderStage>& stage)
+    {
+        return stage && stage->module && stage->module->code.empty() && !stage->module->source.empty();
+    }
+
+    // collect the ShaderStages of each pipeline that require compiling, pipelines that share the same ShaderStages are only collected once
+    struct CollectShaderStages : public Visitor
+    {
+        std::set<ShaderStages> visited;
+        std::vector<ShaderStages> shaderStagesList;
+
+        void add(const ShaderStages& stages)
+        {
+            if (!std::any_of(stages.begin(), stages.end(), requiresCompile)) return;
+            if (visited.insert(stages).second) shaderStagesList.push_back(stages);
+        }
+
+        void apply(Node& node) override
+        {
+            node.traverse(*this);
+        }
+
+        void apply(BindGraphicsPipeline& bgp) override
+        {
+            if (bgp.pipeline) add(bgp.pipeline->stages);
+        }
+
+        void apply(BindComputePipeline& bcp) override
+        {
+            if (bcp.pipeline && bcp.pipeline->stage) add(ShaderStages{bcp.pipeline->stage});
+        }
+
+        void apply(BindRayTracingPipeline& brtp) override
+        {
+            if (auto pipeline = brtp.getPipeline()) add(pipeline->getShaderStages());
+        }
+    };
 } // namespace
 
 std::string debugFormatShaderSource(const std::string& source)
@@ -196,11 +276,30 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
     });
 #    endif
 
+    // final sources are computed up front as they are required for the cache key
+    std::vector<std::string> finalSources;
+    finalSources.reserve(shaders.size());
+    for (auto& vsg_shader : shaders)
+    {
+        finalSources.push_back(finalShaderSource(*vsg_shader, defines, options));
+    }
+
+    std::string cacheKey;
+    auto cacheDir = getCacheDirectory(options);
+    if (cacheDir)
+    {
+        cacheKey = _cacheKey(shaders, finalSources);
+        if (_readFromCache(cacheDir, cacheKey, shaders)) return true;
+    }
+
     StageShaderMap stageShaderMap;
     std::unique_ptr<glslang::TProgram> program(new glslang::TProgram);
 
+    auto finalSourceItr = finalSources.begin();
     for (auto& vsg_shader : shaders)
     {
+        const std::string& shaderSource = *(finalSourceItr++);
+
         EShLanguage envStage = EShLangCount;
 
         glslang::EShTargetLanguageVersion minTargetLanguageVersion = glslang::EShTargetSpv_1_0;
@@ -278,15 +377,7 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
         shader->setEnvClient(glslang::EShClientVulkan, targetClientVersion);
         shader->setEnvTarget(glslang::EShTargetSpv, targetLanguageVersion);
 
-        std::string finalShaderSource = vsg::insertIncludes(vsg_shader->module->source, options);
-
-        std::vector<std::string> combinedDefines(defines);
-        for (auto& define : settings->defines) combinedDefines.push_back(define);
-        if (!combinedDefines.empty()) finalShaderSource = combineSourceAndDefines(finalShaderSource, combinedDefines);
-
-        vsg::debug("ShaderCompiler::compile() combinedDefines = ", combinedDefines);
-
-        const char* str = finalShaderSource.c_str();
+        const char* str = shaderSource.c_str();
         shader->setStrings(&str, 1);
 
         EShMessages messages = EShMsgDefault;
@@ -298,7 +389,7 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
 
         if (parseResult)
         {
-            debug("Successful compile\n", debugFormatShaderSource(finalShaderSource), "\n");
+            debug("Successful compile\n", debugFormatShaderSource(shaderSource), "\n");
 
             program->addShader(shader);
             stageShaderMap[envStage] = vsg_shader;
@@ -307,7 +398,7 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
         {
             // print error information
             warn("\n----  ", getFriendlyNameForShader(vsg_shader), "  ---- \n");
-            warn(debugFormatShaderSource(finalShaderSource));
+            warn(debugFormatShaderSource(shaderSource));
             warn("GLSL source failed to parse.");
             warn("glslang info log:\n", shader->getInfoLog());
             info("glslang debug info log: \n", shader->getInfoDebugLog());
@@ -380,6 +471,8 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
         }
     }
 
+    if (cacheDir) _writeToCache(cacheDir, cacheKey, shaders);
+
     return true;
 }
 #else
@@ -398,6 +491,362 @@ bool ShaderCompiler::compile(ref_ptr<ShaderStage> shaderStage, const std::vector
     return compile(stages, defines, options);
 }
 
+bool ShaderCompiler::compile(ShaderSet& shaderSet, const std::vector<std::set<std::string>>& defineSets, ref_ptr<const Options> options)
+{
+    std::vector<std::set<std::string>> variantDefines(defineSets);
+    if (variantDefines.empty())
+    {
+        std::set<std::string> baseDefines;
+        if (shaderSet.defaultShaderHints) baseDefines = shaderSet.defaultShaderHints->defines;
+        variantDefines.push_back(baseDefines);
+
+        for (auto& definesArrayState : shaderSet.definesArrayStates)
+        {
+            auto defines = baseDefines;
+            defines.insert(definesArrayState.defines.begin(), definesArrayState.defines.end());
+            variantDefines.push_back(defines);
+        }
+
+        std::scoped_lock<std::mutex> lock(shaderSet.mutex);
+        for (auto& [scs, stages] : shaderSet.variants)
+        {
+            if (scs) variantDefines.push_back(scs->defines);
+        }
+    }
+
+    // remove duplicate sets of defines
+    std::sort(variantDefines.begin(), variantDefines.end());
+    variantDefines.erase(std::unique(variantDefines.begin(), variantDefines.end()), variantDefines.end());
+
+    std::vector<ref_ptr<ShaderCompileSettings>> variantSettings;
+    for (auto& defines : variantDefines)
+    {
+        auto scs = shaderSet.defaultShaderHints ? ShaderCompileSettings::create(*shaderSet.defaultShaderHints) : ShaderCompileSettings::create();
+        scs->defines = defines;
+        variantSettings.push_back(scs);
+    }
+
+    return compileVariants(shaderSet, variantSettings, options);
+}
+
+bool ShaderCompiler::compileVariants(ShaderSet& shaderSet, const std::vector<ref_ptr<ShaderCompileSettings>>& variantSettings, ref_ptr<const Options> options)
+{
+    CPU_INSTRUMENTATION_L1_NC(options ? options->instrumentation.get() : nullptr, "ShaderCompiler compileVariants", COLOR_COMPILE);
+
+    struct PendingVariant
+    {
+        ref_ptr<ShaderCompileSettings> scs;
+        ShaderStages stages;
+        std::promise<ShaderStages> promise;
+    };
+    std::list<PendingVariant> pendingVariants;
+    std::vector<ShaderStages> stagesToCompile;
+
+    // if an exception is thrown remove the pending variants so that later getShaderStages(..) calls create them afresh,
+    // and pass the exception on to the threads waiting for them, must be called with the shaderSet.mutex locked
+    auto abandonPendingVariants = [&](std::exception_ptr exception) {
+        for (auto& pending : pendingVariants)
+        {
+            shaderSet.pendingVariants.erase(pending.scs);
+            pending.promise.set_exception(exception);
+        }
+    };
+
+    {
+        std::scoped_lock<std::mutex> lock(shaderSet.mutex);
+        try
+        {
+            for (auto& scs : variantSettings)
+            {
+                // skip variants that another thread is already compiling
+                if (shaderSet.pendingVariants.count(scs) != 0) continue;
+
+                if (auto itr = shaderSet.variants.find(scs); itr != shaderSet.variants.end())
+                {
+                    // existing variants are compiled in place
+                    if (std::any_of(itr->second.begin(), itr->second.end(), requiresCompile)) stagesToCompile.push_back(itr->second);
+                }
+                else
+                {
+                    // new variants are registered as pending so that getShaderStages(..) calls wait for them to be compiled
+                    auto stages = shaderSet.createShaderStages(scs);
+                    auto& pending = pendingVariants.emplace_back();
+                    pending.scs = scs;
+                    pending.stages = stages;
+                    shaderSet.pendingVariants[scs] = pending.promise.get_future().share();
+
+                    if (std::any_of(pending.stages.begin(), pending.stages.end(), requiresCompile)) stagesToCompile.push_back(pending.stages);
+                }
+            }
+        }
+        catch (...)
+        {
+            abandonPendingVariants(std::current_exception());
+            throw;
+        }
+    }
+
+    bool result = false;
+    try
+    {
+        result = compile(stagesToCompile, options);
+    }
+    catch (...)
+    {
+        std::scoped_lock<std::mutex> lock(shaderSet.mutex);
+        abandonPendingVariants(std::current_exception());
+        throw;
+    }
+
+    {
+        std::scoped_lock<std::mutex> lock(shaderSet.mutex);
+        for (auto& pending : pendingVariants)
+        {
+            // variants that failed to compile are still added, their pipelines will report the errors when they attempt to compile them
+            shaderSet.variants[pending.scs] = pending.stages;
+            shaderSet.pendingVariants.erase(pending.scs);
+            pending.promise.set_value(pending.stages);
+        }
+    }
+
+    return result;
+}
+
+bool ShaderCompiler::compile(std::vector<ShaderStages>& shaderStagesList, ref_ptr<const Options> options)
+{
+    if (shaderStagesList.empty()) return true;
+
+    auto instrumentation = options ? options->instrumentation : ref_ptr<Instrumentation>();
+    auto operationThreads = options ? options->operationThreads : ref_ptr<OperationThreads>();
+
+    CPU_INSTRUMENTATION_L1_NC(instrumentation, "ShaderCompiler compile ShaderStages list", COLOR_COMPILE);
+
+    // ShaderStages shared between entries can't be compiled concurrently, so split the entries into rounds that have no ShaderStage in common
+    std::vector<std::vector<size_t>> rounds;
+    std::vector<std::set<const ShaderStage*>> roundStages;
+    for (size_t i = 0; i < shaderStagesList.size(); ++i)
+    {
+        auto& stages = shaderStagesList[i];
+        auto shared = [&](const std::set<const ShaderStage*>& existing) {
+            return std::any_of(stages.begin(), stages.end(), [&](const ref_ptr<ShaderStage>& stage) { return existing.count(stage.get()) != 0; });
+        };
+
+        size_t r = 0;
+        while (r < rounds.size() && shared(roundStages[r])) ++r;
+        if (r == rounds.size())
+        {
+            rounds.emplace_back();
+            roundStages.emplace_back();
+        }
+
+        rounds[r].push_back(i);
+        for (auto& stage : stages) roundStages[r].insert(stage.get());
+    }
+
+    std::atomic_uint numFailed = 0;
+    const std::vector<size_t>* round = nullptr;
+    auto compileRange = [&](size_t begin, size_t end) {
+        auto taskInstrumentation = shareOrDuplicateForThreadSafety(instrumentation);
+
+        // glslang shaders and programs can't be shared between threads, so each task uses its own ShaderCompiler
+        auto compiler = ShaderCompiler::create();
+        compiler->defaults = defaults;
+        compiler->cacheDirectory = cacheDirectory;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            CPU_INSTRUMENTATION_L2_NC(taskInstrumentation, "ShaderCompiler compile variant", COLOR_COMPILE);
+
+            auto& stages = shaderStagesList[(*round)[i]];
+            if (std::any_of(stages.begin(), stages.end(), requiresCompile) && !compiler->compile(stages, {}, options)) ++numFailed;
+        }
+    };
+
+    for (auto& indices : rounds)
+    {
+        round = &indices;
+        if (operationThreads && indices.size() > 1)
+        {
+            operationThreads->parallel_for(0, indices.size(), compileRange, 1);
+        }
+        else
+        {
+            compileRange(0, indices.size());
+        }
+    }
+
+    return numFailed == 0;
+}
+
+std::vector<ShaderStages> ShaderCompiler::collectShaderStages(Object& object)
+{
+    CollectShaderStages collect;
+    object.accept(collect);
+    return collect.shaderStagesList;
+}
+
+std::string ShaderCompiler::finalShaderSource(const ShaderStage& shaderStage, const std::vector<std::string>& defines, ref_ptr<const Options> options)
+{
+    auto settings = shaderStage.module->hints ? shaderStage.module->hints : defaults;
+
+    std::string source = vsg::insertIncludes(shaderStage.module->source, options);
+
+    std::vector<std::string> combinedDefines(defines);
+    for (auto& define : settings->defines) combinedDefines.push_back(define);
+    if (!combinedDefines.empty()) source = combineSourceAndDefines(source, combinedDefines);
+
+    vsg::debug("ShaderCompiler::finalShaderSource() combinedDefines = ", combinedDefines);
+
+    return source;
+}
+
+Path ShaderCompiler::getCacheDirectory(const Options* options) const
+{
+    if (cacheDirectory) return cacheDirectory;
+    if (options && options->fileCache) return options->fileCache / "shaders";
+    return {};
+}
+
+std::string ShaderCompiler::_cacheKey(const ShaderStages& shaders, const std::vector<std::string>& finalSources) const
+{
+    std::ostringstream key;
+
+    // compiler versions, so cached SPIRV is not reused after the compiler or optimizer are updated
+    key << "vsg " << vsgGetVersionString() << "\n";
+#if VSG_SUPPORTS_ShaderCompiler
+    auto glslangVersion = glslang::GetVersion();
+    key << "glslang " << glslangVersion.major << "." << glslangVersion.minor << "." << glslangVersion.patch << " " << glslangVersion.flavor << " spirv generator " << glslang::GetSpirvGeneratorVersion() << "\n";
+#endif
+#if VSG_SUPPORTS_ShaderOptimizer
+    key << "spirv-tools " << spvSoftwareVersionString() << "\n";
+#endif
+
+    auto finalSourceItr = finalSources.begin();
+    for (auto& shader : shaders)
+    {
+        auto settings = shader->module->hints ? shader->module->hints : defaults;
+
+        key << "stage " << shader->stage << " " << shader->entryPointName << "\n";
+        key << "settings " << settings->vulkanVersion << " " << settings->clientInputVersion << " " << settings->language << " " << settings->defaultVersion << " " << settings->target << " "
+            << settings->forwardCompatible << " " << settings->generateDebugInfo << " " << settings->optimize << "\n";
+        key << "defines";
+        for (auto& define : settings->defines) key << " " << define;
+        key << "\n";
+
+        const auto& source = *(finalSourceItr++);
+        key << "source " << source.size() << "\n"
+            << source << "\n";
+    }
+
+    return key.str();
+}
+
+bool ShaderCompiler::_readFromCache(const Path& directory, const std::string& key, ShaderStages& shaders) const
+{
+    auto filename = cacheFilename(directory, key);
+
+    auto file = vsg::fopen(filename, "rb");
+    if (!file) return false;
+
+    // read into temporaries and verify the whole file before assigning to the shaders, so a truncated or mismatched file just results in a recompile
+    auto read = [&]() -> bool {
+        // the file size is used to reject corrupt word counts before allocating space for them
+        if (std::fseek(file, 0, SEEK_END) != 0) return false;
+        long fileSize = std::ftell(file);
+        if (fileSize < 0 || std::fseek(file, 0, SEEK_SET) != 0) return false;
+
+        char magic[sizeof(s_cacheMagic)];
+        if (std::fread(magic, sizeof(magic), 1, file) != 1 || std::memcmp(magic, s_cacheMagic, sizeof(magic)) != 0) return false;
+
+        uint64_t keySize = 0;
+        if (!readValue(file, keySize) || keySize != key.size()) return false;
+
+        std::string fileKey(key.size(), '\0');
+        if (!key.empty() && std::fread(fileKey.data(), key.size(), 1, file) != 1) return false;
+
+        // the full key is stored so that hash collisions are detected
+        if (fileKey != key) return false;
+
+        uint32_t numStages = 0;
+        if (!readValue(file, numStages) || numStages != shaders.size()) return false;
+
+        std::vector<ShaderModule::SPIRV> codes(numStages);
+        for (auto& code : codes)
+        {
+            uint32_t numWords = 0;
+            if (!readValue(file, numWords) || numWords == 0) return false;
+
+            long position = std::ftell(file);
+            if (position < 0 || static_cast<uint64_t>(numWords) * sizeof(uint32_t) > static_cast<uint64_t>(fileSize - position)) return false;
+
+            code.resize(numWords);
+            if (std::fread(code.data(), sizeof(uint32_t), numWords, file) != numWords) return false;
+        }
+
+        auto codeItr = codes.begin();
+        for (auto& shader : shaders)
+        {
+            shader->module->code = std::move(*(codeItr++));
+        }
+        return true;
+    };
+
+    bool result = read();
+    std::fclose(file);
+
+    if (result)
+        debug("ShaderCompiler read SPIRV from cache ", filename);
+    else
+        debug("ShaderCompiler ignoring invalid SPIRV cache file ", filename);
+
+    return result;
+}
+
+bool ShaderCompiler::_writeToCache(const Path& directory, const std::string& key, const ShaderStages& shaders) const
+{
+    // a failure here can be due to another process creating the directory at the same time so rely on the fopen to detect problems
+    makeDirectory(directory);
+
+    auto filename = cacheFilename(directory, key);
+
+    // write to a uniquely named temporary file and then rename it to the final filename so that concurrent readers never see a partially written file
+    static std::atomic_uint s_tempCount = 0;
+    std::ostringstream tempSuffix;
+    tempSuffix << "." << std::hex << std::hash<std::thread::id>()(std::this_thread::get_id()) << "_" << std::chrono::steady_clock::now().time_since_epoch().count() << "_" << (s_tempCount++) << "_" << reinterpret_cast<uintptr_t>(&s_tempCount) << ".tmp";
+    auto tempFilename = filename + tempSuffix.str();
+
+    auto file = vsg::fopen(tempFilename, "wb");
+    if (!file)
+    {
+        debug("ShaderCompiler unable to write SPIRV cache file ", tempFilename);
+        return false;
+    }
+
+    bool result = std::fwrite(s_cacheMagic, sizeof(s_cacheMagic), 1, file) == 1;
+    result = result && writeValue(file, static_cast<uint64_t>(key.size()));
+    result = result && (key.empty() || std::fwrite(key.data(), key.size(), 1, file) == 1);
+    result = result && writeValue(file, static_cast<uint32_t>(shaders.size()));
+    for (auto& shader : shaders)
+    {
+        const auto& code = shader->module->code;
+        result = result && !code.empty() && writeValue(file, static_cast<uint32_t>(code.size()));
+        result = result && std::fwrite(code.data(), sizeof(uint32_t), code.size(), file) == code.size();
+    }
+
+    result = (std::fclose(file) == 0) && result;
+
+    // if another process has already written the same file the rename replaces it with identical contents
+    if (result) result = renameFile(tempFilename, filename);
+
+    if (!result)
+    {
+        debug("ShaderCompiler failed to write SPIRV cache file ", filename);
+        removeFile(tempFilename);
+    }
+
+    return result;
+}
+
 std::string ShaderCompiler::combineSourceAndDefines(const std::string& source, const std::vector<std::string>& defines)
 {
     if (defines.empty()) return source;
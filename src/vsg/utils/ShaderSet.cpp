@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Input.h>
 #include <vsg/io/Output.h>
 #include <vsg/io/read.h>
+#include <vsg/lighting/LightClusters.h>
 #include <vsg/state/ColorBlendState.h>
 #include <vsg/state/DescriptorImage.h>
 #include <vsg/state/InputAssemblyState.h>
@@ -258,14 +259,34 @@ ref_ptr<ArrayState> ShaderSet::getSuitableArrayState(const std::set<std::string>
 
 ShaderStages ShaderSet::getShaderStages(ref_ptr<ShaderCompileSettings> scs)
 {
-    std::scoped_lock<std::mutex> lock(mutex);
-
-    if (auto itr = variants.find(scs); itr != variants.end())
+    std::shared_future<ShaderStages> pending;
     {
-        return itr->second;
+        std::scoped_lock<std::mutex> lock(mutex);
+
+        if (auto itr = variants.find(scs); itr != variants.end())
+        {
+            return itr->second;
+        }
+
+        if (auto itr = pendingVariants.find(scs); itr != pendingVariants.end())
+        {
+            pending = itr->second;
+        }
+        else
+        {
+            auto& new_stages = variants[scs];
+            new_stages = createShaderStages(scs);
+            return new_stages;
+        }
     }
 
-    auto& new_stages = variants[scs];
+    // variant is being compiled on another thread so wait for it rather than creating a duplicate
+    return pending.get();
+}
+
+ShaderStages ShaderSet::createShaderStages(ref_ptr<ShaderCompileSettings> scs) const
+{
+    ShaderStages new_stages;
     for (auto& stage : stages)
     {
         if (vsg::compare_pointer(stage->module->hints, scs) == 0)
@@ -457,6 +478,17 @@ void ShaderSet::write(Output& output) const
     }
 }
 
+// declare the lightClusters binding and the optional define that enables the shaders' clustered lighting path, it's only used once enabled with enableLightClusters(..)
+static ref_ptr<ShaderSet> addLightClustersBinding(ref_ptr<ShaderSet> shaderSet)
+{
+    if (shaderSet && !shaderSet->getDescriptorBinding("lightClusters"))
+    {
+        shaderSet->addDescriptorBinding("lightClusters", "VSG_LIGHT_CLUSTERS", 0, 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, uintArray::create(LightClusters::headerSize));
+        shaderSet->optionalDefines.insert("VSG_LIGHT_CLUSTERS");
+    }
+    return shaderSet;
+}
+
 ref_ptr<ShaderSet> vsg::createFlatShadedShaderSet(ref_ptr<const Options> options)
 {
     if (options)
@@ -475,7 +507,7 @@ ref_ptr<ShaderSet> vsg::createPhongShaderSet(ref_ptr<const Options> options)
         if (auto itr = options->shaderSets.find("phong"); itr != options->shaderSets.end()) return itr->second;
     }
 
-    return phong_ShaderSet();
+    return addLightClustersBinding(phong_ShaderSet());
 }
 
 ref_ptr<ShaderSet> vsg::createPhysicsBasedRenderingShaderSet(ref_ptr<const Options> options)
@@ -489,6 +521,20 @@ ref_ptr<ShaderSet> vsg::createPhysicsBasedRenderingShaderSet(ref_ptr<const Optio
     return pbr_ShaderSet();
 }
 
+bool vsg::enableLightClusters(ShaderSet& shaderSet)
+{
+    if (!shaderSet.getDescriptorBinding("lightClusters")) return false;
+
+    if (!shaderSet.defaultShaderHints) shaderSet.defaultShaderHints = ShaderCompileSettings::create();
+    shaderSet.defaultShaderHints->defines.insert("VSG_LIGHT_CLUSTERS");
+    return true;
+}
+
+bool vsg::lightClustersEnabled(const ShaderSet& shaderSet)
+{
+    return shaderSet.defaultShaderHints && shaderSet.defaultShaderHints->defines.count("VSG_LIGHT_CLUSTERS") != 0 && shaderSet.getDescriptorBinding("lightClusters");
+}
+
 std::pair<uint32_t, uint32_t> ShaderSet::descriptorSetRange() const
 {
     if (descriptorBindings.empty()) return {0, 0};
@@ -1,10 +1,105 @@
 
 #include <vsg/io/Logger.h>
 #include <vsg/io/Options.h>
+#include <vsg/io/Output.h>
 #include <vsg/utils/SharedObjects.h>
 
+#include <cstring>
+#include <functional>
+
 using namespace vsg;
 
+namespace
+{
+    uint64_t mixHash(uint64_t hash, uint64_t value)
+    {
+        hash = (hash ^ value) * 0x9e3779b97f4a7c15ull;
+        return hash ^ (hash >> 32);
+    }
+
+    size_t shardIndex(uint64_t key)
+    {
+        return static_cast<size_t>(mixHash(key, 0) >> 32) % SharedObjects::numShards;
+    }
+
+    /// Output subclass that hashes the values written to it rather than writing them to a stream, child objects are hashed via the hashObject callback.
+    class HashOutput : public Output
+    {
+    public:
+        explicit HashOutput(const std::function<uint64_t(const Object*)>& in_hashObject) :
+            hashObject(in_hashObject) {}
+
+        const std::function<uint64_t(const Object*)>& hashObject;
+        uint64_t value = 0xcbf29ce484222325ull;
+
+        void mix(uint64_t v) { value = mixHash(value, v); }
+
+        void mixBytes(const void* data, size_t size)
+        {
+            mix(size);
+
+            auto ptr = static_cast<const uint8_t*>(data);
+            for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), ptr += sizeof(uint64_t))
+            {
+                uint64_t word;
+                std::memcpy(&word, ptr, sizeof(uint64_t));
+                mix(word);
+            }
+
+            if (size > 0)
+            {
+                uint64_t word = 0;
+                std::memcpy(&word, ptr, size);
+                mix(word);
+            }
+        }
+
+        void writePropertyName(const char*) override {}
+        void writeEndOfLine() override {}
+
+        void write(size_t num, const int8_t* v) override { mixBytes(v, num * sizeof(*v)); }
+        void write(size_t num, const uint8_t* v) override { mixBytes(v, num * sizeof(*v)); }
+        void write(size_t num, const int16_t* v) override { mixBytes(v, num * sizeof(*v)); }
+        void write(size_t num, const uint16_t* v) override { mixBytes(v, num * sizeof(*v)); }
+        void write(size_t num, const int32_t* v) override { mixBytes(v, num * sizeof(*v)); }
+        void write(size_t num, const uint32_t* v) override { mixBytes(v, num * sizeof(*v)); }
+        void write(size_t num, const int64_t* v) override { mixBytes(v, num * sizeof(*v)); }
+        void write(size_t num, const uint64_t* v) override { mixBytes(v, num * sizeof(*v)); }
+        void write(size_t num, const float* v) override { mixBytes(v, num * sizeof(*v)); }
+        void write(size_t num, const double* v) override { mixBytes(v, num * sizeof(*v)); }
+
+        void write(size_t num, const long double* v) override
+        {
+            // long double can contain uninitialized padding bytes so hash the double equivalent
+            for (size_t i = 0; i < num; ++i)
+            {
+                double d = static_cast<double>(v[i]);
+                mixBytes(&d, sizeof(d));
+            }
+        }
+
+        void write(size_t num, const std::string* v) override
+        {
+            for (size_t i = 0; i < num; ++i) mixBytes(v[i].data(), v[i].size());
+        }
+
+        void write(size_t num, const std::wstring* v) override
+        {
+            for (size_t i = 0; i < num; ++i) mixBytes(v[i].data(), v[i].size() * sizeof(wchar_t));
+        }
+
+        void write(size_t num, const Path* v) override
+        {
+            for (size_t i = 0; i < num; ++i) mixBytes(v[i].native().data(), v[i].native().size() * sizeof(Path::value_type));
+        }
+
+        void write(const Object* object) override
+        {
+            mix(object ? hashObject(object) : 0);
+        }
+    };
+} // namespace
+
 SharedObjects::SharedObjects() :
     suitableForSharing(SuitableForSharing::create())
 {
@@ -23,40 +118,26 @@ bool SharedObjects::contains(const Path& filename, ref_ptr<const Options> option
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
 
-    auto loadedObject_id = std::type_index(typeid(LoadedObject));
-    auto itr = _sharedObjects.find(loadedObject_id);
-    if (itr == _sharedObjects.end()) return false;
-
-    auto& loadedObjects = itr->second;
     auto key = LoadedObject::create(filename, options);
-    return loadedObjects.find(key) != loadedObjects.end();
+    return _loadedObjects.find(key) != _loadedObjects.end();
 }
 
 void SharedObjects::add(ref_ptr<Object> object, const Path& filename, ref_ptr<const Options> options)
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
 
-    auto loadedObject_id = std::type_index(typeid(LoadedObject));
-    auto& loadedObjects = _sharedObjects[loadedObject_id];
-
     auto key = LoadedObject::create(filename, options, object);
-    loadedObjects.insert(key);
+    _loadedObjects.insert(key);
 }
 
 bool SharedObjects::remove(const Path& filename, ref_ptr<const Options> options)
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
 
-    auto loadedObject_id = std::type_index(typeid(LoadedObject));
-    auto itr = _sharedObjects.find(loadedObject_id);
-    if (itr == _sharedObjects.end()) return false;
-
-    auto& loadedObjects = itr->second;
-
     auto key = LoadedObject::create(filename, options);
-    if (auto lo_itr = loadedObjects.find(key); lo_itr != loadedObjects.end())
+    if (auto lo_itr = _loadedObjects.find(key); lo_itr != _loadedObjects.end())
     {
-        loadedObjects.erase(lo_itr);
+        _loadedObjects.erase(lo_itr);
         return true;
     }
     else
@@ -69,20 +150,114 @@ void SharedObjects::clear()
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
     _defaults.clear();
-    _sharedObjects.clear();
+    _loadedObjects.clear();
+
+    for (auto& shard : _shards)
+    {
+        std::scoped_lock<std::mutex> shard_lock(shard.mutex);
+        shard.objects.clear();
+    }
+
+    for (auto& hashShard : _hashShards)
+    {
+        std::scoped_lock<std::mutex> shard_lock(hashShard.mutex);
+        hashShard.hashes.clear();
+    }
+}
+
+uint64_t SharedObjects::hash(const Object* object) const
+{
+    std::set<const Object*> active;
+    return _hash(object, active);
+}
+
+uint64_t SharedObjects::_hash(const Object* object, std::set<const Object*>& active) const
+{
+    if (!object) return 0;
+
+    auto& hashShard = _hashShards[shardIndex(reinterpret_cast<uintptr_t>(object))];
+    {
+        std::scoped_lock<std::mutex> lock(hashShard.mutex);
+        if (auto itr = hashShard.hashes.find(object); itr != hashShard.hashes.end()) return itr->second;
+    }
+
+    // guard against cycles of objects referencing each other
+    if (!active.insert(object).second) return 1;
+
+    std::function<uint64_t(const Object*)> hashObject = [&](const Object* child) { return _hash(child, active); };
+
+    HashOutput output(hashObject);
+    output.mixBytes(object->className(), std::strlen(object->className()));
+    object->write(output);
+
+    active.erase(object);
+
+    return output.value;
+}
+
+void SharedObjects::_pruneHash(const Object* object)
+{
+    auto& hashShard = _hashShards[shardIndex(reinterpret_cast<uintptr_t>(object))];
+
+    std::scoped_lock<std::mutex> lock(hashShard.mutex);
+    hashShard.hashes.erase(object);
+}
+
+bool SharedObjects::_suitable(const Object* object)
+{
+    if (!suitableForSharing) return true;
+
+    // the SuitableForSharing visitor records its result in a member so can't be used from multiple threads, use a local one for the default case
+    if (typeid(*suitableForSharing) == typeid(SuitableForSharing))
+    {
+        SuitableForSharing local;
+        return local.suitable(object);
+    }
+
+    std::scoped_lock<std::mutex> lock(_suitableForSharingMutex);
+    return suitableForSharing->suitable(object);
+}
+
+ref_ptr<Object> SharedObjects::_share(const std::type_index& type, ref_ptr<Object> object, bool insert)
+{
+    // compute the hash before taking the shard lock so concurrent share(..) calls don't wait on each other's hashing
+    uint64_t contentHash = hash(object.get());
+    uint64_t key = mixHash(contentHash, type.hash_code());
+
+    auto& shard = _shards[shardIndex(key)];
+    {
+        std::scoped_lock<std::mutex> lock(shard.mutex);
+
+        // only compare objects with the same hash
+        auto [begin, end] = shard.objects.equal_range(key);
+        for (auto itr = begin; itr != end; ++itr)
+        {
+            auto& shared = itr->second;
+            if (shared.type == type && (shared.object == object || shared.object->compare(*object) == 0)) return shared.object;
+        }
+
+        if (!insert) return {};
+
+        shard.objects.emplace(key, SharedObject{type, object});
+    }
+
+    auto& hashShard = _hashShards[shardIndex(reinterpret_cast<uintptr_t>(object.get()))];
+    {
+        std::scoped_lock<std::mutex> lock(hashShard.mutex);
+        hashShard.hashes[object.get()] = contentHash;
+    }
+
+    return object;
 }
 
 void SharedObjects::prune()
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
 
-    auto loadedObject_id = std::type_index(typeid(LoadedObject));
-
     // record observer pointers for each LoadedObject object so we can clear them to prevent local references keeping them from being pruned
-    auto& loadedObjects = _sharedObjects[loadedObject_id];
-    std::vector<observer_ptr<Object>> observedLoadedObjects(loadedObjects.size());
+    std::vector<observer_ptr<Object>> observedLoadedObjects(_loadedObjects.size());
     auto observedLoadedObject_itr = observedLoadedObjects.begin();
-    for (auto& object : loadedObjects)
+    for (auto& object : _loadedObjects)
     {
         auto& loadedObject = static_cast<LoadedObject&>(*object);
         *(observedLoadedObject_itr++) = loadedObject.object;
@@ -103,38 +278,36 @@ void SharedObjects::prune()
     do
     {
         prunedObjects = false;
-        for (auto itr = _sharedObjects.begin(); itr != _sharedObjects.end(); ++itr)
+        for (auto& shard : _shards)
         {
-            auto id = itr->first;
-            if (id != loadedObject_id)
+            std::scoped_lock<std::mutex> shard_lock(shard.mutex);
+            for (auto object_itr = shard.objects.begin(); object_itr != shard.objects.end();)
             {
-                auto& objects = itr->second;
-                for (auto object_itr = itr->second.begin(); object_itr != itr->second.end();)
+                auto& object = object_itr->second.object;
+                if (object->referenceCount() == 1)
+                {
+                    // vsg::info("pruning ", object);
+                    _pruneHash(object.get());
+                    object_itr = shard.objects.erase(object_itr);
+                    prunedObjects = true;
+                }
+                else
                 {
-                    if ((*object_itr)->referenceCount() == 1)
-                    {
-                        // vsg::info("pruning ", *object_itr);
-                        object_itr = objects.erase(object_itr);
-                        prunedObjects = true;
-                    }
-                    else
-                    {
-                        ++object_itr;
-                    }
+                    ++object_itr;
                 }
             }
         }
     } while (prunedObjects);
 
     observedLoadedObject_itr = observedLoadedObjects.begin();
-    for (auto object_itr = loadedObjects.begin(); object_itr != loadedObjects.end();)
+    for (auto object_itr = _loadedObjects.begin(); object_itr != _loadedObjects.end();)
     {
         auto& loadedObject = static_cast<LoadedObject&>(*(*object_itr));
         loadedObject.object = *(observedLoadedObject_itr++);
         if (!loadedObject.object)
         {
             // vsg::info("pruning loadedObject ", *object_itr);
-            object_itr = loadedObjects.erase(object_itr);
+            object_itr = _loadedObjects.erase(object_itr);
         }
         else
         {
@@ -170,22 +343,37 @@ void SharedObjects::report(vsg::LogOutput& output)
     output.out();
     output("}");
 
-    output("SharedObjects::_sharedObjects ", SharedObjects::_sharedObjects.size(), " {");
+    output("SharedObjects::_loadedObjects ", _loadedObjects.size(), " {");
+    output.in();
+    for (auto& object : _loadedObjects)
+    {
+        auto loadedObject = object.cast<LoadedObject>();
+        output("loadedObject = ", loadedObject, " ", object->referenceCount(), " ", loadedObject->filename);
+    }
+    output.out();
+    output("}");
+
+    // collate the objects from all the shards by the type they are shared as
+    std::map<std::type_index, std::vector<ref_ptr<Object>>> sharedObjects;
+    for (auto& shard : _shards)
+    {
+        std::scoped_lock<std::mutex> shard_lock(shard.mutex);
+        for (auto& [key, shared] : shard.objects)
+        {
+            sharedObjects[shared.type].push_back(shared.object);
+        }
+    }
+
+    output("SharedObjects::_shards ", sharedObjects.size(), " {");
     output.in();
-    for (auto& [type, objects] : _sharedObjects)
+    for (auto& [type, objects] : sharedObjects)
     {
         output(type.name(), ", objects = ", objects.size(), " {");
         output.in();
         for (auto& object : objects)
         {
-            if (auto loadedObject = object.cast<LoadedObject>())
-            {
-                output("loadedObject = ", loadedObject, " ", object->referenceCount(), " ", loadedObject->filename);
-            }
-            else
-            {
-                output("object = ", object, " ", object->referenceCount());
-            }
+            // discount the local reference held by sharedObjects
+            output("object = ", object, " ", object->referenceCount() - 1);
         }
         output.out();
         output("}");
@@ -0,0 +1,423 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/utils/TriangleBVH.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define VSG_TRIANGLEBVH_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define VSG_TRIANGLEBVH_NEON 1
+#endif
+
+using namespace vsg;
+
+namespace
+{
+    struct BuildTriangle
+    {
+        vec3 min;
+        vec3 max;
+        vec3 centroid;
+        uivec3 indices;
+    };
+
+    struct Builder
+    {
+        std::vector<BuildTriangle>& buildTriangles;
+        std::vector<TriangleBVH::Node>& nodes;
+        float epsilon = 0.0f;
+
+        // partially sort the range about the median centroid along the axis of greatest extent, returning the split position
+        size_t split(size_t begin, size_t end)
+        {
+            size_t mid = begin + (end - begin) / 2;
+            if ((end - begin) < 2) return mid;
+
+            vec3 cmin(FLT_MAX, FLT_MAX, FLT_MAX);
+            vec3 cmax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+            for (size_t i = begin; i < end; ++i)
+            {
+                const auto& c = buildTriangles[i].centroid;
+                cmin.set(std::min(cmin.x, c.x), std::min(cmin.y, c.y), std::min(cmin.z, c.z));
+                cmax.set(std::max(cmax.x, c.x), std::max(cmax.y, c.y), std::max(cmax.z, c.z));
+            }
+
+            vec3 extents = cmax - cmin;
+            size_t axis = 0;
+            if (extents.y > extents[axis]) axis = 1;
+            if (extents.z > extents[axis]) axis = 2;
+
+            auto first = buildTriangles.begin();
+            std::nth_element(first + begin, first + mid, first + end, [axis](const BuildTriangle& lhs, const BuildTriangle& rhs) { return lhs.centroid[axis] < rhs.centroid[axis]; });
+            return mid;
+        }
+
+        uint32_t build(size_t begin, size_t end)
+        {
+            uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+
+            size_t mid = split(begin, end);
+            size_t ranges[5] = {begin, split(begin, mid), mid, split(mid, end), end};
+
+            for (size_t c = 0; c < 4; ++c)
+            {
+                size_t childBegin = ranges[c];
+                size_t childEnd = ranges[c + 1];
+
+                // empty children are assigned inverted bounds so they are never intersected
+                vec3 bmin(FLT_MAX, FLT_MAX, FLT_MAX);
+                vec3 bmax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+                for (size_t i = childBegin; i < childEnd; ++i)
+                {
+                    const auto& t = buildTriangles[i];
+                    bmin.set(std::min(bmin.x, t.min.x), std::min(bmin.y, t.min.y), std::min(bmin.z, t.min.z));
+                    bmax.set(std::max(bmax.x, t.max.x), std::max(bmax.y, t.max.y), std::max(bmax.z, t.max.z));
+                }
+
+                if (childBegin != childEnd)
+                {
+                    // pad the bounds so that float rounding in the node tests can't reject triangles that the double precision triangle tests would accept
+                    bmin -= vec3(epsilon, epsilon, epsilon);
+                    bmax += vec3(epsilon, epsilon, epsilon);
+                }
+
+                uint32_t count = static_cast<uint32_t>(childEnd - childBegin);
+                uint32_t child = (count > 0) ? static_cast<uint32_t>(childBegin) : 0;
+                if (count > TriangleBVH::maxLeafSize)
+                {
+                    child = build(childBegin, childEnd);
+                    count = 0;
+                }
+
+                auto& node = nodes[nodeIndex];
+                node.minX[c] = bmin.x;
+                node.minY[c] = bmin.y;
+                node.minZ[c] = bmin.z;
+                node.maxX[c] = bmax.x;
+                node.maxY[c] = bmax.y;
+                node.maxZ[c] = bmax.z;
+                node.child[c] = child;
+                node.count[c] = count;
+            }
+
+            return nodeIndex;
+        }
+    };
+
+    template<typename T>
+    void collectTriangles(const vec3Array& vertices, const T* indices, uint32_t first, uint32_t count, std::vector<BuildTriangle>& buildTriangles)
+    {
+        uint32_t numVertices = static_cast<uint32_t>(vertices.size());
+        uint32_t available = indices ? static_cast<uint32_t>(indices->size()) : numVertices;
+        if (first >= available) return;
+
+        uint32_t end = first + (std::min(count, available - first) / 3) * 3;
+
+        buildTriangles.reserve((end - first) / 3);
+        for (uint32_t i = first; i < end; i += 3)
+        {
+            uivec3 t = indices ? uivec3(indices->at(i), indices->at(i + 1), indices->at(i + 2)) : uivec3(i, i + 1, i + 2);
+            if (t.x >= numVertices || t.y >= numVertices || t.z >= numVertices) continue;
+
+            const vec3& v0 = vertices.at(t.x);
+            const vec3& v1 = vertices.at(t.y);
+            const vec3& v2 = vertices.at(t.z);
+
+            BuildTriangle bt;
+            bt.min.set(std::min({v0.x, v1.x, v2.x}), std::min({v0.y, v1.y, v2.y}), std::min({v0.z, v1.z, v2.z}));
+            bt.max.set(std::max({v0.x, v1.x, v2.x}), std::max({v0.y, v1.y, v2.y}), std::max({v0.z, v1.z, v2.z}));
+            bt.centroid = (bt.min + bt.max) * 0.5f;
+            bt.indices = t;
+            buildTriangles.push_back(bt);
+        }
+    }
+
+    // return a bit mask of the children of the node whose bounds intersect the segment origin + direction * t, t in [0, 1].
+    // near and far select, per axis, which of the min/max planes are entered first based on the direction's sign.
+    inline uint32_t intersectSegment(const TriangleBVH::Node& node, const float origin[3], const float inverse[3], const bool negative[3])
+    {
+        const float* nearX = negative[0] ? node.maxX : node.minX;
+        const float* farX = negative[0] ? node.minX : node.maxX;
+        const float* nearY = negative[1] ? node.maxY : node.minY;
+        const float* farY = negative[1] ? node.minY : node.maxY;
+        const float* nearZ = negative[2] ? node.maxZ : node.minZ;
+        const float* farZ = negative[2] ? node.minZ : node.maxZ;
+
+#if defined(VSG_TRIANGLEBVH_SSE2)
+        __m128 ox = _mm_set1_ps(origin[0]), oy = _mm_set1_ps(origin[1]), oz = _mm_set1_ps(origin[2]);
+        __m128 ix = _mm_set1_ps(inverse[0]), iy = _mm_set1_ps(inverse[1]), iz = _mm_set1_ps(inverse[2]);
+
+        __m128 tNear = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearX), ox), ix), _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearY), oy), iy));
+        tNear = _mm_max_ps(tNear, _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearZ), oz), iz), _mm_setzero_ps()));
+
+        __m128 tFar = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farX), ox), ix), _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farY), oy), iy));
+        tFar = _mm_min_ps(tFar, _mm_min_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farZ), oz), iz), _mm_set1_ps(1.0f)));
+
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar)));
+#elif defined(VSG_TRIANGLEBVH_NEON)
+        float32x4_t ox = vdupq_n_f32(origin[0]), oy = vdupq_n_f32(origin[1]), oz = vdupq_n_f32(origin[2]);
+        float32x4_t ix = vdupq_n_f32(inverse[0]), iy = vdupq_n_f32(inverse[1]), iz = vdupq_n_f32(inverse[2]);
+
+        float32x4_t tNear = vmaxq_f32(vmulq_f32(vsubq_f32(vld1q_f32(nearX), ox), ix), vmulq_f32(vsubq_f32(vld1q_f32(nearY), oy), iy));
+        tNear = vmaxq_f32(tNear, vmaxq_f32(vmulq_f32(vsubq_f32(vld1q_f32(nearZ), oz), iz), vdupq_n_f32(0.0f)));
+
+        float32x4_t tFar = vminq_f32(vmulq_f32(vsubq_f32(vld1q_f32(farX), ox), ix), vmulq_f32(vsubq_f32(vld1q_f32(farY), oy), iy));
+        tFar = vminq_f32(tFar, vminq_f32(vmulq_f32(vsubq_f32(vld1q_f32(farZ), oz), iz), vdupq_n_f32(1.0f)));
+
+        uint32x4_t hit = vcleq_f32(tNear, tFar);
+        return (vgetq_lane_u32(hit, 0) & 1) | (vgetq_lane_u32(hit, 1) & 2) | (vgetq_lane_u32(hit, 2) & 4) | (vgetq_lane_u32(hit, 3) & 8);
+#else
+        uint32_t mask = 0;
+        for (int c = 0; c < 4; ++c)
+        {
+            float tNear = std::max(std::max((nearX[c] - origin[0]) * inverse[0], (nearY[c] - origin[1]) * inverse[1]), std::max((nearZ[c] - origin[2]) * inverse[2], 0.0f));
+            float tFar = std::min(std::min((farX[c] - origin[0]) * inverse[0], (farY[c] - origin[1]) * inverse[1]), std::min((farZ[c] - origin[2]) * inverse[2], 1.0f));
+            if (tNear <= tFar) mask |= (1u << c);
+        }
+        return mask;
+#endif
+    }
+
+    struct Plane
+    {
+        float n[3];
+        float p;
+    };
+
+    // return a bit mask of the children of the node whose bounds are inside or intersect all the planes.
+    // for each plane only the box corner furthest along the plane normal needs to be tested.
+    inline uint32_t intersectPolytope(const TriangleBVH::Node& node, const Plane* planes, size_t numPlanes)
+    {
+        uint32_t mask = 0xf;
+        for (const Plane* plane = planes; plane != planes + numPlanes; ++plane)
+        {
+            const float* x = plane->n[0] >= 0.0f ? node.maxX : node.minX;
+            const float* y = plane->n[1] >= 0.0f ? node.maxY : node.minY;
+            const float* z = plane->n[2] >= 0.0f ? node.maxZ : node.minZ;
+
+#if defined(VSG_TRIANGLEBVH_SSE2)
+            __m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane->n[0]), _mm_loadu_ps(x)), _mm_mul_ps(_mm_set1_ps(plane->n[1]), _mm_loadu_ps(y)));
+            d = _mm_add_ps(d, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane->n[2]), _mm_loadu_ps(z)), _mm_set1_ps(plane->p)));
+            mask &= static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(d, _mm_setzero_ps())));
+#elif defined(VSG_TRIANGLEBVH_NEON)
+            float32x4_t d = vaddq_f32(vmulq_n_f32(vld1q_f32(x), plane->n[0]), vmulq_n_f32(vld1q_f32(y), plane->n[1]));
+            d = vaddq_f32(d, vaddq_f32(vmulq_n_f32(vld1q_f32(z), plane->n[2]), vdupq_n_f32(plane->p)));
+            uint32x4_t inside = vcgeq_f32(d, vdupq_n_f32(0.0f));
+            mask &= (vgetq_lane_u32(inside, 0) & 1) | (vgetq_lane_u32(inside, 1) & 2) | (vgetq_lane_u32(inside, 2) & 4) | (vgetq_lane_u32(inside, 3) & 8);
+#else
+            for (int c = 0; c < 4; ++c)
+            {
+                if ((plane->n[0] * x[c] + plane->n[1] * y[c]) + (plane->n[2] * z[c] + plane->p) < 0.0f) mask &= ~(1u << c);
+            }
+#endif
+            if (mask == 0) break;
+        }
+        return mask;
+    }
+
+    // maximum traversal depth is bounded by the median splits, 3 entries per level is ample for any 32bit triangle count
+    constexpr size_t maxStackSize = 128;
+
+    template<class NodeTest>
+    void traverseNodes(const std::vector<TriangleBVH::Node>& nodes, std::vector<uint32_t>& candidates, NodeTest nodeTest)
+    {
+        if (nodes.empty()) return;
+
+        uint32_t stack[maxStackSize];
+        size_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const auto& node = nodes[stack[--stackSize]];
+            uint32_t mask = nodeTest(node);
+            for (uint32_t c = 0; mask != 0; ++c, mask >>= 1)
+            {
+                if ((mask & 1) == 0) continue;
+
+                if (node.count[c] == 0)
+                {
+                    // the root node is never a child so child 0 marks an empty slot
+                    if (node.child[c] != 0 && stackSize < maxStackSize) stack[stackSize++] = node.child[c];
+                }
+                else
+                {
+                    for (uint32_t i = node.child[c]; i < node.child[c] + node.count[c]; ++i) candidates.push_back(i);
+                }
+            }
+        }
+    }
+} // namespace
+
+TriangleBVH::TriangleBVH()
+{
+}
+
+void TriangleBVH::build(ref_ptr<const vec3Array> in_vertices, ref_ptr<const Data> in_indices, uint32_t first, uint32_t count)
+{
+    nodes.clear();
+    triangles.clear();
+
+    _vertices = in_vertices;
+    _indices = in_indices;
+    _first = first;
+    _count = count;
+    if (_vertices) _vertices->getModifiedCount(_verticesModifiedCount);
+    if (_indices) _indices->getModifiedCount(_indicesModifiedCount);
+
+    if (!_vertices) return;
+
+    std::vector<BuildTriangle> buildTriangles;
+    if (!_indices)
+        collectTriangles<ushortArray>(*_vertices, nullptr, first, count, buildTriangles);
+    else if (auto ushort_indices = _indices->cast<ushortArray>())
+        collectTriangles(*_vertices, ushort_indices, first, count, buildTriangles);
+    else if (auto uint_indices = _indices->cast<uintArray>())
+        collectTriangles(*_vertices, uint_indices, first, count, buildTriangles);
+    else if (auto ubyte_indices = _indices->cast<ubyteArray>())
+        collectTriangles(*_vertices, ubyte_indices, first, count, buildTriangles);
+
+    if (buildTriangles.empty()) return;
+
+    float maxCoord = 0.0f;
+    for (const auto& bt : buildTriangles)
+    {
+        maxCoord = std::max({maxCoord, std::fabs(bt.min.x), std::fabs(bt.min.y), std::fabs(bt.min.z), std::fabs(bt.max.x), std::fabs(bt.max.y), std::fabs(bt.max.z)});
+    }
+
+    nodes.reserve((buildTriangles.size() * 2) / maxLeafSize + 1);
+
+    Builder builder{buildTriangles, nodes, std::max(maxCoord * 1e-5f, FLT_MIN)};
+    builder.build(0, buildTriangles.size());
+
+    triangles.reserve(buildTriangles.size());
+    for (const auto& bt : buildTriangles) triangles.push_back(bt.indices);
+}
+
+bool TriangleBVH::valid(const vec3Array* in_vertices, const Data* in_indices, uint32_t first, uint32_t count) const
+{
+    if (!_vertices || _vertices.get() != in_vertices || _indices.get() != in_indices || _first != first || _count != count) return false;
+    if (_vertices->differentModifiedCount(_verticesModifiedCount)) return false;
+    if (_indices && _indices->differentModifiedCount(_indicesModifiedCount)) return false;
+    return true;
+}
+
+void TriangleBVH::intersect(const dvec3& start, const dvec3& end, std::vector<uint32_t>& candidates) const
+{
+    dvec3 direction = end - start;
+
+    float origin[3] = {static_cast<float>(start.x), static_cast<float>(start.y), static_cast<float>(start.z)};
+    float inverse[3];
+    bool negative[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        // use a large finite value for axis aligned segments so that 0 * inverse can't generate NaN
+        inverse[i] = direction[i] != 0.0 ? static_cast<float>(1.0 / direction[i]) : 1e30f;
+        negative[i] = inverse[i] < 0.0f;
+    }
+
+    traverseNodes(nodes, candidates, [&](const Node& node) { return intersectSegment(node, origin, inverse, negative); });
+}
+
+void TriangleBVH::intersect(const std::vector<dplane>& polytope, std::vector<uint32_t>& candidates) const
+{
+    std::vector<Plane> planes;
+    planes.reserve(polytope.size());
+    for (const auto& pl : polytope)
+    {
+        planes.push_back(Plane{{static_cast<float>(pl.n.x), static_cast<float>(pl.n.y), static_cast<float>(pl.n.z)}, static_cast<float>(pl.p)});
+    }
+
+    traverseNodes(nodes, candidates, [&](const Node& node) { return intersectPolytope(node, planes.data(), planes.size()); });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// TriangleBVHCache
+//
+TriangleBVHCache::TriangleBVHCache()
+{
+}
+
+TriangleBVHCache::~TriangleBVHCache()
+{
+}
+
+ref_ptr<const TriangleBVH> TriangleBVHCache::getOrCreate(const Object* draw, ref_ptr<const vec3Array> vertices, ref_ptr<const Data> indices, uint32_t first, uint32_t count)
+{
+    Key key(draw, first, count);
+
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        if (auto itr = _triangleBVHs.find(key); itr != _triangleBVHs.end() && itr->second->valid(vertices.get(), indices.get(), first, count)) return itr->second;
+    }
+
+    // build outside the lock so that Intersectors sharing the cache aren't blocked while other draws are built
+    auto bvh = TriangleBVH::create();
+    bvh->build(vertices, indices, first, count);
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _triangleBVHs[key] = bvh;
+
+    if (_triangleBVHs.size() >= std::max(minimumPruneSize, _pruneSize))
+    {
+        _prune();
+        _pruneSize = _triangleBVHs.size() * 2;
+    }
+
+    return bvh;
+}
+
+size_t TriangleBVHCache::_prune()
+{
+    size_t count = 0;
+    for (auto itr = _triangleBVHs.begin(); itr != _triangleBVHs.end();)
+    {
+        auto vertices = itr->second->vertices();
+        if (!vertices || vertices->referenceCount() == 1)
+        {
+            itr = _triangleBVHs.erase(itr);
+            ++count;
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+    return count;
+}
+
+size_t TriangleBVHCache::prune()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _prune();
+}
+
+void TriangleBVHCache::clear()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _triangleBVHs.clear();
+    _pruneSize = 0;
+}
+
+size_t TriangleBVHCache::size() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _triangleBVHs.size();
+}
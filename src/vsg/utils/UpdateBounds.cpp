@@ -0,0 +1,396 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/Commands.h>
+#include <vsg/nodes/CullGroup.h>
+#include <vsg/nodes/CullNode.h>
+#include <vsg/nodes/InstanceNode.h>
+#include <vsg/nodes/LOD.h>
+#include <vsg/nodes/PagedLOD.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/Transform.h>
+#include <vsg/text/Text.h>
+#include <vsg/text/TextGroup.h>
+#include <vsg/utils/UpdateBounds.h>
+
+#include <algorithm>
+
+using namespace vsg;
+
+static dbox transformBounds(const dmat4& matrix, const dbox& bb)
+{
+    dbox result;
+    if (!bb.valid()) return result;
+
+    result.add(matrix * bb.min);
+    result.add(matrix * dvec3(bb.max.x, bb.min.y, bb.min.z));
+    result.add(matrix * dvec3(bb.max.x, bb.max.y, bb.min.z));
+    result.add(matrix * dvec3(bb.min.x, bb.max.y, bb.min.z));
+    result.add(matrix * dvec3(bb.min.x, bb.min.y, bb.max.z));
+    result.add(matrix * dvec3(bb.max.x, bb.min.y, bb.max.z));
+    result.add(matrix * bb.max);
+    result.add(matrix * dvec3(bb.min.x, bb.max.y, bb.max.z));
+    return result;
+}
+
+UpdateBounds::UpdateBounds(ref_ptr<ArrayState> intialArrayState) :
+    _computeBounds(ComputeBounds::create(intialArrayState))
+{
+}
+
+void UpdateBounds::dirty(const Node* node, bool subgraph)
+{
+    if (subgraph) _markSubgraphDirty(node);
+    _markDirty(node);
+}
+
+bool UpdateBounds::getBounds(const Node* node, dbox& bound) const
+{
+    auto itr = _entries.find(node);
+    if (itr == _entries.end() || itr->second.dirty) return false;
+
+    bound = itr->second.bounds;
+    return true;
+}
+
+void UpdateBounds::clear()
+{
+    _entries.clear();
+    _dataEntries.clear();
+    _transforms.clear();
+}
+
+template<class N, typename F>
+void UpdateBounds::_apply(N& node, F compute, bool leaf)
+{
+    bool root = _parentStack.empty();
+    if (root)
+    {
+        _checkForModifications();
+        _bindingsStack.assign(1, ArrayBindings{_computeBounds->arrayStateStack.back(), {}, {}});
+    }
+
+    auto& entry = _entries[&node];
+    if (!entry.node) entry.node = &node;
+
+    if (!root)
+    {
+        auto& parentEntry = *_parentStack.back();
+        parentEntry.children.push_back(&node);
+        if (std::find(entry.parents.begin(), entry.parents.end(), parentEntry.node.get()) == entry.parents.end()) entry.parents.push_back(parentEntry.node);
+    }
+
+    // leaves also have to be recomputed when the arrays bound by their preceding siblings have changed
+    bool recompute = entry.dirty || (leaf && !_sameBindings(entry.inputBindings, _bindingsStack.back()));
+    if (recompute)
+    {
+        compute(entry);
+        entry.dirty = false;
+    }
+    else if (leaf)
+    {
+        _bindingsStack.back() = entry.outputBindings;
+    }
+
+    if (root)
+        bounds = entry.bounds;
+    else
+        _boundsStack.back().add(entry.bounds);
+}
+
+void UpdateBounds::apply(Node& node)
+{
+    _apply(node, [&](Entry& entry) { entry.bounds = _traverse(node, entry); });
+}
+
+void UpdateBounds::apply(Compilable& compilable)
+{
+    _apply(compilable, [&](Entry& entry) { _computeLeafBounds(compilable, entry); }, true);
+}
+
+void UpdateBounds::apply(Commands& commands)
+{
+    _apply(commands, [&](Entry& entry) { _computeLeafBounds(commands, entry); }, true);
+}
+
+void UpdateBounds::apply(Text& text)
+{
+    _apply(text, [&](Entry& entry) { _computeLeafBounds(text, entry); }, true);
+}
+
+void UpdateBounds::apply(TextGroup& textGroup)
+{
+    _apply(textGroup, [&](Entry& entry) { _computeLeafBounds(textGroup, entry); }, true);
+}
+
+void UpdateBounds::apply(StateGroup& stateGroup)
+{
+    _apply(stateGroup, [&](Entry& entry) {
+        auto& arrayStateStack = _computeBounds->arrayStateStack;
+        auto arrayState = stateGroup.prototypeArrayState ? stateGroup.prototypeArrayState->cloneArrayState(arrayStateStack.back()) : arrayStateStack.back()->cloneArrayState();
+
+        for (auto& statecommand : stateGroup.stateCommands)
+        {
+            statecommand->accept(*arrayState);
+        }
+
+        arrayStateStack.emplace_back(arrayState);
+
+        entry.bounds = _traverse(stateGroup, entry);
+
+        arrayStateStack.pop_back();
+    });
+}
+
+void UpdateBounds::apply(Transform& transform)
+{
+    _apply(transform, [&](Entry& entry) {
+        _transforms.insert(&transform);
+        entry.matrix = transform.transform(dmat4{});
+        entry.bounds = transformBounds(entry.matrix, _traverse(transform, entry));
+    });
+}
+
+void UpdateBounds::apply(CullGroup& cullGroup)
+{
+    _apply(cullGroup, [&](Entry& entry) {
+        entry.bounds = _traverse(cullGroup, entry);
+        _updateBound(cullGroup.bound, entry.bounds);
+    });
+}
+
+void UpdateBounds::apply(CullNode& cullNode)
+{
+    _apply(cullNode, [&](Entry& entry) {
+        entry.bounds = _traverse(cullNode, entry);
+        _updateBound(cullNode.bound, entry.bounds);
+    });
+}
+
+void UpdateBounds::apply(LOD& lod)
+{
+    _apply(lod, [&](Entry& entry) {
+        entry.bounds = _traverse(lod, entry);
+        _updateBound(lod.bound, entry.bounds);
+    });
+}
+
+void UpdateBounds::apply(PagedLOD& plod)
+{
+    // the children of a PagedLOD are loaded and expired by the DatabasePager so use its bound rather than traversing them
+    _apply(plod, [&](Entry& entry) {
+        entry.bounds = {};
+        if (plod.bound.valid())
+        {
+            const auto& bs = plod.bound;
+            entry.bounds.add(bs.center.x - bs.radius, bs.center.y - bs.radius, bs.center.z - bs.radius);
+            entry.bounds.add(bs.center.x + bs.radius, bs.center.y + bs.radius, bs.center.z + bs.radius);
+        }
+    });
+}
+
+void UpdateBounds::apply(InstanceNode& instanceNode)
+{
+    _apply(instanceNode, [&](Entry& entry) {
+        // the InstanceDraw/InstanceDrawIndexed leaves below use the instanceNode's arrays and instance range
+        auto& arrayStateStack = _computeBounds->arrayStateStack;
+        auto arrayState = arrayStateStack.back()->cloneArrayState();
+        arrayState->apply(instanceNode);
+
+        arrayStateStack.emplace_back(arrayState);
+        auto previousInstanceNode = _instanceNode;
+        _instanceNode = &instanceNode;
+
+        entry.bounds = _traverse(instanceNode, entry);
+
+        _instanceNode = previousInstanceNode;
+        arrayStateStack.pop_back();
+    });
+}
+
+dbox UpdateBounds::_traverse(Node& node, Entry& entry)
+{
+    auto previousChildren = std::move(entry.children);
+    entry.children.clear();
+
+    _parentStack.push_back(&entry);
+    _boundsStack.emplace_back();
+    _bindingsStack.push_back(ArrayBindings{_computeBounds->arrayStateStack.back(), {}, {}});
+
+    node.traverse(*this);
+
+    dbox bb = _boundsStack.back();
+    _bindingsStack.pop_back();
+    _boundsStack.pop_back();
+    _parentStack.pop_back();
+
+    // release the entries of children that have been removed since the last traversal
+    if (!previousChildren.empty())
+    {
+        std::vector<const Node*> currentChildren(entry.children);
+        std::sort(currentChildren.begin(), currentChildren.end());
+        for (auto child : previousChildren)
+        {
+            if (!std::binary_search(currentChildren.begin(), currentChildren.end(), child)) _releaseChild(child, entry.node);
+        }
+    }
+
+    return bb;
+}
+
+void UpdateBounds::_computeLeafBounds(const Node& node, Entry& entry)
+{
+    _releaseData(entry);
+
+    // compute the bounds of the node with a clone of the ArrayState left by the preceding siblings, as ComputeBounds would see it,
+    // the clone records the arrays the node uses and is passed on to the following siblings
+    auto& bindings = _bindingsStack.back();
+    auto& arrayStateStack = _computeBounds->arrayStateStack;
+    auto arrayState = bindings.arrayState->cloneArrayState();
+    arrayStateStack.emplace_back(arrayState);
+
+    _computeBounds->bounds = {};
+    _computeBounds->matrixStack.clear();
+    _computeBounds->instanceNode = _instanceNode;
+    _computeBounds->ushort_indices = bindings.ushort_indices;
+    _computeBounds->uint_indices = bindings.uint_indices;
+
+    node.accept(*_computeBounds);
+
+    entry.bounds = _computeBounds->bounds;
+
+    arrayStateStack.pop_back();
+
+    entry.inputBindings = bindings;
+    bindings = ArrayBindings{arrayState, _computeBounds->ushort_indices, _computeBounds->uint_indices};
+    entry.outputBindings = bindings;
+
+    // track the arrays used so that the bounds can be recomputed when they are modified
+    auto addData = [&](const Data* data) {
+        if (!data) return;
+
+        auto& dataEntry = _dataEntries[data];
+        if (!dataEntry.data)
+        {
+            dataEntry.data = data;
+            data->getModifiedCount(dataEntry.modifiedCount);
+        }
+        dataEntry.nodes.push_back(&node);
+        entry.data.push_back(data);
+    };
+
+    for (auto& array : arrayState->arrays) addData(array);
+    addData(_computeBounds->ushort_indices);
+    addData(_computeBounds->uint_indices);
+}
+
+void UpdateBounds::_updateBound(dsphere& bound, const dbox& bb) const
+{
+    if (!updateNodeBounds || !bb.valid()) return;
+
+    bound.center = (bb.min + bb.max) * 0.5;
+    bound.radius = length(bb.max - bb.min) * 0.5;
+}
+
+bool UpdateBounds::_sameBindings(const ArrayBindings& lhs, const ArrayBindings& rhs) const
+{
+    if (lhs.ushort_indices != rhs.ushort_indices || lhs.uint_indices != rhs.uint_indices) return false;
+    if (lhs.arrayState == rhs.arrayState) return true;
+    if (!lhs.arrayState || !rhs.arrayState) return false;
+
+    // ArrayState are cloned each time their StateGroup is recomputed so compare the arrays they hold rather than the ArrayState objects
+    const auto& l = *lhs.arrayState;
+    const auto& r = *rhs.arrayState;
+    return typeid(l) == typeid(r) && l.arrays == r.arrays && l.vertices == r.vertices && l.topology == r.topology;
+}
+
+void UpdateBounds::_checkForModifications()
+{
+    for (auto& [data, dataEntry] : _dataEntries)
+    {
+        if (dataEntry.data->getModifiedCount(dataEntry.modifiedCount))
+        {
+            for (auto node : dataEntry.nodes) _markDirty(node);
+        }
+    }
+
+    for (auto transform : _transforms)
+    {
+        auto itr = _entries.find(transform);
+        if (itr != _entries.end() && !itr->second.dirty && transform->transform(dmat4{}) != itr->second.matrix) _markDirty(transform);
+    }
+}
+
+void UpdateBounds::_markDirty(const Node* node)
+{
+    auto itr = _entries.find(node);
+    if (itr == _entries.end()) return;
+
+    auto& entry = itr->second;
+    entry.dirty = true;
+
+    // the parents of a dirty node are always dirty, so stop once an already dirty parent is reached
+    for (auto parent : entry.parents)
+    {
+        auto parent_itr = _entries.find(parent);
+        if (parent_itr != _entries.end() && !parent_itr->second.dirty) _markDirty(parent);
+    }
+}
+
+void UpdateBounds::_markSubgraphDirty(const Node* node)
+{
+    auto itr = _entries.find(node);
+    if (itr == _entries.end()) return;
+
+    itr->second.dirty = true;
+    for (auto child : itr->second.children)
+    {
+        _markSubgraphDirty(child);
+    }
+}
+
+void UpdateBounds::_releaseData(Entry& entry)
+{
+    for (auto data : entry.data)
+    {
+        auto itr = _dataEntries.find(data);
+        if (itr == _dataEntries.end()) continue;
+
+        auto& nodes = itr->second.nodes;
+        auto node_itr = std::find(nodes.begin(), nodes.end(), entry.node.get());
+        if (node_itr != nodes.end()) nodes.erase(node_itr);
+        if (nodes.empty()) _dataEntries.erase(itr);
+    }
+    entry.data.clear();
+}
+
+void UpdateBounds::_releaseChild(const Node* child, const Node* parent)
+{
+    auto itr = _entries.find(child);
+    if (itr == _entries.end()) return;
+
+    auto& entry = itr->second;
+    entry.parents.erase(std::remove(entry.parents.begin(), entry.parents.end(), parent), entry.parents.end());
+    if (!entry.parents.empty()) return;
+
+    // child is no longer in the scene graph so release it and its subgraph
+    auto children = std::move(entry.children);
+    _releaseData(entry);
+    if (auto transform = entry.node->cast<Transform>()) _transforms.erase(transform);
+    _entries.erase(itr);
+
+    for (auto grandchild : children)
+    {
+        _releaseChild(grandchild, child);
+    }
+}
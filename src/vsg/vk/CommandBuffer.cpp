@@ -34,6 +34,17 @@ CommandBuffer::CommandBuffer(CommandPool* commandPool, VkCommandBuffer commandBu
 {
 }
 
+CommandBuffer::CommandBuffer(ref_ptr<CommandStream> in_commandStream, VkCommandBufferLevel level) :
+    deviceID(0),
+    commandStream(in_commandStream),
+    scratchMemory(ScratchMemory::create(4096)),
+    _commandBuffer(VK_NULL_HANDLE),
+    _level(level),
+    _currentPipelineLayout(VK_NULL_HANDLE),
+    _currentPushConstantStageFlags(0)
+{
+}
+
 CommandBuffer::~CommandBuffer()
 {
     if (_commandBuffer)
@@ -47,7 +58,8 @@ void CommandBuffer::reset()
     _currentPipelineLayout = VK_NULL_HANDLE;
     _currentPushConstantStageFlags = 0;
 
-    _commandPool->reset();
+    if (commandStream) commandStream->clear();
+    if (_commandPool) _commandPool->reset();
 }
 
 void CommandBuffer::setCurrentPipelineLayout(const PipelineLayout* pipelineLayout)
@@ -56,7 +68,7 @@ void CommandBuffer::setCurrentPipelineLayout(const PipelineLayout* pipelineLayou
     if (_currentPipelineLayout != newLayout)
     {
         // have to assume that all DescriptorSets will need to be rebound.
-        state->dirtyStateStacks();
+        if (state) state->dirtyStateStacks();
 
         _currentPipelineLayout = newLayout;
         if (pipelineLayout->pushConstantRanges.empty())
@@ -0,0 +1,199 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/DrawIndexedIndirect.h>
+#include <vsg/commands/DrawIndirect.h>
+#include <vsg/core/ConstVisitor.h>
+#include <vsg/state/ComputePipeline.h>
+#include <vsg/state/GraphicsPipeline.h>
+#include <vsg/state/PushConstants.h>
+#include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/CommandStream.h>
+#include <vsg/vk/State.h>
+
+using namespace vsg;
+
+namespace
+{
+    struct CountCommands : public ConstVisitor
+    {
+        explicit CountCommands(CommandStream::Statistics& in_statistics) :
+            statistics(in_statistics) {}
+
+        CommandStream::Statistics& statistics;
+
+        void apply(const Command& command) override
+        {
+            if (command.cast<DrawIndirect>() || command.cast<DrawIndexedIndirect>()) ++statistics.numDraws;
+        }
+
+        void apply(const StateCommand& stateCommand) override
+        {
+            if (stateCommand.cast<PushConstants>()) ++statistics.numPushConstants;
+        }
+
+        void apply(const Draw&) override { ++statistics.numDraws; }
+        void apply(const DrawIndexed&) override { ++statistics.numDraws; }
+        void apply(const VertexDraw&) override { ++statistics.numDraws; }
+        void apply(const VertexIndexDraw&) override { ++statistics.numDraws; }
+        void apply(const Geometry&) override { ++statistics.numDraws; }
+        void apply(const InstanceDraw&) override { ++statistics.numDraws; }
+        void apply(const InstanceDrawIndexed&) override { ++statistics.numDraws; }
+        void apply(const DrawMeshTasks&) override { ++statistics.numDraws; }
+        void apply(const DrawMeshTasksIndirect&) override { ++statistics.numDraws; }
+        void apply(const DrawMeshTasksIndirectCount&) override { ++statistics.numDraws; }
+
+        void apply(const BindGraphicsPipeline&) override { ++statistics.numPipelineBinds; }
+        void apply(const BindComputePipeline&) override { ++statistics.numPipelineBinds; }
+        void apply(const BindRayTracingPipeline&) override { ++statistics.numPipelineBinds; }
+
+        void apply(const BindDescriptorSet&) override { ++statistics.numDescriptorSetBinds; }
+        void apply(const BindDescriptorSets&) override { ++statistics.numDescriptorSetBinds; }
+        void apply(const BindViewDescriptorSets&) override { ++statistics.numDescriptorSetBinds; }
+
+        void apply(const BindVertexBuffers&) override { ++statistics.numVertexBufferBinds; }
+        void apply(const BindIndexBuffer&) override { ++statistics.numIndexBufferBinds; }
+    };
+} // namespace
+
+CommandStream::CommandStream()
+{
+}
+
+CommandStream::~CommandStream()
+{
+}
+
+void CommandStream::clear()
+{
+    _entries.clear();
+    _matrices.clear();
+    _contexts.clear();
+    _currentPipelineLayout = nullptr;
+}
+
+void CommandStream::_updateContext(const CommandBuffer& commandBuffer)
+{
+    if (!_contexts.empty())
+    {
+        const auto& context = _contexts.back();
+        if (context.viewID == commandBuffer.viewID && context.viewDependentState == commandBuffer.viewDependentState && context.instanceNode == commandBuffer.instanceNode) return;
+    }
+
+    _entries.push_back(Entry{SET_CONTEXT, static_cast<uint32_t>(_contexts.size()), nullptr});
+    _contexts.push_back(Context{commandBuffer.viewID, commandBuffer.viewDependentState, commandBuffer.instanceNode});
+}
+
+void CommandStream::add(CommandBuffer& commandBuffer, const Command& command)
+{
+    _updateContext(commandBuffer);
+    _entries.push_back(Entry{COMMAND, 0, &command});
+}
+
+void CommandStream::add(CommandBuffer& commandBuffer, const StateCommand& stateCommand)
+{
+    _updateContext(commandBuffer);
+    _entries.push_back(Entry{STATE_COMMAND, 0, &stateCommand});
+
+    // binding a pipeline with a different layout requires all the descriptor sets to be rebound, see CommandBuffer::setCurrentPipelineLayout(..)
+    const PipelineLayout* pipelineLayout = nullptr;
+    if (auto bindGraphicsPipeline = stateCommand.cast<BindGraphicsPipeline>())
+    {
+        if (bindGraphicsPipeline->pipeline) pipelineLayout = bindGraphicsPipeline->pipeline->layout.get();
+    }
+    else if (auto bindComputePipeline = stateCommand.cast<BindComputePipeline>())
+    {
+        if (bindComputePipeline->pipeline) pipelineLayout = bindComputePipeline->pipeline->layout.get();
+    }
+
+    if (pipelineLayout && pipelineLayout != _currentPipelineLayout)
+    {
+        if (commandBuffer.state) commandBuffer.state->dirtyStateStacks();
+        _currentPipelineLayout = pipelineLayout;
+    }
+}
+
+bool CommandStream::pushMatrix(CommandBuffer& commandBuffer, uint32_t offset, const mat4& matrix)
+{
+    if (!_currentPipelineLayout || _currentPipelineLayout->pushConstantRanges.empty()) return false;
+
+    _updateContext(commandBuffer);
+    _entries.push_back(Entry{PUSH_MATRIX, static_cast<uint32_t>(_matrices.size()), nullptr});
+    _matrices.push_back(PushMatrix{offset, matrix});
+    return true;
+}
+
+void CommandStream::replay(CommandBuffer& commandBuffer) const
+{
+    Context cached_context{commandBuffer.viewID, commandBuffer.viewDependentState, commandBuffer.instanceNode};
+
+    for (const auto& entry : _entries)
+    {
+        switch (entry.type)
+        {
+        case (COMMAND):
+        case (STATE_COMMAND):
+            entry.command->record(commandBuffer);
+            break;
+        case (PUSH_MATRIX): {
+            auto pipeline = commandBuffer.getCurrentPipelineLayout();
+            auto stageFlags = commandBuffer.getCurrentPushConstantStageFlags();
+            if (pipeline != VK_NULL_HANDLE && stageFlags != 0)
+            {
+                const auto& pushMatrix = _matrices[entry.index];
+                vkCmdPushConstants(commandBuffer, pipeline, stageFlags, pushMatrix.offset, sizeof(pushMatrix.matrix), pushMatrix.matrix.data());
+            }
+            break;
+        }
+        case (SET_CONTEXT): {
+            const auto& context = _contexts[entry.index];
+            commandBuffer.viewID = context.viewID;
+            commandBuffer.viewDependentState = context.viewDependentState;
+            commandBuffer.instanceNode = context.instanceNode;
+            break;
+        }
+        }
+    }
+
+    commandBuffer.viewID = cached_context.viewID;
+    commandBuffer.viewDependentState = cached_context.viewDependentState;
+    commandBuffer.instanceNode = cached_context.instanceNode;
+}
+
+CommandStream::Statistics CommandStream::computeStatistics() const
+{
+    Statistics statistics;
+    CountCommands countCommands(statistics);
+
+    for (const auto& entry : _entries)
+    {
+        switch (entry.type)
+        {
+        case (COMMAND):
+            ++statistics.numCommands;
+            entry.command->accept(countCommands);
+            break;
+        case (STATE_COMMAND):
+            ++statistics.numStateCommands;
+            entry.command->accept(countCommands);
+            break;
+        case (PUSH_MATRIX):
+            ++statistics.numPushConstants;
+            break;
+        case (SET_CONTEXT):
+            break;
+        }
+    }
+
+    return statistics;
+}
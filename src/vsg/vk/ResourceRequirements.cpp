@@ -17,6 +17,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/DepthSorted.h>
 #include <vsg/nodes/Geometry.h>
 #include <vsg/nodes/Group.h>
+#include <vsg/nodes/InstanceNode.h>
 #include <vsg/nodes/Layer.h>
 #include <vsg/nodes/PagedLOD.h>
 #include <vsg/nodes/StateGroup.h>
@@ -291,6 +292,14 @@ void CollectResourceRequirements::apply(const VertexIndexDraw& vid)
     apply(vid.indices);
 }
 
+void CollectResourceRequirements::apply(const InstanceNode& instanceNode)
+{
+    if (instanceNode.culling) instanceNode.culling->init(instanceNode, requirements);
+
+    // continue with the Node handling of resource hints and traversal
+    ConstVisitor::apply(instanceNode);
+}
+
 void CollectResourceRequirements::apply(const BindVertexBuffers& bvb)
 {
     for (const auto& bufferInfo : bvb.arrays) apply(bufferInfo);
@@ -51,6 +51,39 @@ void State::connect(ref_ptr<CommandBuffer> commandBuffer)
     reset();
 }
 
+void State::inherit(const State& rhs)
+{
+    reserve(rhs.maxSlots);
+
+    // copy the state stacks and then dirty them so that all state is applied to the new command buffer
+    stateStacks = rhs.stateStacks;
+    dirtyStateStacks();
+    activeMaxStateSlot = maxSlots.max();
+
+    projectionMatrixStack = rhs.projectionMatrixStack;
+    projectionMatrixStack.dirty = true;
+
+    modelviewMatrixStack = rhs.modelviewMatrixStack;
+    modelviewMatrixStack.dirty = true;
+
+    _frustumUnit = rhs._frustumUnit;
+    _frustumProjected = rhs._frustumProjected;
+    _frustumStack = rhs._frustumStack;
+
+    inheritViewForLODScaling = rhs.inheritViewForLODScaling;
+    inheritedProjectionMatrix = rhs.inheritedProjectionMatrix;
+    inheritedViewMatrix = rhs.inheritedViewMatrix;
+    inheritedViewTransform = rhs.inheritedViewTransform;
+
+    viewportStateHint = rhs.viewportStateHint;
+    renderPass = rhs.renderPass;
+    framebuffer = rhs.framebuffer;
+    subpass = rhs.subpass;
+    subpassContents = rhs.subpassContents;
+
+    dirty = true;
+}
+
 void State::pushView(ref_ptr<StateCommand> command)
 {
     stateStacks[command->slot].push(command);